@@ -1,9 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
-// STD
-#include <vector>
-
 // SEALNet
 #include "sealnet/stdafx.h"
 #include "sealnet/batchencoder_wrapper.h"
@@ -47,19 +44,19 @@ SEALNETNATIVE HRESULT SEALCALL BatchEncoder_Encode1(void *thisptr, uint64_t coun
 {
     BatchEncoder *encoder = FromVoid<BatchEncoder>(thisptr);
     IfNullRet(encoder, E_POINTER);
-    IfNullRet(values, E_POINTER);
     Plaintext *plain = FromVoid<Plaintext>(destination);
     IfNullRet(plain, E_POINTER);
 
-    vector<uint64_t> valvec(count);
-    for (uint64_t i = 0; i < count; i++)
-    {
-        valvec[i] = values[i];
-    }
+    // An empty buffer may be passed as a null pointer
+    if (nullptr == values && count > 0)
+        return E_POINTER;
+    if (count > encoder->slot_count())
+        return E_INVALIDARG;
 
     try
     {
-        encoder->encode(valvec, *plain);
+        // Read the caller's buffer in place
+        encoder->encode(values, static_cast<size_t>(count), *plain);
         return S_OK;
     }
     catch (const invalid_argument&)
@@ -72,19 +69,19 @@ SEALNETNATIVE HRESULT SEALCALL BatchEncoder_Encode2(void *thisptr, uint64_t coun
 {
     BatchEncoder *encoder = FromVoid<BatchEncoder>(thisptr);
     IfNullRet(encoder, E_POINTER);
-    IfNullRet(values, E_POINTER);
     Plaintext *plain = FromVoid<Plaintext>(destination);
     IfNullRet(plain, E_POINTER);
 
-    vector<int64_t> valvec(count);
-    for (uint64_t i = 0; i < count; i++)
-    {
-        valvec[i] = values[i];
-    }
+    // An empty buffer may be passed as a null pointer
+    if (nullptr == values && count > 0)
+        return E_POINTER;
+    if (count > encoder->slot_count())
+        return E_INVALIDARG;
 
     try
     {
-        encoder->encode(valvec, *plain);
+        // Read the caller's buffer in place
+        encoder->encode(values, static_cast<size_t>(count), *plain);
         return S_OK;
     }
     catch (const invalid_argument&)
@@ -121,24 +118,26 @@ SEALNETNATIVE HRESULT SEALCALL BatchEncoder_Decode1(void *thisptr, void *plain,
     IfNullRet(plainptr, E_POINTER);
     unique_ptr<MemoryPoolHandle> handle = MemHandleFromVoid(pool);
 
-    try
+    uint64_t slot_count = encoder->slot_count();
+    if (nullptr == destination)
     {
-        vector<uint64_t> result;
-        encoder->decode(*plainptr, result, *handle);
-
-        *count = result.size();
-
-        if (nullptr == destination)
-        {
-            // We only wanted the count.
-            return S_OK;
-        }
+        // We only wanted the count.
+        *count = slot_count;
+        return S_OK;
+    }
 
-        for (uint64_t i = 0; i < *count; i++)
-        {
-            destination[i] = result[i];
-        }
+    // The count holds the capacity of destination
+    if (*count < slot_count)
+    {
+        *count = slot_count;
+        return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
+    }
 
+    try
+    {
+        // Write straight into the caller's buffer
+        encoder->decode(*plainptr, destination, *handle);
+        *count = slot_count;
         return S_OK;
     }
     catch (const invalid_argument&)
@@ -156,24 +155,26 @@ SEALNETNATIVE HRESULT SEALCALL BatchEncoder_Decode2(void *thisptr, void *plain,
     IfNullRet(plainptr, E_POINTER);
     unique_ptr<MemoryPoolHandle> handle = MemHandleFromVoid(pool);
 
-    try
+    uint64_t slot_count = encoder->slot_count();
+    if (nullptr == destination)
     {
-        vector<int64_t> result;
-        encoder->decode(*plainptr, result, *handle);
-
-        *count = result.size();
-
-        if (nullptr == destination)
-        {
-            // We only wanted the count.
-            return S_OK;
-        }
+        // We only wanted the count.
+        *count = slot_count;
+        return S_OK;
+    }
 
-        for (uint64_t i = 0; i < *count; i++)
-        {
-            destination[i] = result[i];
-        }
+    // The count holds the capacity of destination
+    if (*count < slot_count)
+    {
+        *count = slot_count;
+        return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
+    }
 
+    try
+    {
+        // Write straight into the caller's buffer
+        encoder->decode(*plainptr, destination, *handle);
+        *count = slot_count;
         return S_OK;
     }
     catch (const invalid_argument&)
@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT license.
 
+// STD
+#include <algorithm>
+#include <cstring>
+
 // SEALNet
 #include "sealnet/stdafx.h"
 #include "sealnet/ciphertext_wrapper.h"
@@ -413,6 +417,42 @@ SEALNETNATIVE HRESULT SEALCALL Ciphertext_SetDataAt(void *thisptr, uint64_t inde
     }
 }
 
+SEALNETNATIVE HRESULT SEALCALL Ciphertext_GetData(void *thisptr, uint64_t byte_offset, uint64_t byte_count, void *data)
+{
+    Ciphertext *cipher = FromVoid<Ciphertext>(thisptr);
+    IfNullRet(cipher, E_POINTER);
+
+    // The requested byte range must lie within the ciphertext data; the caller's
+    // buffer need not be aligned for uint64_t, so the data is copied byte by byte
+    uint64_t total_byte_count = util::mul_safe(cipher->uint64_count(), sizeof(uint64_t));
+    if (byte_offset > total_byte_count || byte_count > total_byte_count - byte_offset)
+        return E_INVALIDARG;
+    if (byte_count > 0)
+    {
+        IfNullRet(data, E_POINTER);
+        memcpy(reinterpret_cast<uint8_t*>(data), reinterpret_cast<const uint8_t*>(cipher->data()) + byte_offset, byte_count);
+    }
+    return S_OK;
+}
+
+SEALNETNATIVE HRESULT SEALCALL Ciphertext_SetData(void *thisptr, uint64_t byte_offset, uint64_t byte_count, void *data)
+{
+    Ciphertext *cipher = FromVoid<Ciphertext>(thisptr);
+    IfNullRet(cipher, E_POINTER);
+
+    // The requested byte range must lie within the ciphertext data; the caller's
+    // buffer need not be aligned for uint64_t, so the data is copied byte by byte
+    uint64_t total_byte_count = util::mul_safe(cipher->uint64_count(), sizeof(uint64_t));
+    if (byte_offset > total_byte_count || byte_count > total_byte_count - byte_offset)
+        return E_INVALIDARG;
+    if (byte_count > 0)
+    {
+        IfNullRet(data, E_POINTER);
+        memcpy(reinterpret_cast<uint8_t*>(cipher->data()) + byte_offset, data, byte_count);
+    }
+    return S_OK;
+}
+
 SEALNETNATIVE HRESULT SEALCALL Ciphertext_IsNTTForm(void *thisptr, bool *is_ntt_form)
 {
     Ciphertext *cipher = FromVoid<Ciphertext>(thisptr);
@@ -63,6 +63,10 @@ SEALNETNATIVE HRESULT SEALCALL Ciphertext_GetDataAt2(void *thisptr, uint64_t pol
 
 SEALNETNATIVE HRESULT SEALCALL Ciphertext_SetDataAt(void *thisptr, uint64_t index, uint64_t value);
 
+SEALNETNATIVE HRESULT SEALCALL Ciphertext_GetData(void *thisptr, uint64_t byte_offset, uint64_t byte_count, void *data);
+
+SEALNETNATIVE HRESULT SEALCALL Ciphertext_SetData(void *thisptr, uint64_t byte_offset, uint64_t byte_count, void *data);
+
 SEALNETNATIVE HRESULT SEALCALL Ciphertext_IsNTTForm(void *thisptr, bool *is_ntt_form);
 
 SEALNETNATIVE HRESULT SEALCALL Ciphertext_SetIsNTTForm(void *thisptr, bool is_ntt_form);
@@ -5,6 +5,7 @@ using Microsoft.Research.SEAL.Tools;
 using System;
 using System.Collections.Generic;
 using System.Linq;
+using System.Runtime.InteropServices;
 
 namespace Microsoft.Research.SEAL
 {
@@ -90,8 +91,43 @@ namespace Microsoft.Research.SEAL
             if (null == destination)
                 throw new ArgumentNullException(nameof(destination));
 
-            ulong[] valarray = values.ToArray();
-            NativeMethods.BatchEncoder_Encode(NativePtr, (ulong)valarray.LongLength, valarray, destination.NativePtr);
+            ulong[] valarray = values as ulong[] ?? values.ToArray();
+            Encode(new ReadOnlySpan<ulong>(valarray), destination);
+        }
+
+        /// <summary>
+        /// Creates a plaintext from a given matrix, as the overload taking an IEnumerable
+        /// does, but without copying the array first.
+        /// </summary>
+        /// <param name="values">The matrix of integers modulo plaintext modulus to batch</param>
+        /// <param name="destination">The plaintext polynomial to overwrite with the result</param>
+        /// <exception cref="ArgumentNullException">if either values or destination are null</exception>
+        /// <exception cref="ArgumentException">if values is too large</exception>
+        public void Encode(ulong[] values, Plaintext destination)
+        {
+            if (null == values)
+                throw new ArgumentNullException(nameof(values));
+
+            Encode(new ReadOnlySpan<ulong>(values), destination);
+        }
+
+        /// <summary>
+        /// Creates a plaintext from a given matrix, as the overload taking an IEnumerable
+        /// does. The values are read in place by the native library, so they can come
+        /// from any contiguous memory, such as a slice of a larger buffer, stack memory,
+        /// or a Memory&lt;ulong&gt; through its Span property, without being copied.
+        /// </summary>
+        /// <param name="values">The matrix of integers modulo plaintext modulus to batch</param>
+        /// <param name="destination">The plaintext polynomial to overwrite with the result</param>
+        /// <exception cref="ArgumentNullException">if destination is null</exception>
+        /// <exception cref="ArgumentException">if values is too large</exception>
+        public void Encode(ReadOnlySpan<ulong> values, Plaintext destination)
+        {
+            if (null == destination)
+                throw new ArgumentNullException(nameof(destination));
+
+            NativeMethods.BatchEncoder_Encode(NativePtr, (ulong)values.Length,
+                ref MemoryMarshal.GetReference(values), destination.NativePtr);
         }
 
         /// <summary>
@@ -117,8 +153,43 @@ namespace Microsoft.Research.SEAL
             if (null == destination)
                 throw new ArgumentNullException(nameof(destination));
 
-            long[] valarray = values.ToArray();
-            NativeMethods.BatchEncoder_Encode(NativePtr, (ulong)valarray.LongLength, valarray, destination.NativePtr);
+            long[] valarray = values as long[] ?? values.ToArray();
+            Encode(new ReadOnlySpan<long>(valarray), destination);
+        }
+
+        /// <summary>
+        /// Creates a plaintext from a given matrix, as the overload taking an IEnumerable
+        /// does, but without copying the array first.
+        /// </summary>
+        /// <param name="values">The matrix of integers modulo plaintext modulus to batch</param>
+        /// <param name="destination">The plaintext polynomial to overwrite with the result</param>
+        /// <exception cref="ArgumentNullException">if either values or destination are null</exception>
+        /// <exception cref="ArgumentException">if values is too large</exception>
+        public void Encode(long[] values, Plaintext destination)
+        {
+            if (null == values)
+                throw new ArgumentNullException(nameof(values));
+
+            Encode(new ReadOnlySpan<long>(values), destination);
+        }
+
+        /// <summary>
+        /// Creates a plaintext from a given matrix, as the overload taking an IEnumerable
+        /// does. The values are read in place by the native library, so they can come
+        /// from any contiguous memory, such as a slice of a larger buffer, stack memory,
+        /// or a Memory&lt;long&gt; through its Span property, without being copied.
+        /// </summary>
+        /// <param name="values">The matrix of integers modulo plaintext modulus to batch</param>
+        /// <param name="destination">The plaintext polynomial to overwrite with the result</param>
+        /// <exception cref="ArgumentNullException">if destination is null</exception>
+        /// <exception cref="ArgumentException">if values is too large</exception>
+        public void Encode(ReadOnlySpan<long> values, Plaintext destination)
+        {
+            if (null == destination)
+                throw new ArgumentNullException(nameof(destination));
+
+            NativeMethods.BatchEncoder_Encode(NativePtr, (ulong)values.Length,
+                ref MemoryMarshal.GetReference(values), destination.NativePtr);
         }
 
         /// <summary>
@@ -169,21 +240,68 @@ namespace Microsoft.Research.SEAL
             if (null == destination)
                 throw new ArgumentNullException(nameof(destination));
 
-            IntPtr poolPtr = pool?.NativePtr ?? IntPtr.Zero;
-
-            ulong count = 0;
-            NativeMethods.BatchEncoder_Decode(NativePtr, plain.NativePtr, ref count, (ulong[])null, poolPtr);
-
-            ulong[] dest = new ulong[count];
-            NativeMethods.BatchEncoder_Decode(NativePtr, plain.NativePtr, ref count, dest, poolPtr);
+            ulong[] dest = new ulong[SlotCount];
+            Decode(plain, new Span<ulong>(dest), pool);
 
             destination.Clear();
-            for (ulong i = 0; i < count; i++)
+            foreach (ulong value in dest)
             {
-                destination.Add(dest[i]);
+                destination.Add(value);
             }
         }
 
+        /// <summary>
+        /// Inverse of encode. This function "unbatches" a given plaintext into a matrix
+        /// of integers modulo the plaintext modulus, as the overload taking an ICollection
+        /// does, but writes the result into the given array, which must hold at least
+        /// SlotCount elements.
+        /// </summary>
+        /// <param name="plain">The plaintext polynomial to unbatch</param>
+        /// <param name="destination">The matrix to be overwritten with the values in the slots</param>
+        /// <param name="pool">The MemoryPoolHandle pointing to a valid memory pool</param>
+        /// <exception cref="ArgumentNullException">if either plain or destination are null</exception>
+        /// <exception cref="ArgumentException">if plain is not valid for the encryption parameters</exception>
+        /// <exception cref="ArgumentException">if plain is in NTT form</exception>
+        /// <exception cref="ArgumentException">if destination is smaller than SlotCount</exception>
+        /// <exception cref="ArgumentException">if pool is uninitialized</exception>
+        public void Decode(Plaintext plain, ulong[] destination, MemoryPoolHandle pool = null)
+        {
+            if (null == destination)
+                throw new ArgumentNullException(nameof(destination));
+
+            Decode(plain, new Span<ulong>(destination), pool);
+        }
+
+        /// <summary>
+        /// Inverse of encode. This function "unbatches" a given plaintext into a matrix
+        /// of integers modulo the plaintext modulus, as the overload taking an ICollection
+        /// does, but the native library writes the result straight into the given memory,
+        /// which must hold at least SlotCount elements. Only the first SlotCount elements
+        /// are overwritten.
+        /// </summary>
+        /// <param name="plain">The plaintext polynomial to unbatch</param>
+        /// <param name="destination">The matrix to be overwritten with the values in the slots</param>
+        /// <param name="pool">The MemoryPoolHandle pointing to a valid memory pool</param>
+        /// <exception cref="ArgumentNullException">if plain is null</exception>
+        /// <exception cref="ArgumentException">if plain is not valid for the encryption parameters</exception>
+        /// <exception cref="ArgumentException">if plain is in NTT form</exception>
+        /// <exception cref="ArgumentException">if destination is smaller than SlotCount</exception>
+        /// <exception cref="ArgumentException">if pool is uninitialized</exception>
+        public void Decode(Plaintext plain, Span<ulong> destination, MemoryPoolHandle pool = null)
+        {
+            if (null == plain)
+                throw new ArgumentNullException(nameof(plain));
+
+            // An empty span has no address, so check its length here
+            ulong count = (ulong)destination.Length;
+            if (count < SlotCount)
+                throw new ArgumentException("destination is too small", nameof(destination));
+
+            IntPtr poolPtr = pool?.NativePtr ?? IntPtr.Zero;
+            NativeMethods.BatchEncoder_Decode(NativePtr, plain.NativePtr, ref count,
+                ref MemoryMarshal.GetReference(destination), poolPtr);
+        }
+
         /// <summary>
         /// Inverse of encode. This function "unbatches" a given plaintext into a matrix
         /// of integers modulo the plaintext modulus, and stores the result in the destination
@@ -206,21 +324,68 @@ namespace Microsoft.Research.SEAL
             if (null == destination)
                 throw new ArgumentNullException(nameof(destination));
 
-            IntPtr poolPtr = pool?.NativePtr ?? IntPtr.Zero;
-
-            ulong count = 0;
-            NativeMethods.BatchEncoder_Decode(NativePtr, plain.NativePtr, ref count, (long[])null, poolPtr);
-
-            long[] dest = new long[count];
-            NativeMethods.BatchEncoder_Decode(NativePtr, plain.NativePtr, ref count, dest, poolPtr);
+            long[] dest = new long[SlotCount];
+            Decode(plain, new Span<long>(dest), pool);
 
             destination.Clear();
-            for (ulong i = 0; i < count; i++)
+            foreach (long value in dest)
             {
-                destination.Add(dest[i]);
+                destination.Add(value);
             }
         }
 
+        /// <summary>
+        /// Inverse of encode. This function "unbatches" a given plaintext into a matrix
+        /// of integers modulo the plaintext modulus, as the overload taking an ICollection
+        /// does, but writes the result into the given array, which must hold at least
+        /// SlotCount elements.
+        /// </summary>
+        /// <param name="plain">The plaintext polynomial to unbatch</param>
+        /// <param name="destination">The matrix to be overwritten with the values in the slots</param>
+        /// <param name="pool">The MemoryPoolHandle pointing to a valid memory pool</param>
+        /// <exception cref="ArgumentNullException">if either plain or destination are null</exception>
+        /// <exception cref="ArgumentException">if plain is not valid for the encryption parameters</exception>
+        /// <exception cref="ArgumentException">if plain is in NTT form</exception>
+        /// <exception cref="ArgumentException">if destination is smaller than SlotCount</exception>
+        /// <exception cref="ArgumentException">if pool is uninitialized</exception>
+        public void Decode(Plaintext plain, long[] destination, MemoryPoolHandle pool = null)
+        {
+            if (null == destination)
+                throw new ArgumentNullException(nameof(destination));
+
+            Decode(plain, new Span<long>(destination), pool);
+        }
+
+        /// <summary>
+        /// Inverse of encode. This function "unbatches" a given plaintext into a matrix
+        /// of integers modulo the plaintext modulus, as the overload taking an ICollection
+        /// does, but the native library writes the result straight into the given memory,
+        /// which must hold at least SlotCount elements. Only the first SlotCount elements
+        /// are overwritten.
+        /// </summary>
+        /// <param name="plain">The plaintext polynomial to unbatch</param>
+        /// <param name="destination">The matrix to be overwritten with the values in the slots</param>
+        /// <param name="pool">The MemoryPoolHandle pointing to a valid memory pool</param>
+        /// <exception cref="ArgumentNullException">if plain is null</exception>
+        /// <exception cref="ArgumentException">if plain is not valid for the encryption parameters</exception>
+        /// <exception cref="ArgumentException">if plain is in NTT form</exception>
+        /// <exception cref="ArgumentException">if destination is smaller than SlotCount</exception>
+        /// <exception cref="ArgumentException">if pool is uninitialized</exception>
+        public void Decode(Plaintext plain, Span<long> destination, MemoryPoolHandle pool = null)
+        {
+            if (null == plain)
+                throw new ArgumentNullException(nameof(plain));
+
+            // An empty span has no address, so check its length here
+            ulong count = (ulong)destination.Length;
+            if (count < SlotCount)
+                throw new ArgumentException("destination is too small", nameof(destination));
+
+            IntPtr poolPtr = pool?.NativePtr ?? IntPtr.Zero;
+            NativeMethods.BatchEncoder_Decode(NativePtr, plain.NativePtr, ref count,
+                ref MemoryMarshal.GetReference(destination), poolPtr);
+        }
+
         /// <summary>
         /// Inverse of encode. This function "unbatches" a given plaintext in-place into 
         /// a matrix of integers modulo the plaintext modulus. The input plaintext must have 
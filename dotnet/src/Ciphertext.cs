@@ -3,6 +3,8 @@
 
 using Microsoft.Research.SEAL.Tools;
 using System;
+using System.Buffers;
+using System.Buffers.Binary;
 using System.IO;
 using System.Runtime.InteropServices;
 using System.Text;
@@ -543,21 +545,63 @@ namespace Microsoft.Research.SEAL
             if (null == stream)
                 throw new ArgumentNullException(nameof(stream));
 
-            using (BinaryWriter writer = new BinaryWriter(stream, Encoding.UTF8, leaveOpen: true))
-            {
-                ParmsId.Save(writer.BaseStream);
-
-                writer.Write(IsNTTForm);
-                writer.Write(Size);
-                writer.Write(PolyModulusDegree);
-                writer.Write(CoeffModCount);
+            byte[] header = new byte[SaveHeaderSize];
+            SaveHeader(header);
+            stream.Write(header, 0, SaveHeaderSize);
 
-                ulong ulongCount = Size * PolyModulusDegree * CoeffModCount;
-                for (ulong i = 0; i < ulongCount; i++)
+            // Copy the polynomial data through a pooled buffer in fixed-size chunks
+            long dataSize = SaveSize - SaveHeaderSize;
+            byte[] buffer = ArrayPool<byte>.Shared.Rent((int)Math.Min(dataSize, StreamChunkSize));
+            try
+            {
+                for (long offset = 0; offset < dataSize; offset += StreamChunkSize)
                 {
-                    writer.Write(this[i]);
+                    int count = (int)Math.Min(dataSize - offset, StreamChunkSize);
+                    NativeMethods.Ciphertext_GetData(NativePtr, (ulong)offset, (ulong)count,
+                        ref buffer[0]);
+                    stream.Write(buffer, 0, count);
                 }
             }
+            finally
+            {
+                ArrayPool<byte>.Shared.Return(buffer);
+            }
+        }
+
+        /// <summary>
+        /// Saves the ciphertext to a buffer in the same format as Save(Stream). The
+        /// polynomial data is copied by the native library straight into the buffer,
+        /// which must hold at least SaveSize bytes.
+        /// </summary>
+        /// <param name="destination">The buffer to save the ciphertext to</param>
+        /// <returns>The number of bytes written, which is SaveSize</returns>
+        /// <exception cref="ArgumentException">if destination is smaller than SaveSize</exception>
+        /// <seealso cref="Load(SEALContext, ReadOnlySpan{byte})">See Load() to load a saved ciphertext.</seealso>
+        public int Save(Span<byte> destination)
+        {
+            long saveSize = SaveSize;
+            if (destination.Length < saveSize)
+                throw new ArgumentException("destination is too small", nameof(destination));
+
+            SaveHeader(destination);
+            Span<byte> data = destination.Slice(SaveHeaderSize, (int)saveSize - SaveHeaderSize);
+            if (!data.IsEmpty)
+            {
+                NativeMethods.Ciphertext_GetData(NativePtr, 0, (ulong)data.Length,
+                    ref MemoryMarshal.GetReference(data));
+            }
+            return (int)saveSize;
+        }
+
+        /// <summary>
+        /// Returns the number of bytes written by Save.
+        /// </summary>
+        public long SaveSize
+        {
+            get
+            {
+                return SaveHeaderSize + checked((long)UInt64Count * sizeof(ulong));
+            }
         }
 
         /// <summary>
@@ -578,22 +622,34 @@ namespace Microsoft.Research.SEAL
             {
                 using (BinaryReader reader = new BinaryReader(stream, Encoding.UTF8, leaveOpen: true))
                 {
-                    ParmsId parms = new ParmsId();
-                    parms.Load(reader.BaseStream);
-                    ParmsId = parms;
-
-                    bool isNTT = reader.ReadBoolean();
-                    ulong size = reader.ReadUInt64();
-                    ulong polyModulusDegree = reader.ReadUInt64();
-                    ulong coeffModCount = reader.ReadUInt64();
-                    ulong ulongCount = size * polyModulusDegree * coeffModCount;
-
-                    IsNTTForm = isNTT;
-                    Resize(size, polyModulusDegree, coeffModCount);
-
-                    for (ulong i = 0; i < ulongCount; i++)
+                    byte[] header = reader.ReadBytes(SaveHeaderSize);
+                    if (header.Length < SaveHeaderSize)
+                        throw new EndOfStreamException();
+                    SaveHeaderFields fields = ReadHeader(header);
+                    ApplyHeader(fields);
+
+                    // Copy the polynomial data through a pooled buffer in fixed-size chunks
+                    byte[] buffer = ArrayPool<byte>.Shared.Rent(
+                        (int)Math.Min(fields.DataSize, StreamChunkSize));
+                    try
+                    {
+                        for (long offset = 0; offset < fields.DataSize; offset += StreamChunkSize)
+                        {
+                            int count = (int)Math.Min(fields.DataSize - offset, StreamChunkSize);
+                            for (int read = 0; read < count; )
+                            {
+                                int bytesRead = stream.Read(buffer, read, count - read);
+                                if (0 == bytesRead)
+                                    throw new EndOfStreamException();
+                                read += bytesRead;
+                            }
+                            NativeMethods.Ciphertext_SetData(NativePtr, (ulong)offset,
+                                (ulong)count, ref buffer[0]);
+                        }
+                    }
+                    finally
                     {
-                        this[i] = reader.ReadUInt64();
+                        ArrayPool<byte>.Shared.Return(buffer);
                     }
                 }
             }
@@ -607,6 +663,35 @@ namespace Microsoft.Research.SEAL
             }
         }
 
+        /// <summary>
+        /// Loads a ciphertext saved by Save from a buffer overwriting the current
+        /// ciphertext. The polynomial data is copied by the native library straight
+        /// from the buffer. No checking of the validity of the ciphertext data against
+        /// encryption parameters is performed. This function should not be used unless
+        /// the ciphertext comes from a fully trusted source.
+        /// </summary>
+        /// <param name="buffer">The buffer to load the ciphertext from</param>
+        /// <returns>The number of bytes read</returns>
+        /// <exception cref="ArgumentException">if a valid ciphertext could not be read from buffer</exception>
+        public int UnsafeLoad(ReadOnlySpan<byte> buffer)
+        {
+            if (buffer.Length < SaveHeaderSize)
+                throw new ArgumentException("Buffer ended unexpectedly", nameof(buffer));
+
+            // Check the length before the ciphertext is changed
+            SaveHeaderFields fields = ReadHeader(buffer.Slice(0, SaveHeaderSize));
+            if (buffer.Length - SaveHeaderSize < fields.DataSize)
+                throw new ArgumentException("Buffer ended unexpectedly", nameof(buffer));
+
+            ApplyHeader(fields);
+            int dataSize = (int)fields.DataSize;
+            if (dataSize > 0)
+            {
+                NativeMethods.Ciphertext_SetData(NativePtr, 0, (ulong)dataSize,
+                    ref MemoryMarshal.GetReference(buffer.Slice(SaveHeaderSize, dataSize)));
+            }
+            return SaveHeaderSize + dataSize;
+        }
 
         /// <summary>
         /// Loads a ciphertext from an input stream overwriting the current ciphertext.
@@ -635,6 +720,113 @@ namespace Microsoft.Research.SEAL
             }
         }
 
+        /// <summary>
+        /// Loads a ciphertext saved by Save from a buffer overwriting the current
+        /// ciphertext. The loaded ciphertext is verified to be valid for the given
+        /// SEALContext.
+        /// </summary>
+        /// <param name="context">The SEALContext</param>
+        /// <param name="buffer">The buffer to load the ciphertext from</param>
+        /// <returns>The number of bytes read</returns>
+        /// <exception cref="ArgumentNullException">if context is null</exception>
+        /// <exception cref="ArgumentException">if the context is not set or encryption
+        /// parameters are not valid</exception>
+        /// <exception cref="ArgumentException">if the loaded ciphertext data is invalid or
+        /// is invalid for the context</exception>
+        /// <seealso cref="Save(Span{byte})">See Save() to save a ciphertext.</seealso>
+        public int Load(SEALContext context, ReadOnlySpan<byte> buffer)
+        {
+            if (null == context)
+                throw new ArgumentNullException(nameof(context));
+
+            int bytesRead = UnsafeLoad(buffer);
+
+            if (!IsValidFor(context))
+            {
+                throw new ArgumentException("Ciphertext data is invalid for the SEALContext");
+            }
+            return bytesRead;
+        }
+
+        /// <summary>
+        /// Writes the metadata saved before the polynomial data.
+        /// </summary>
+        /// <param name="header">The buffer to write SaveHeaderSize bytes to</param>
+        private void SaveHeader(Span<byte> header)
+        {
+            ParmsId parmsId = ParmsId;
+            for (int i = 0; i < ParmsId.ULongCount; i++)
+            {
+                BinaryPrimitives.WriteUInt64LittleEndian(
+                    header.Slice(i * sizeof(ulong)), parmsId.Block[i]);
+            }
+            int offset = ParmsId.ULongCount * sizeof(ulong);
+            header[offset++] = IsNTTForm ? (byte)1 : (byte)0;
+            BinaryPrimitives.WriteUInt64LittleEndian(header.Slice(offset), Size);
+            offset += sizeof(ulong);
+            BinaryPrimitives.WriteUInt64LittleEndian(header.Slice(offset), PolyModulusDegree);
+            offset += sizeof(ulong);
+            BinaryPrimitives.WriteUInt64LittleEndian(header.Slice(offset), CoeffModCount);
+        }
+
+        /// <summary>
+        /// Reads the metadata saved by Save without changing the ciphertext.
+        /// </summary>
+        /// <param name="header">The first SaveHeaderSize bytes saved by Save</param>
+        /// <exception cref="ArgumentException">if the ciphertext is too large</exception>
+        private static SaveHeaderFields ReadHeader(ReadOnlySpan<byte> header)
+        {
+            SaveHeaderFields fields = new SaveHeaderFields();
+            fields.ParmsId = new ParmsId();
+            for (int i = 0; i < ParmsId.ULongCount; i++)
+            {
+                fields.ParmsId.Block[i] = BinaryPrimitives.ReadUInt64LittleEndian(
+                    header.Slice(i * sizeof(ulong)));
+            }
+            int offset = ParmsId.ULongCount * sizeof(ulong);
+            fields.IsNTTForm = header[offset++] != 0;
+            fields.Size = BinaryPrimitives.ReadUInt64LittleEndian(header.Slice(offset));
+            offset += sizeof(ulong);
+            fields.PolyModulusDegree = BinaryPrimitives.ReadUInt64LittleEndian(header.Slice(offset));
+            offset += sizeof(ulong);
+            fields.CoeffModCount = BinaryPrimitives.ReadUInt64LittleEndian(header.Slice(offset));
+
+            try
+            {
+                fields.DataSize = checked((long)(fields.Size * fields.PolyModulusDegree *
+                    fields.CoeffModCount * sizeof(ulong)));
+            }
+            catch (OverflowException ex)
+            {
+                throw new ArgumentException("Ciphertext is too large", ex);
+            }
+            return fields;
+        }
+
+        /// <summary>
+        /// Sets the metadata read by ReadHeader and resizes the ciphertext to match.
+        /// </summary>
+        /// <param name="fields">The metadata</param>
+        private void ApplyHeader(SaveHeaderFields fields)
+        {
+            ParmsId = fields.ParmsId;
+            IsNTTForm = fields.IsNTTForm;
+            Resize(fields.Size, fields.PolyModulusDegree, fields.CoeffModCount);
+        }
+
+        /// <summary>
+        /// Metadata saved before the polynomial data
+        /// </summary>
+        private struct SaveHeaderFields
+        {
+            public ParmsId ParmsId;
+            public bool IsNTTForm;
+            public ulong Size;
+            public ulong PolyModulusDegree;
+            public ulong CoeffModCount;
+            public long DataSize;
+        }
+
         /// <summary>
         /// Returns whether the ciphertext is in NTT form.
         /// </summary>
@@ -701,6 +893,20 @@ namespace Microsoft.Research.SEAL
             }
         }
 
+        /// <summary>
+        /// Number of bytes saved before the polynomial data: the parmsId, whether
+        /// the ciphertext is in NTT form, its size, the degree of the polynomial
+        /// modulus, and the number of primes in the coefficient modulus
+        /// </summary>
+        private const int SaveHeaderSize =
+            ParmsId.ULongCount * sizeof(ulong) + sizeof(bool) + 3 * sizeof(ulong);
+
+        /// <summary>
+        /// Number of bytes of polynomial data copied at a time when saving to or
+        /// loading from a stream; small enough to stay off the large object heap
+        /// </summary>
+        private const int StreamChunkSize = 81920;
+
         /// <summary>
         /// Destroy native object.
         /// </summary>
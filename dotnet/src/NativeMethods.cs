@@ -576,6 +576,12 @@ namespace Microsoft.Research.SEAL
         [DllImport(sealnetnative, PreserveSig = false)]
         internal static extern void Ciphertext_SetDataAt(IntPtr thisptr, ulong index, ulong value);
 
+        [DllImport(sealnetnative, PreserveSig = false)]
+        internal static extern void Ciphertext_GetData(IntPtr thisptr, ulong byteOffset, ulong byteCount, ref byte data);
+
+        [DllImport(sealnetnative, PreserveSig = false)]
+        internal static extern void Ciphertext_SetData(IntPtr thisptr, ulong byteOffset, ulong byteCount, ref byte data);
+
         [DllImport(sealnetnative, PreserveSig = false)]
         internal static extern void Ciphertext_IsNTTForm(IntPtr thisptr, out bool isNTTForm);
 
@@ -1058,19 +1064,19 @@ namespace Microsoft.Research.SEAL
         internal static extern void BatchEncoder_Destroy(IntPtr thisptr);
 
         [DllImport(sealnetnative, EntryPoint = "BatchEncoder_Encode1", PreserveSig = false)]
-        internal static extern void BatchEncoder_Encode(IntPtr thisptr, ulong count, ulong[] values, IntPtr destination);
+        internal static extern void BatchEncoder_Encode(IntPtr thisptr, ulong count, ref ulong values, IntPtr destination);
 
         [DllImport(sealnetnative, EntryPoint = "BatchEncoder_Encode2", PreserveSig = false)]
-        internal static extern void BatchEncoder_Encode(IntPtr thisptr, ulong count, long[] values, IntPtr destination);
+        internal static extern void BatchEncoder_Encode(IntPtr thisptr, ulong count, ref long values, IntPtr destination);
 
         [DllImport(sealnetnative, EntryPoint = "BatchEncoder_Encode3", PreserveSig = false)]
         internal static extern void BatchEncoder_Encode(IntPtr thisptr, IntPtr plain, IntPtr pool);
 
         [DllImport(sealnetnative, EntryPoint = "BatchEncoder_Decode1", PreserveSig = false)]
-        internal static extern void BatchEncoder_Decode(IntPtr thisptr, IntPtr plain, ref ulong count, ulong[] destination, IntPtr pool);
+        internal static extern void BatchEncoder_Decode(IntPtr thisptr, IntPtr plain, ref ulong count, ref ulong destination, IntPtr pool);
 
         [DllImport(sealnetnative, EntryPoint = "BatchEncoder_Decode2", PreserveSig = false)]
-        internal static extern void BatchEncoder_Decode(IntPtr thisptr, IntPtr plain, ref ulong count, long[] destination, IntPtr pool);
+        internal static extern void BatchEncoder_Decode(IntPtr thisptr, IntPtr plain, ref ulong count, ref long destination, IntPtr pool);
 
         [DllImport(sealnetnative, EntryPoint = "BatchEncoder_Decode3", PreserveSig = false)]
         internal static extern void BatchEncoder_Decode(IntPtr thisptr, IntPtr plain, IntPtr pool);
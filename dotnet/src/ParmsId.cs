@@ -193,6 +193,6 @@ namespace Microsoft.Research.SEAL
         /// <summary>
         /// Number of elements in the hash block array
         /// </summary>
-        private const int ULongCount = 4;
+        internal const int ULongCount = 4;
     }
 }
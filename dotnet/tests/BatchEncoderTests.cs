@@ -157,6 +157,64 @@ namespace SEALNetTest
             }
         }
 
+        [TestMethod]
+        public void EncodeSpanTest()
+        {
+            EncryptionParameters parms = new EncryptionParameters(SchemeType.BFV);
+            parms.PolyModulusDegree = 64;
+            List<SmallModulus> coeffModulus = new List<SmallModulus>();
+            coeffModulus.Add(DefaultParams.SmallMods60Bit(0));
+            parms.CoeffModulus = coeffModulus;
+            parms.PlainModulus = new SmallModulus(257);
+
+            SEALContext context = SEALContext.Create(parms);
+
+            BatchEncoder encoder = new BatchEncoder(context);
+
+            // Read a matrix from the middle of a larger buffer
+            ulong[] buffer = new ulong[encoder.SlotCount + 8];
+            for (int i = 0; i < buffer.Length; i++)
+            {
+                buffer[i] = (ulong)(i * 37 + 11) % 257;
+            }
+
+            Plaintext plain = new Plaintext();
+            encoder.Encode(new ReadOnlySpan<ulong>(buffer, 8, 64), plain);
+
+            ulong[] result = new ulong[encoder.SlotCount];
+            encoder.Decode(plain, new Span<ulong>(result));
+            for (int i = 0; i < 64; i++)
+            {
+                Assert.AreEqual(buffer[8 + i], result[i]);
+            }
+
+            Memory<ulong> memory = buffer;
+            encoder.Encode(memory.Span.Slice(0, 20), plain);
+            encoder.Decode(plain, result);
+            for (int i = 0; i < 64; i++)
+            {
+                Assert.AreEqual(i < 20 ? buffer[i] : 0ul, result[i]);
+            }
+
+            long[] signedBuffer = new long[encoder.SlotCount];
+            for (int i = 0; i < signedBuffer.Length; i++)
+            {
+                signedBuffer[i] = i - 32;
+            }
+
+            encoder.Encode(signedBuffer, plain);
+            long[] signedResult = new long[encoder.SlotCount];
+            encoder.Decode(plain, new Span<long>(signedResult));
+            CollectionAssert.AreEqual(signedBuffer, signedResult);
+
+            encoder.Encode(ReadOnlySpan<ulong>.Empty, plain);
+            Assert.IsTrue(plain.IsZero);
+
+            Assert.ThrowsException<ArgumentException>(() => encoder.Encode(new ulong[65], plain));
+            Assert.ThrowsException<ArgumentException>(() => encoder.Decode(plain, new ulong[63]));
+            Assert.ThrowsException<ArgumentException>(() => encoder.Decode(plain, new long[0]));
+        }
+
         [TestMethod]
         public void EncodeInPlaceTest()
         {
@@ -6,6 +6,7 @@ using Microsoft.VisualStudio.TestTools.UnitTesting;
 using System;
 using System.Collections.Generic;
 using System.IO;
+using System.Linq;
 using System.Numerics;
 
 namespace SEALNetTest
@@ -153,6 +154,59 @@ namespace SEALNetTest
             }
         }
 
+        [TestMethod]
+        public void SaveLoadSpanTest()
+        {
+            SEALContext context = GlobalContext.Context;
+            KeyGenerator keygen = new KeyGenerator(context);
+            Encryptor encryptor = new Encryptor(context, keygen.PublicKey);
+            Plaintext plain = new Plaintext("2x^3 + 4x^2 + 5x^1 + 6");
+            Ciphertext cipher = new Ciphertext();
+
+            encryptor.Encrypt(plain, cipher);
+
+            // Save into the middle of a larger buffer
+            byte[] buffer = new byte[cipher.SaveSize + 3];
+            int written = cipher.Save(new Span<byte>(buffer, 3, buffer.Length - 3));
+            Assert.AreEqual(cipher.SaveSize, (long)written);
+
+            // The format is the same as with streams
+            using (MemoryStream mem = new MemoryStream())
+            {
+                cipher.Save(mem);
+                CollectionAssert.AreEqual(mem.ToArray(), buffer.Skip(3).ToArray());
+            }
+
+            Ciphertext loaded = new Ciphertext();
+            Assert.AreEqual(written, loaded.Load(context, new ReadOnlySpan<byte>(buffer, 3, written)));
+
+            Assert.AreEqual(2ul, loaded.Size);
+            Assert.AreEqual(4096ul, loaded.PolyModulusDegree);
+            Assert.AreEqual(2ul, loaded.CoeffModCount);
+            Assert.AreEqual(cipher.ParmsId, loaded.ParmsId);
+
+            ulong ulongCount = cipher.Size * cipher.PolyModulusDegree * cipher.CoeffModCount;
+            for (ulong i = 0; i < ulongCount; i++)
+            {
+                Assert.AreEqual(cipher[i], loaded[i]);
+            }
+
+            Assert.ThrowsException<ArgumentException>(() => cipher.Save(new byte[written - 1]));
+            Assert.ThrowsException<ArgumentException>(() => loaded.UnsafeLoad(new byte[10]));
+
+            // A truncated buffer leaves the ciphertext unchanged
+            Assert.ThrowsException<ArgumentException>(() => loaded.UnsafeLoad(buffer.Skip(3).Take(written - 1).ToArray()));
+            byte[] grown = buffer.Skip(3).Take(written).ToArray();
+            grown[ParmsId.ULongCount * sizeof(ulong) + 1] = 3;
+            Assert.ThrowsException<ArgumentException>(() => loaded.UnsafeLoad(grown));
+            Assert.AreEqual(2ul, loaded.Size);
+            Assert.AreEqual(cipher.ParmsId, loaded.ParmsId);
+            for (ulong i = 0; i < ulongCount; i++)
+            {
+                Assert.AreEqual(cipher[i], loaded[i]);
+            }
+        }
+
         [TestMethod]
         public void IndexTest()
         {
@@ -328,13 +382,13 @@ namespace SEALNetTest
             Assert.ThrowsException<ArgumentNullException>(() => cipher.IsValidFor(null));
             Assert.ThrowsException<ArgumentNullException>(() => cipher.IsMetadataValidFor(null));
 
-            Assert.ThrowsException<ArgumentNullException>(() => cipher.Save(null));
+            Assert.ThrowsException<ArgumentNullException>(() => cipher.Save((Stream)null));
 
-            Assert.ThrowsException<ArgumentNullException>(() => cipher.UnsafeLoad(null));
+            Assert.ThrowsException<ArgumentNullException>(() => cipher.UnsafeLoad((Stream)null));
             Assert.ThrowsException<ArgumentException>(() => cipher.UnsafeLoad(new MemoryStream()));
 
             Assert.ThrowsException<ArgumentNullException>(() => cipher.Load(null, new MemoryStream()));
-            Assert.ThrowsException<ArgumentNullException>(() => cipher.Load(context, null));
+            Assert.ThrowsException<ArgumentNullException>(() => cipher.Load(context, (Stream)null));
         }
     }
 }
@@ -22,14 +22,18 @@
 
 // this one doesnt work properly
 
-#define poly_mod 8192
-#define plain_mod_batch 114689
+// #define poly_mod 8192
+// #define plain_mod_batch 114689
 
-// #define poly_mod 16384
-// #define plain_mod_batch 163841
+#define poly_mod 16384
+#define plain_mod_batch 65537
 
 #define EPSILON 1
 
+// bits of noise budget kept in reserve when compacting results, since the
+// budget is measured on the first result only
+#define NOISE_BUDGET_MARGIN 10
+
 #include "seal/seal.h"
 
 using namespace std;
@@ -74,12 +78,17 @@ int main() {
     */
     Decryptor decryptor(context, s_key);
 
+    /*
+    The Evaluator switches each result to the smallest modulus that still
+    decrypts correctly, which makes decryption cheaper.
+    */
+    Evaluator evaluator(context);
+
     
     /*
-    Batching is done through an instance of the BatchEncoder class so need to
-    construct one.
+    The linkage decisions are read by a NucleotideEncoder.
     */
-    BatchEncoder batch_encoder(context);
+    NucleotideEncoder nucleotide_encoder(context);
 
     ifstream in_file_A;
     in_file_A.open("Site_A_number_seqs.txt");
@@ -100,40 +109,56 @@ int main() {
         seq_num >> num_seqs_B;
     }
 
-    ofstream out("HAMMING_A_B.txt");
+    /*
+    Each row of site A comes as one ciphertext holding the decisions for all
+    of site B. The decrypted slots hold only the decisions, and the noise is
+    flooded, so neither reveals the distances of unlinked pairs.
+    */
+    vector<Ciphertext> compared_links(num_seqs_A);
+    int noise_budget = -1;
     for(int i = 0; i < num_seqs_A; i++){
+        string a_num_str = to_string(i);
+        string inlink = "Link_A_" + a_num_str + ".txt";
+
+        ifstream infile_link;
+        infile_link.open(inlink);
+        compared_links[i].unsafe_load(infile_link);
+
+        // all results come from the same circuit, so measuring the first
+        // one is enough; pass this to t_compare after the threshold to
+        // compact results there
+        if (noise_budget < 0) {
+            noise_budget = decryptor.invariant_noise_budget(compared_links[i]);
+            cout << "Noise budget of results: " << noise_budget << " bits" << endl;
+        }
+        evaluator.mod_switch_to_lowest_inplace(compared_links[i],
+            max(noise_budget - NOISE_BUDGET_MARGIN, 0));
+    }
+
+    // decode //
+    decryptor.set_thread_count(0);
+    vector<Plaintext> plain_results;
+    decryptor.decrypt_many(compared_links, plain_results);
+
+    ofstream out("LINKS_A_B.txt");
+    for(int i = 0; i < num_seqs_A; i++){
+        string a_num_str = to_string(i);
+
+        vector<uint64_t> links;
+        nucleotide_encoder.decode_links(plain_results[i], num_seqs_B, links);
+
         for(int j = 0; j < num_seqs_B; j++){
-            // decode //
-            string a_num_str = to_string(i);
             string b_num_str = to_string(j);
-            string inham = "Enc_A_" + a_num_str + "_B_" + b_num_str + ".txt";
-            string outham = "HAM_A_" + a_num_str + "_B_" + b_num_str + ".txt";
-            
-            ifstream infile_ham;
-            infile_ham.open(inham);
-
-            Ciphertext compared_ham;
-            compared_ham.unsafe_load(infile_ham);
-            Plaintext plain_result;
-            decryptor.decrypt(compared_ham, plain_result);
-
-            vector<uint64_t> result;
-            batch_encoder.decode(plain_result, result);
-    
+            bool linked = (links[j / 64] >> (j % 64)) & 1;
 
-            int ans = result[0]/2;
-            int len_of_seq = 4;
-            int real_ans = ans % len_of_seq;
-            
-            cout << "Different Between A " << i + 1 << " and " << "B " << j + 1 << " is: " << real_ans << endl;
-            cout << endl;
+            if (linked) {
+                cout << "A " << i + 1 << " and " << "B " << j + 1 << " are linked" << endl;
+            }
 
-            string s_ans = to_string(real_ans);
-            string out_line = "A_" + a_num_str + "_B_" + b_num_str + ":" + s_ans + "\n";  
+            string out_line = "A_" + a_num_str + "_B_" + b_num_str + ":" + to_string(linked) + "\n";
 
             out << out_line;
         }
     }
     out.close();
 }
-
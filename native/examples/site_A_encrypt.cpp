@@ -21,11 +21,14 @@
 // #define plain_mod_batch 40961
 
 // this one doesnt work properly
-#define poly_mod 8192
-#define plain_mod_batch 114689
+// #define poly_mod 8192
+// #define plain_mod_batch 114689
 
-// #define poly_mod 16384
-// #define plain_mod_batch 163841
+// the linkage decision in t_compare needs the larger coefficient modulus,
+// and the smallest batching plain modulus leaves the flooding room for
+// thresholds up to 31
+#define poly_mod 16384
+#define plain_mod_batch 65537
 
 #define EPSILON 1
 
@@ -34,37 +37,6 @@
 using namespace std;
 using namespace seal;
 
-/*
-
-This scheme will operate on INTS
-
-*/
-
-vector<uint64_t> one_hot(string seq) {
-
-    vector<uint64_t> one_hot_encoded;
-
-    std::map<char, vector<uint64_t>> one_hot_map;
-
-    one_hot_map['A'] = vector<uint64_t>{0, 0, 0, 0, 1};
-    one_hot_map['G'] = vector<uint64_t>{0, 0, 0, 1, 0};
-    one_hot_map['C'] = vector<uint64_t>{0, 0, 1, 0, 0};
-    one_hot_map['T'] = vector<uint64_t>{0, 1, 0, 0, 0};
-    one_hot_map['-'] = vector<uint64_t>{1000, 0, 0, 0, 0};
-
-    if (!seq.empty()) {
-
-        for (auto n : seq) {
-            std::copy(one_hot_map[n].begin(), one_hot_map[n].end(),
-                      std::back_inserter(one_hot_encoded));
-        }
-
-        return one_hot_encoded;
-    }
-
-    return {};
-}
-
 int main()
 
 {
@@ -123,22 +95,13 @@ int main()
     Encryptor encryptor(context, public_key);
 
     /*
-    Batching is done through an instance of the BatchEncoder class so need to
-    construct one.
-    */
-    BatchEncoder batch_encoder(context);
-
-    /*
-    The total number of batching `slots' is poly_modulus_degree. The matrices
-    we encrypt are of size 2-by-(slot_count / 2).
+    Each nucleotide takes two bits, bit-sliced over the two rows of the
+    batching matrix, so a sequence of up to slot_count / 2 nucleotides fits in
+    a plaintext.
     */
-    size_t slot_count = batch_encoder.slot_count();
-    size_t row_size = slot_count / 2;
-    cout << "Plaintext matrix row size: " << row_size << endl;
+    NucleotideEncoder nucleotide_encoder(context);
+    cout << "Longest sequence: " << nucleotide_encoder.sequence_capacity() << endl;
 
-    /*
-    Remeber each vector has to be of type uint64_t
-    */
     // Read FASTA file
     ifstream hxb2;
     //hxb2.open("../examples/rsrc/HXB2_prrt_multiple.fa");
@@ -173,39 +136,41 @@ int main()
     hxb2.close();
 
     cout << endl;
-    cout << "One Hot Encoding sequences from Site A" << endl;
-
-    vector<vector<uint64_t>> siteA;
+    cout << "Encoding sequences from Site A" << endl;
 
+    // gaps and ambiguity codes are masked out of the comparison
+    vector<string> siteA;
     for (auto const& i : sequences) {
-        auto sequence = one_hot(i.second);
-        siteA.push_back(sequence);
+        siteA.push_back(i.second);
     }
-    
-    // write a file for the lenth of siteA 
+
+    // write a file for the lenth of siteA
     // this will be read in to compare the two sites
     ofstream number_of_seqs("Site_A_number_seqs.txt");
     number_of_seqs << siteA.size();
     number_of_seqs.close();
 
-    for (int i = 0; i < siteA.size(); i++) {
+    vector<Plaintext> plain_sequences;
+    vector<Plaintext> plain_masks;
+    nucleotide_encoder.encode_many(siteA, plain_sequences, plain_masks);
 
-        auto siteA_vector = siteA[i];
+    for (int i = 0; i < siteA.size(); i++) {
 
-        auto siteA_size = siteA_vector.size();
+        Ciphertext encrypted_sequence;
+        encryptor.encrypt(plain_sequences[i], encrypted_sequence);
 
-        Plaintext plain_matrix;
-        batch_encoder.encode(siteA_vector, plain_matrix);
+        Ciphertext encrypted_mask;
+        encryptor.encrypt(plain_masks[i], encrypted_mask);
 
-        // plaintext (input 1) becomes the `encrypted_matrix` 
-        Ciphertext encrypted_matrix;
-        encryptor.encrypt(plain_matrix, encrypted_matrix);
-        
-        // saving the ciphertext here //
+        // saving the ciphertexts here //
         string s = to_string(i);
 
         ofstream myfile;
         myfile.open("encrypted_A_" + s + ".txt");
-        encrypted_matrix.save(myfile);
+        encrypted_sequence.save(myfile);
+
+        ofstream maskfile;
+        maskfile.open("mask_A_" + s + ".txt");
+        encrypted_mask.save(maskfile);
     }
 }
@@ -21,14 +21,24 @@
 // #define plain_mod_batch 40961
 
 // this one doesnt work properly
-#define poly_mod 8192
-#define plain_mod_batch 114689
+// #define poly_mod 8192
+// #define plain_mod_batch 114689
 
-// #define poly_mod 16384
-// #define plain_mod_batch 163841
+#define poly_mod 16384
+#define plain_mod_batch 65537
 
 #define EPSILON 1
 
+// bits of noise budget kept in reserve when compacting results, since the
+// budget passed in was measured on a single result
+#define NOISE_BUDGET_MARGIN 10
+
+// pairs of sequences with at most this many mismatching nucleotides are
+// linked; each doubling of the threshold costs another multiplicative level,
+// and with the parameters of site_A thresholds above 31 leave no room for
+// the noise flooding and are rejected
+#define LINK_THRESHOLD 24
+
 #include "seal/seal.h"
 
 using namespace std;
@@ -77,9 +87,24 @@ void compare_and_encrypt (int i, int j, Evaluator evaluator, RelinKeys r_keys, G
 }
 */
 
-int main()
+int main(int argc, char *argv[])
 
 {
+    // the linkage threshold can be given as the first argument
+    uint64_t threshold = LINK_THRESHOLD;
+    if (argc > 1) {
+        threshold = stoull(argv[1]);
+    }
+
+    // the results are switched to the smallest modulus before saving; by
+    // default this relies on the noise budget estimate carried by the
+    // ciphertexts, while a noise budget measured by read_in_hamming can be
+    // given instead
+    int noise_budget = -1;
+    if (argc > 2) {
+        noise_budget = max(stoi(argv[2]) - NOISE_BUDGET_MARGIN, 0);
+    }
+
     // Set up encryption parameters
     // read in site_A parms //
     ifstream infile_parms_A;
@@ -115,11 +140,23 @@ int main()
     r_keys.unsafe_load(rk_A);
     //auto relin_keys16 = keygen.relin_keys(16);
 
+    // the public key re-randomizes the results before they leave this site
+    ifstream pk_A;
+    pk_A.open("pk_A.txt");
+    PublicKey public_key;
+    public_key.unsafe_load(pk_A);
+
     
     /*
     We also set up an Evaluator here.
     */
     Evaluator evaluator(context);
+
+    /*
+    The distances are computed and compared to the threshold by a
+    SequenceEvaluator, so only the linkage decisions leave this site.
+    */
+    SequenceEvaluator sequence_evaluator(context);
     
     ifstream in_file_A;
     in_file_A.open("Site_A_number_seqs.txt");
@@ -144,48 +181,55 @@ int main()
         seq_num >> num_seqs_B;
     }
     cout << "these are the number of seqs in B " << num_seqs_B << endl;
+    cout << "linking pairs with at most " << threshold << " differences" << endl;
+
+    // the sequences of site B are compared to every sequence of site A
+    vector<Ciphertext> ciphers_B(num_seqs_B);
+    vector<Ciphertext> masks_B(num_seqs_B);
+    for(int j = 0; j < num_seqs_B; j++){
+        string b_num_str = to_string(j);
+
+        ifstream in_file_B("encrypted_B_" + b_num_str + ".txt");
+        ciphers_B[j].unsafe_load(in_file_B);
+
+        ifstream in_mask_B("mask_B_" + b_num_str + ".txt");
+        masks_B[j].unsafe_load(in_mask_B);
+    }
 
     for(int i = 0; i < num_seqs_A; i++){
+        string a_num_str = to_string(i);
+        string o_file = "Link_A_" + a_num_str + ".txt";
+
+        ifstream in_file_A("encrypted_A_" + a_num_str + ".txt");
+        Ciphertext cipher_A;
+        cipher_A.unsafe_load(in_file_A);
+
+        ifstream in_mask_A("mask_A_" + a_num_str + ".txt");
+        Ciphertext mask_A;
+        mask_A.unsafe_load(in_mask_A);
+
+        // differences at positions where both nucleotides are known //
+        vector<Ciphertext> distances(num_seqs_B);
         for(int j = 0; j < num_seqs_B; j++){
-            // do a comparison //
-            string a_num_str = to_string(i); 
-            string b_num_str = to_string(j);
-
-            string a_file = "encrypted_A_" + a_num_str + ".txt";
-            string b_file = "encrypted_B_" + b_num_str + ".txt";
-            string o_file =  "Enc_A_" + a_num_str + "_B_" + b_num_str + ".txt";
-
-            //cout << "A goes to --> " << a_file << " B goes to --> " << b_file << endl;
-            
-            ifstream in_file_A;
-            ifstream in_file_B;
-
-            in_file_A.open(a_file);
-            in_file_B.open(b_file);
-
-            Ciphertext cipher_A;
-            Ciphertext cipher_B;
-
-            cipher_A.unsafe_load(in_file_A);
-            cipher_B.unsafe_load(in_file_B);
-
-            //cout << "A goes to --> " << a_file << " B goes to --> " << b_file << endl;
-            evaluator.sub_inplace(cipher_A, cipher_B);
-            evaluator.square_inplace(cipher_A);
-            evaluator.relinearize_inplace(cipher_A, r_keys);
-            
-            // making changes 11/5
-            Ciphertext temp_enc_mat;
-            for (auto i = 0; i < (log2(poly_mod) - 1); i++) {
-            //for (auto i = 0; i < log2(poly_mod); i++) {
-                evaluator.rotate_rows(cipher_A, -(pow(2,i)), g_keys, temp_enc_mat);
-                evaluator.add_inplace(cipher_A, temp_enc_mat);
-            }
-            
-            ofstream myfile;
-            myfile.open(o_file);
-            cipher_A.save(myfile);
+            sequence_evaluator.masked_mismatch_count(cipher_A, mask_A,
+                ciphers_B[j], masks_B[j], r_keys, g_keys, distances[j]);
+        }
 
+        // one ciphertext per row holds the decisions for all pairs //
+        Ciphertext links;
+        sequence_evaluator.link_indicator(distances, threshold, r_keys, public_key,
+            links);
+
+        // compact for output //
+        if (noise_budget < 0) {
+            evaluator.mod_switch_to_lowest_inplace(links);
+        }
+        else {
+            evaluator.mod_switch_to_lowest_inplace(links, noise_budget);
         }
+        
+        ofstream myfile;
+        myfile.open(o_file);
+        links.save(myfile);
     }
 }
@@ -7,6 +7,8 @@
 #include <limits>
 #include "seal/batchencoder.h"
 #include "seal/util/polycore.h"
+#include "seal/util/parallel.h"
+#include "seal/util/simd.h"
 
 using namespace std;
 using namespace seal::util;
@@ -91,25 +93,119 @@ namespace seal
             pos *= gen;
             pos &= (m - 1);
         }
+
+        matrix_reps_inverse_map_ = allocate_uint(slots_, pool_);
+        for (size_t i = 0; i < slots_; i++)
+        {
+            matrix_reps_inverse_map_[matrix_reps_index_map_[i]] = i;
+        }
+    }
+
+    void BatchEncoder::encode_matrix(const uint64_t *values, bool is_signed,
+        uint64_t *destination) const
+    {
+        auto &context_data = *context_->context_data();
+
+        // Read the values in bit-reversed order straight into destination
+        if (!gather_uint64_simd(values, matrix_reps_inverse_map_.get(), slots_,
+            destination))
+        {
+            for (size_t i = 0; i < slots_; i++)
+            {
+                destination[i] = values[matrix_reps_inverse_map_[i]];
+            }
+        }
+        if (is_signed)
+        {
+            uint64_t modulus = context_data.parms().plain_modulus().value();
+            for (size_t i = 0; i < slots_; i++)
+            {
+                destination[i] += modulus & static_cast<uint64_t>(
+                    -static_cast<int64_t>(static_cast<int64_t>(destination[i]) < 0));
+            }
+        }
+
+        // Transform destination using inverse of negacyclic NTT
+        inverse_ntt_negacyclic_harvey(destination, *context_data.plain_ntt_tables());
+    }
+
+    void BatchEncoder::decode_matrix(const Plaintext &plain, uint64_t *destination,
+        MemoryPoolHandle pool) const
+    {
+        // Never include the leading zero coefficient (if present)
+        size_t plain_coeff_count = min(plain.coeff_count(), slots_);
+
+        auto temp_dest(allocate_uint(slots_, pool));
+
+        // Make a copy of poly
+        set_uint_uint(plain.data(), plain_coeff_count, temp_dest.get());
+        set_zero_uint(slots_ - plain_coeff_count, temp_dest.get() + plain_coeff_count);
+
+        // Transform destination using negacyclic NTT.
+        ntt_negacyclic_harvey(temp_dest.get(),
+            *context_->context_data()->plain_ntt_tables());
+
+        // Read top row, then bottom row
+        if (!gather_uint64_simd(temp_dest.get(), matrix_reps_index_map_.get(),
+            slots_, destination))
+        {
+            for (size_t i = 0; i < slots_; i++)
+            {
+                destination[i] = temp_dest[matrix_reps_index_map_[i]];
+            }
+        }
+    }
+
+    void BatchEncoder::decode_matrix(const Plaintext &plain, int64_t *destination,
+        MemoryPoolHandle pool) const
+    {
+        uint64_t modulus = context_->context_data()->parms().plain_modulus().value();
+        uint64_t plain_modulus_div_two = modulus >> 1;
+
+        // Decode into the destination as unsigned values and center them in
+        // place; signed and unsigned integers may alias each other
+        decode_matrix(plain, reinterpret_cast<uint64_t*>(destination), move(pool));
+        for (size_t i = 0; i < slots_; i++)
+        {
+            uint64_t curr_value = static_cast<uint64_t>(destination[i]);
+            destination[i] = static_cast<int64_t>(curr_value - (modulus &
+                static_cast<uint64_t>(-static_cast<int64_t>(
+                    curr_value > plain_modulus_div_two))));
+        }
     }
 
     void BatchEncoder::encode(const vector<uint64_t> &values_matrix, 
         Plaintext &destination)
+    {
+        encode(values_matrix.data(), values_matrix.size(), destination);
+    }
+
+    void BatchEncoder::encode(const vector<int64_t> &values_matrix, 
+        Plaintext &destination)
+    {
+        encode(values_matrix.data(), values_matrix.size(), destination);
+    }
+
+    void BatchEncoder::encode(const uint64_t *values_matrix, size_t count,
+        Plaintext &destination)
     {
         auto &context_data = *context_->context_data();
 
         // Validate input parameters
-        size_t values_matrix_size = values_matrix.size();
-        if (values_matrix_size > slots_)
+        if (!values_matrix && count)
+        {
+            throw invalid_argument("values_matrix cannot be null");
+        }
+        if (count > slots_)
         {
             throw logic_error("values_matrix size is too large");
         }
 #ifdef SEAL_DEBUG
         uint64_t modulus = context_data.parms().plain_modulus().value();
-        for (auto v : values_matrix)
+        for (size_t i = 0; i < count; i++)
         {
             // Validate the i-th input
-            if (v >= modulus)
+            if (values_matrix[i] >= modulus)
             {
                 throw invalid_argument("input value is larger than plain_modulus");
             }
@@ -119,13 +215,20 @@ namespace seal
         destination.resize(slots_);
         destination.parms_id() = parms_id_zero;
 
+        // A full matrix is read in bit-reversed order straight from the input
+        if (count == slots_)
+        {
+            encode_matrix(values_matrix, false, destination.data());
+            return;
+        }
+
         // First write the values to destination coefficients. 
         // Read in top row, then bottom row.
-        for (size_t i = 0; i < values_matrix_size; i++)
+        for (size_t i = 0; i < count; i++)
         {
             *(destination.data() + matrix_reps_index_map_[i]) = values_matrix[i];
         }
-        for (size_t i = values_matrix_size; i < slots_; i++)
+        for (size_t i = count; i < slots_; i++)
         {
             *(destination.data() + matrix_reps_index_map_[i]) = 0;
         }
@@ -135,24 +238,27 @@ namespace seal
         inverse_ntt_negacyclic_harvey(destination.data(), *context_data.plain_ntt_tables());
     }
 
-    void BatchEncoder::encode(const vector<int64_t> &values_matrix, 
+    void BatchEncoder::encode(const int64_t *values_matrix, size_t count,
         Plaintext &destination)
     {
         auto &context_data = *context_->context_data();
         uint64_t modulus = context_data.parms().plain_modulus().value();
 
         // Validate input parameters
-        size_t values_matrix_size = values_matrix.size();
-        if (values_matrix_size > slots_)
+        if (!values_matrix && count)
+        {
+            throw invalid_argument("values_matrix cannot be null");
+        }
+        if (count > slots_)
         {
             throw logic_error("values_matrix size is too large");
         }
 #ifdef SEAL_DEBUG
         uint64_t plain_modulus_div_two = modulus >> 1;
-        for (auto v : values_matrix)
+        for (size_t i = 0; i < count; i++)
         {
             // Validate the i-th input
-            if (unsigned_gt(llabs(v), plain_modulus_div_two))
+            if (unsigned_gt(llabs(values_matrix[i]), plain_modulus_div_two))
             {
                 throw invalid_argument("input value is larger than plain_modulus");
             }
@@ -162,15 +268,24 @@ namespace seal
         destination.resize(slots_);
         destination.parms_id() = parms_id_zero;
 
+        // A full matrix is read in bit-reversed order straight from the input;
+        // signed and unsigned integers may alias each other
+        if (count == slots_)
+        {
+            encode_matrix(reinterpret_cast<const uint64_t*>(values_matrix), true,
+                destination.data());
+            return;
+        }
+
         // First write the values to destination coefficients.  
         // Read in top row, then bottom row.
-        for (size_t i = 0; i < values_matrix_size; i++)
+        for (size_t i = 0; i < count; i++)
         {
             *(destination.data() + matrix_reps_index_map_[i]) = 
                 (values_matrix[i] < 0) ? (modulus + static_cast<uint64_t>(values_matrix[i])) : 
                     static_cast<uint64_t>(values_matrix[i]);
         }
-        for (size_t i = values_matrix_size; i < slots_; i++)
+        for (size_t i = count; i < slots_; i++)
         {
             *(destination.data() + matrix_reps_index_map_[i]) = 0;
         }
@@ -338,31 +453,58 @@ namespace seal
             throw invalid_argument("pool is uninitialized");
         }
 
-        auto &context_data = *context_->context_data();
-
         // Set destination size
         destination.resize(slots_);
 
-        // Never include the leading zero coefficient (if present)
-        size_t plain_coeff_count = min(plain.coeff_count(), slots_);
+        decode_matrix(plain, destination.data(), move(pool));
+    }
 
-        auto temp_dest(allocate_uint(slots_, pool));
+    void BatchEncoder::decode(const Plaintext &plain, vector<int64_t> &destination,
+        MemoryPoolHandle pool)
+    {
+        if (!plain.is_valid_for(context_))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+        if (plain.is_ntt_form())
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
 
-        // Make a copy of poly
-        set_uint_uint(plain.data(), plain_coeff_count, temp_dest.get());
-        set_zero_uint(slots_ - plain_coeff_count, temp_dest.get() + plain_coeff_count);
+        // Set destination size
+        destination.resize(slots_);
 
-        // Transform destination using negacyclic NTT.
-        ntt_negacyclic_harvey(temp_dest.get(), *context_data.plain_ntt_tables());
+        decode_matrix(plain, destination.data(), move(pool));
+    }
 
-        // Read top row
-        for (size_t i = 0; i < slots_; i++)
+    void BatchEncoder::decode(const Plaintext &plain, uint64_t *destination,
+        MemoryPoolHandle pool)
+    {
+        if (!plain.is_valid_for(context_))
         {
-            destination[i] = temp_dest[matrix_reps_index_map_[i]];
+            throw invalid_argument("plain is not valid for encryption parameters");
         }
+        if (plain.is_ntt_form())
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
+        if (!destination)
+        {
+            throw invalid_argument("destination cannot be null");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        decode_matrix(plain, destination, move(pool));
     }
 
-    void BatchEncoder::decode(const Plaintext &plain, vector<int64_t> &destination,
+    void BatchEncoder::decode(const Plaintext &plain, int64_t *destination,
         MemoryPoolHandle pool)
     {
         if (!plain.is_valid_for(context_))
@@ -373,39 +515,291 @@ namespace seal
         {
             throw invalid_argument("plain cannot be in NTT form");
         }
+        if (!destination)
+        {
+            throw invalid_argument("destination cannot be null");
+        }
         if (!pool)
         {
             throw invalid_argument("pool is uninitialized");
         }
 
-        auto &context_data = *context_->context_data();
-        uint64_t modulus = context_data.parms().plain_modulus().value();
+        decode_matrix(plain, destination, move(pool));
+    }
 
-        // Set destination size
-        destination.resize(slots_);
+    void BatchEncoder::decode_slots(const Plaintext &plain, const vector<size_t> &slots,
+        vector<uint64_t> &destination, MemoryPoolHandle pool)
+    {
+        if (!plain.is_valid_for(context_))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+        if (plain.is_ntt_form())
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
+        for (auto slot : slots)
+        {
+            if (slot >= slots_)
+            {
+                throw invalid_argument("slot index is out of range");
+            }
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // A full decode costs about log2(N) multiplications per slot, so it wins
+        // once that many slots are needed
+        int logn = get_power_of_two(slots_);
+        if (slots.size() >= static_cast<size_t>(logn))
+        {
+            vector<uint64_t> all_slots;
+            decode(plain, all_slots, move(pool));
+            destination.resize(slots.size());
+            for (size_t k = 0; k < slots.size(); k++)
+            {
+                destination[k] = all_slots[slots[k]];
+            }
+            return;
+        }
+
+        auto &modulus = context_->context_data()->parms().plain_modulus();
 
         // Never include the leading zero coefficient (if present)
         size_t plain_coeff_count = min(plain.coeff_count(), slots_);
 
-        auto temp_dest(allocate_uint(slots_, pool));
+        // Evaluate the plaintext at the root of unity of each slot with Horner's
+        // rule; the NTT output at bit-reversed index j is the value at
+        // roots_of_unity_[j]
+        destination.resize(slots.size());
+        for (size_t k = 0; k < slots.size(); k++)
+        {
+            MultiplyUIntModOperand root(roots_of_unity_[util::reverse_bits(
+                matrix_reps_index_map_[slots[k]], logn)], modulus);
+            uint64_t value = 0;
+            for (size_t i = plain_coeff_count; i--; )
+            {
+                value = add_uint_uint_mod(multiply_uint_mod(value, root, modulus),
+                    plain[i], modulus);
+            }
+            destination[k] = value;
+        }
+    }
 
-        // Make a copy of poly
-        set_uint_uint(plain.data(), plain_coeff_count, temp_dest.get());
-        set_zero_uint(slots_ - plain_coeff_count, temp_dest.get() + plain_coeff_count);
+    void BatchEncoder::decode_slots(const Plaintext &plain, const vector<size_t> &slots,
+        vector<int64_t> &destination, MemoryPoolHandle pool)
+    {
+        vector<uint64_t> values;
+        decode_slots(plain, slots, values, move(pool));
 
-        // Transform destination using negacyclic NTT.
-        ntt_negacyclic_harvey(temp_dest.get(), *context_data.plain_ntt_tables());
+        uint64_t modulus = context_->context_data()->parms().plain_modulus().value();
+        uint64_t plain_modulus_div_two = modulus >> 1;
+        destination.resize(values.size());
+        for (size_t k = 0; k < values.size(); k++)
+        {
+            destination[k] = (values[k] > plain_modulus_div_two) ?
+                (static_cast<int64_t>(values[k]) - static_cast<int64_t>(modulus)) :
+                static_cast<int64_t>(values[k]);
+        }
+    }
+    void BatchEncoder::encode_many(const vector<uint64_t> &values_matrices,
+        vector<Plaintext> &destinations)
+    {
+        // Validate input parameters
+        if (values_matrices.size() % slots_)
+        {
+            throw invalid_argument("values_matrices size is not a multiple of slot_count");
+        }
+#ifdef SEAL_DEBUG
+        uint64_t modulus = context_->context_data()->parms().plain_modulus().value();
+        for (auto v : values_matrices)
+        {
+            // Validate the i-th input
+            if (v >= modulus)
+            {
+                throw invalid_argument("input value is larger than plain_modulus");
+            }
+        }
+#endif
+        size_t matrix_count = values_matrices.size() / slots_;
+        destinations.resize(matrix_count);
+        parallel_for(matrix_count, thread_count_, [&](size_t i) {
+            Plaintext &destination = destinations[i];
+            destination.resize(slots_);
+            destination.parms_id() = parms_id_zero;
+            encode_matrix(values_matrices.data() + i * slots_, false,
+                destination.data());
+        });
+    }
 
-        // Read top row, then bottom row
+    void BatchEncoder::encode_many(const vector<int64_t> &values_matrices,
+        vector<Plaintext> &destinations)
+    {
+        // Validate input parameters
+        if (values_matrices.size() % slots_)
+        {
+            throw invalid_argument("values_matrices size is not a multiple of slot_count");
+        }
+#ifdef SEAL_DEBUG
+        uint64_t modulus = context_->context_data()->parms().plain_modulus().value();
         uint64_t plain_modulus_div_two = modulus >> 1;
+        for (auto v : values_matrices)
+        {
+            // Validate the i-th input
+            if (unsigned_gt(llabs(v), plain_modulus_div_two))
+            {
+                throw invalid_argument("input value is larger than plain_modulus");
+            }
+        }
+#endif
+        size_t matrix_count = values_matrices.size() / slots_;
+        destinations.resize(matrix_count);
+        parallel_for(matrix_count, thread_count_, [&](size_t i) {
+            Plaintext &destination = destinations[i];
+            destination.resize(slots_);
+            destination.parms_id() = parms_id_zero;
+
+            // The slot permutation commutes with reducing the values, so encode
+            // the two's complement representations and fix the signs after the
+            // gather; signed and unsigned integers may alias each other
+            encode_matrix(reinterpret_cast<const uint64_t*>(
+                values_matrices.data() + i * slots_), true, destination.data());
+        });
+    }
+
+    void BatchEncoder::decode_many(const vector<Plaintext> &plains,
+        vector<uint64_t> &destination, MemoryPoolHandle pool)
+    {
+        for (auto &plain : plains)
+        {
+            if (!plain.is_valid_for(context_))
+            {
+                throw invalid_argument("plains is not valid for encryption parameters");
+            }
+            if (plain.is_ntt_form())
+            {
+                throw invalid_argument("plains cannot be in NTT form");
+            }
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Set destination size
+        destination.resize(mul_safe(plains.size(), slots_));
+
+        parallel_for(plains.size(), thread_count_, [&](size_t i) {
+            decode_matrix(plains[i], destination.data() + i * slots_, pool);
+        });
+    }
+
+    void BatchEncoder::decode_many(const vector<Plaintext> &plains,
+        vector<int64_t> &destination, MemoryPoolHandle pool)
+    {
+        for (auto &plain : plains)
+        {
+            if (!plain.is_valid_for(context_))
+            {
+                throw invalid_argument("plains is not valid for encryption parameters");
+            }
+            if (plain.is_ntt_form())
+            {
+                throw invalid_argument("plains cannot be in NTT form");
+            }
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        uint64_t modulus = context_->context_data()->parms().plain_modulus().value();
+        uint64_t plain_modulus_div_two = modulus >> 1;
+
+        // Set destination size
+        destination.resize(mul_safe(plains.size(), slots_));
+
+        parallel_for(plains.size(), thread_count_, [&](size_t i) {
+            // Decode into the destination as unsigned values and center them in
+            // place; signed and unsigned integers may alias each other
+            int64_t *matrix = destination.data() + i * slots_;
+            decode_matrix(plains[i], reinterpret_cast<uint64_t*>(matrix), pool);
+            for (size_t j = 0; j < slots_; j++)
+            {
+                uint64_t curr_value = static_cast<uint64_t>(matrix[j]);
+                matrix[j] = static_cast<int64_t>(curr_value - (modulus &
+                    static_cast<uint64_t>(-static_cast<int64_t>(
+                        curr_value > plain_modulus_div_two))));
+            }
+        });
+    }
+    void BatchEncoder::encode_bits(const vector<uint64_t> &bits, Plaintext &destination)
+    {
+        // Validate input parameters
+        size_t bits_size = bits.size();
+        if (bits_size > bits_uint64_count())
+        {
+            throw invalid_argument("bits is too large");
+        }
+
+        // Unpack the bits, counting the ones
+        auto values(allocate_zero_uint(slots_, pool_));
+        size_t one_count = 0;
+        size_t bit_count = min(slots_,
+            mul_safe(bits_size, static_cast<size_t>(bits_per_uint64)));
+        for (size_t i = 0; i < bit_count; i++)
+        {
+            values[i] = (bits[i / bits_per_uint64] >> (i % bits_per_uint64)) & 1;
+            one_count += static_cast<size_t>(values[i]);
+        }
+
+        // Set destination to full size
+        destination.resize(slots_);
+        destination.parms_id() = parms_id_zero;
+
+        // Constant matrices are constant polynomials
+        if (one_count == 0 || one_count == slots_)
+        {
+            destination.set_zero();
+            destination[0] = one_count ? 1 : 0;
+            return;
+        }
+        encode_matrix(values.get(), false, destination.data());
+    }
+
+    void BatchEncoder::decode_bits(const Plaintext &plain, vector<uint64_t> &destination,
+        MemoryPoolHandle pool)
+    {
+        if (!plain.is_valid_for(context_))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+        if (plain.is_ntt_form())
+        {
+            throw invalid_argument("plain cannot be in NTT form");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto values(allocate_uint(slots_, pool));
+        decode_matrix(plain, values.get(), pool);
+
+        // Pack the slots into the destination
+        destination.assign(bits_uint64_count(), 0);
         for (size_t i = 0; i < slots_; i++)
         {
-            uint64_t curr_value = temp_dest[matrix_reps_index_map_[i]];
-            destination[i] = (curr_value > plain_modulus_div_two) ?
-                (static_cast<int64_t>(curr_value) - static_cast<int64_t>(modulus)) : 
-                static_cast<int64_t>(curr_value);
+            if (values[i] > 1)
+            {
+                throw invalid_argument("plain is not a matrix of bits");
+            }
+            destination[i / bits_per_uint64] |= values[i] << (i % bits_per_uint64);
         }
     }
+
 #ifdef SEAL_USE_MSGSL_SPAN
     void BatchEncoder::decode(const Plaintext &plain, gsl::span<uint64_t> destination,
         MemoryPoolHandle pool)
@@ -98,6 +98,46 @@ namespace seal
         @throws std::invalid_argument if values is too large
         */
         void encode(const std::vector<std::int64_t> &values, Plaintext &destination);
+
+        /**
+        Creates a plaintext from a given matrix stored in contiguous memory, e.g.,
+        memory owned by a caller in another language. This function "batches"
+        the count integers modulo the plaintext modulus pointed to by values into
+        a plaintext element, and stores the result in the destination parameter,
+        exactly as the encode overload taking an std::vector does, but without
+        copying the values first. The count must be at most equal to the degree
+        of the polynomial modulus.
+
+        If the destination plaintext overlaps the input values in memory, the behavior of
+        this function is undefined.
+
+        @param[in] values A pointer to the matrix of integers modulo plaintext modulus to batch
+        @param[in] count The number of integers in the matrix
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is null and count is not zero
+        @throws std::invalid_argument if count is too large
+        */
+        void encode(const std::uint64_t *values, std::size_t count, Plaintext &destination);
+
+        /**
+        Creates a plaintext from a given matrix stored in contiguous memory, e.g.,
+        memory owned by a caller in another language. This function "batches"
+        the count integers modulo the plaintext modulus pointed to by values into
+        a plaintext element, and stores the result in the destination parameter,
+        exactly as the encode overload taking an std::vector does, but without
+        copying the values first. The count must be at most equal to the degree
+        of the polynomial modulus.
+
+        If the destination plaintext overlaps the input values in memory, the behavior of
+        this function is undefined.
+
+        @param[in] values A pointer to the matrix of integers modulo plaintext modulus to batch
+        @param[in] count The number of integers in the matrix
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is null and count is not zero
+        @throws std::invalid_argument if count is too large
+        */
+        void encode(const std::int64_t *values, std::size_t count, Plaintext &destination);
 #ifdef SEAL_USE_MSGSL_SPAN
         /**
         Creates a plaintext from a given matrix. This function "batches" a given matrix
@@ -238,6 +278,50 @@ namespace seal
         */
         void decode(const Plaintext &plain, std::vector<std::int64_t> &destination,
             MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Inverse of encode. This function "unbatches" a given plaintext into a matrix
+        of integers modulo the plaintext modulus, and writes the result to contiguous
+        memory of slot_count() integers pointed to by the destination parameter, e.g.,
+        memory owned by a caller in another language. The input plaintext must have
+        degress less than the polynomial modulus, and coefficients less than the
+        plaintext modulus, i.e. it must be a valid plaintext for the encryption
+        parameters. Dynamic memory allocations in the process are allocated from
+        the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] plain The plaintext polynomial to unbatch
+        @param[out] destination A pointer to the matrix to be overwritten with the
+        values in the slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        @throws std::invalid_argument if destination is null
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode(const Plaintext &plain, std::uint64_t *destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Inverse of encode. This function "unbatches" a given plaintext into a matrix
+        of integers modulo the plaintext modulus, and writes the result to contiguous
+        memory of slot_count() integers pointed to by the destination parameter, e.g.,
+        memory owned by a caller in another language. The input plaintext must have
+        degress less than the polynomial modulus, and coefficients less than the
+        plaintext modulus, i.e. it must be a valid plaintext for the encryption
+        parameters. Dynamic memory allocations in the process are allocated from
+        the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] plain The plaintext polynomial to unbatch
+        @param[out] destination A pointer to the matrix to be overwritten with the
+        values in the slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        @throws std::invalid_argument if destination is null
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode(const Plaintext &plain, std::int64_t *destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
 #ifdef SEAL_USE_MSGSL_SPAN
         /**
         Inverse of encode. This function "unbatches" a given plaintext into a matrix
@@ -350,6 +434,186 @@ namespace seal
         */
         void decode(Plaintext &plain, MemoryPoolHandle pool = MemoryManager::GetPool());
 
+        /**
+        Decodes only the given slots of a plaintext, and stores their values in the
+        destination parameter in the same order. Slot indices are those of the
+        vectors returned by decode, i.e., i for the i-th slot of the top row and
+        N/2 + i for the i-th slot of the bottom row. A slot is the value of the
+        plaintext polynomial at one root of unity, so a few slots are computed
+        directly with N multiplications each instead of a full NTT. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to
+        by the given MemoryPoolHandle.
+
+        @param[in] plain The plaintext polynomial to unbatch
+        @param[in] slots The indices of the slots to decode
+        @param[out] destination The vector to be overwritten with the values in the slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        @throws std::invalid_argument if a slot index is out of range
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_slots(const Plaintext &plain, const std::vector<std::size_t> &slots,
+            std::vector<std::uint64_t> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Decodes only the given slots of a plaintext as signed integers, and stores
+        their values in the destination parameter in the same order. Slot indices
+        are those of the vectors returned by decode, i.e., i for the i-th slot of
+        the top row and N/2 + i for the i-th slot of the bottom row. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to
+        by the given MemoryPoolHandle.
+
+        @param[in] plain The plaintext polynomial to unbatch
+        @param[in] slots The indices of the slots to decode
+        @param[out] destination The vector to be overwritten with the values in the slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        @throws std::invalid_argument if a slot index is out of range
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_slots(const Plaintext &plain, const std::vector<std::size_t> &slots,
+            std::vector<std::int64_t> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Creates plaintexts from a sequence of matrices stored contiguously, as
+        encode does for each matrix separately. The input vector must have size
+        a multiple of the degree of the polynomial modulus N, so that each block
+        of N consecutive values is one matrix, and the destination vector is
+        resized to the number of matrices. The matrices are encoded in parallel
+        using the number of threads set with set_thread_count.
+
+        @param[in] values_matrices The matrices of integers modulo plaintext modulus to batch
+        @param[out] destinations The plaintext polynomials to overwrite with the results
+        @throws std::invalid_argument if the size of values_matrices is not a multiple
+        of slot_count()
+        */
+        void encode_many(const std::vector<std::uint64_t> &values_matrices,
+            std::vector<Plaintext> &destinations);
+
+        /**
+        Creates plaintexts from a sequence of matrices of signed integers stored
+        contiguously, as encode does for each matrix separately. The input vector
+        must have size a multiple of the degree of the polynomial modulus N, so
+        that each block of N consecutive values is one matrix, and the destination
+        vector is resized to the number of matrices. The matrices are encoded in
+        parallel using the number of threads set with set_thread_count.
+
+        @param[in] values_matrices The matrices of integers modulo plaintext modulus to batch
+        @param[out] destinations The plaintext polynomials to overwrite with the results
+        @throws std::invalid_argument if the size of values_matrices is not a multiple
+        of slot_count()
+        */
+        void encode_many(const std::vector<std::int64_t> &values_matrices,
+            std::vector<Plaintext> &destinations);
+
+        /**
+        Inverse of encode_many. This function "unbatches" a vector of plaintexts
+        into matrices stored contiguously in the destination parameter, so that
+        the i-th block of N values is the matrix of the i-th plaintext, where N
+        denotes the degree of the polynomial modulus. The plaintexts are decoded
+        in parallel using the number of threads set with set_thread_count. Dynamic
+        memory allocations in the process are allocated from the memory pool
+        pointed to by the given MemoryPoolHandle.
+
+        @param[in] plains The plaintext polynomials to unbatch
+        @param[out] destination The matrices to be overwritten with the values in the slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if any of plains is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if any of plains is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_many(const std::vector<Plaintext> &plains,
+            std::vector<std::uint64_t> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Inverse of encode_many. This function "unbatches" a vector of plaintexts
+        into matrices of signed integers stored contiguously in the destination
+        parameter, so that the i-th block of N values is the matrix of the i-th
+        plaintext, where N denotes the degree of the polynomial modulus. The
+        plaintexts are decoded in parallel using the number of threads set with
+        set_thread_count. Dynamic memory allocations in the process are allocated
+        from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] plains The plaintext polynomials to unbatch
+        @param[out] destination The matrices to be overwritten with the values in the slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if any of plains is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if any of plains is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_many(const std::vector<Plaintext> &plains,
+            std::vector<std::int64_t> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Creates a plaintext from a matrix of bits, such as a one-hot encoded
+        sequence, packed into 64-bit words so that slot i is bit i % 64 of word
+        i / 64. This compact form takes 64 times less memory than a plaintext,
+        and slots past the end of the input are zero. A matrix of all zeros or
+        all ones is encoded directly as a constant plaintext, for which the
+        Evaluator skips most of the work of add_plain, sub_plain, and
+        multiply_plain.
+
+        @param[in] bits The packed matrix of bits to batch
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if bits has more than bits_uint64_count() words
+        */
+        void encode_bits(const std::vector<std::uint64_t> &bits, Plaintext &destination);
+
+        /**
+        Inverse of encode_bits. This function "unbatches" a plaintext whose slots
+        are all 0 or 1, e.g., the result of an encrypted comparison, into a matrix
+        of bits packed into bits_uint64_count() 64-bit words. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to
+        by the given MemoryPoolHandle.
+
+        @param[in] plain The plaintext polynomial to unbatch
+        @param[out] destination The packed matrix of bits to overwrite
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        @throws std::invalid_argument if a slot of plain is neither 0 nor 1
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_bits(const Plaintext &plain, std::vector<std::uint64_t> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Returns the number of 64-bit words in a packed matrix of bits.
+        */
+        inline std::size_t bits_uint64_count() const noexcept
+        {
+            return util::divide_round_up(slots_,
+                static_cast<std::size_t>(util::bits_per_uint64));
+        }
+
+        /**
+        Sets the number of threads used by encode_many and decode_many. A value
+        of zero means to use as many threads as the hardware supports. The default
+        is one.
+
+        @param[in] thread_count The number of threads to use
+        */
+        inline void set_thread_count(std::size_t thread_count) noexcept
+        {
+            thread_count_ = thread_count;
+        }
+
+        /**
+        Returns the number of threads used by encode_many and decode_many.
+        */
+        inline std::size_t thread_count() const noexcept
+        {
+            return thread_count_;
+        }
+
         /**
         Returns the number of slots.
         */
@@ -372,6 +636,19 @@ namespace seal
 
         void populate_matrix_reps_index_map();
 
+        // Encodes one full matrix of values reduced modulo the plain modulus, or
+        // of the two's complement representations of signed values if is_signed
+        void encode_matrix(const std::uint64_t *values, bool is_signed,
+            std::uint64_t *destination) const;
+
+        // Decodes a valid plaintext into one full matrix
+        void decode_matrix(const Plaintext &plain, std::uint64_t *destination,
+            MemoryPoolHandle pool) const;
+
+        // Decodes a valid plaintext into one full matrix of centered values
+        void decode_matrix(const Plaintext &plain, std::int64_t *destination,
+            MemoryPoolHandle pool) const;
+
         inline void reverse_bits(std::uint64_t *input)
         {
 #ifdef SEAL_DEBUG
@@ -401,5 +678,10 @@ namespace seal
         util::Pointer<std::uint64_t> roots_of_unity_;
 
         util::Pointer<std::uint64_t> matrix_reps_index_map_;
+
+        // Slot index of each coefficient, so that encoding is a gather too
+        util::Pointer<std::uint64_t> matrix_reps_inverse_map_;
+
+        std::size_t thread_count_ = 1;
     };
 }
@@ -9,6 +9,13 @@ using namespace seal::util;
 
 namespace seal
 {
+    namespace
+    {
+        // Bits of the byte saved after the parms_id
+        constexpr int ntt_form_flag = 0x1;
+        constexpr int noise_budget_flag = 0x2;
+    }
+
     Ciphertext &Ciphertext::operator =(const Ciphertext &assign)
     {
         // Check for self-assignment
@@ -21,6 +28,7 @@ namespace seal
         parms_id_ = assign.parms_id_;
         is_ntt_form_ = assign.is_ntt_form_;
         scale_ = assign.scale_;
+        noise_budget_ = assign.noise_budget_;
 
         // Then resize
         resize_internal(assign.size_, assign.poly_modulus_degree_, 
@@ -204,8 +212,13 @@ namespace seal
             stream.exceptions(ios_base::badbit | ios_base::failbit);
 
             stream.write(reinterpret_cast<const char*>(&parms_id_), sizeof(parms_id_type));
-            SEAL_BYTE is_ntt_form_byte = static_cast<SEAL_BYTE>(is_ntt_form_);
-            stream.write(reinterpret_cast<const char*>(&is_ntt_form_byte), sizeof(SEAL_BYTE));
+            // Earlier versions wrote only 0 or 1 here; a second bit marks that
+            // the noise budget estimate follows the scale
+            bool save_noise_budget = (noise_budget_ != 0.0);
+            SEAL_BYTE flags_byte = static_cast<SEAL_BYTE>(
+                (is_ntt_form_ ? ntt_form_flag : 0) |
+                (save_noise_budget ? noise_budget_flag : 0));
+            stream.write(reinterpret_cast<const char*>(&flags_byte), sizeof(SEAL_BYTE));
             uint64_t size64 = safe_cast<uint64_t>(size_);
             stream.write(reinterpret_cast<const char*>(&size64), sizeof(uint64_t));
             uint64_t poly_modulus_degree64 = safe_cast<uint64_t>(poly_modulus_degree_);
@@ -213,6 +226,10 @@ namespace seal
             uint64_t coeff_mod_count64 = safe_cast<uint64_t>(coeff_mod_count_);
             stream.write(reinterpret_cast<const char*>(&coeff_mod_count64), sizeof(uint64_t));
             stream.write(reinterpret_cast<const char*>(&scale_), sizeof(double));
+            if (save_noise_budget)
+            {
+                stream.write(reinterpret_cast<const char*>(&noise_budget_), sizeof(double));
+            }
 
             // Save the data
             data_.save(stream);
@@ -236,8 +253,12 @@ namespace seal
 
             parms_id_type parms_id{};
             stream.read(reinterpret_cast<char*>(&parms_id), sizeof(parms_id_type));
-            SEAL_BYTE is_ntt_form_byte;
-            stream.read(reinterpret_cast<char*>(&is_ntt_form_byte), sizeof(SEAL_BYTE));
+            SEAL_BYTE flags_byte;
+            stream.read(reinterpret_cast<char*>(&flags_byte), sizeof(SEAL_BYTE));
+            if (static_cast<int>(flags_byte) & ~(ntt_form_flag | noise_budget_flag))
+            {
+                throw invalid_argument("ciphertext flags are invalid");
+            }
             uint64_t size64 = 0;
             stream.read(reinterpret_cast<char*>(&size64), sizeof(uint64_t));
             uint64_t poly_modulus_degree64 = 0;
@@ -246,6 +267,11 @@ namespace seal
             stream.read(reinterpret_cast<char*>(&coeff_mod_count64), sizeof(uint64_t));
             double scale = 0;
             stream.read(reinterpret_cast<char*>(&scale), sizeof(double));
+            double noise_budget = 0.0;
+            if (static_cast<int>(flags_byte) & noise_budget_flag)
+            {
+                stream.read(reinterpret_cast<char*>(&noise_budget), sizeof(double));
+            }
 
             // Load the data
             IntArray<ct_coeff_type> new_data(data_.pool());
@@ -258,11 +284,12 @@ namespace seal
 
             // Set values
             parms_id_ = parms_id;
-            is_ntt_form_ = (is_ntt_form_byte == SEAL_BYTE(0)) ? false : true;
+            is_ntt_form_ = (static_cast<int>(flags_byte) & ntt_form_flag) ? true : false;
             size_ = safe_cast<size_type>(size64);
             poly_modulus_degree_ = safe_cast<size_type>(poly_modulus_degree64);
             coeff_mod_count_ = safe_cast<size_type>(coeff_mod_count64);
             scale_ = scale;
+            noise_budget_ = noise_budget;
 
             // Set the data
             data_.swap_with(new_data);
@@ -291,6 +291,7 @@ namespace seal
             poly_modulus_degree_ = 0;
             coeff_mod_count_ = 0;
             scale_ = 1.0;
+            noise_budget_ = 0.0;
             data_.release();
         }
 
@@ -539,6 +540,9 @@ namespace seal
         /**
         Saves the ciphertext to an output stream. The output is in binary format
         and not human-readable. The output stream must have the "binary" flag set.
+        A nonzero noise budget estimate is saved as an optional field flagged in 
+        the byte that holds the NTT form, so ciphertexts saved without it (or by 
+        earlier versions) still load, with an estimate of zero.
 
         @param[in] stream The stream to save the ciphertext to
         @throws std::exception if the ciphertext could not be written to stream
@@ -633,6 +637,29 @@ namespace seal
             return scale_;
         }
 
+        /**
+        Returns a reference to the estimated invariant noise budget (in bits). 
+        This is only tracked when using the BFV encryption scheme: Encryptor sets 
+        it and every Evaluator operation updates it heuristically, so that it is 
+        available where the secret key is not. The estimate is usually a few bits 
+        below the value Decryptor::invariant_noise_budget reports; zero means 
+        that no budget can be relied on. The estimate is written by save and 
+        restored by load.
+        */
+        inline auto &noise_budget() noexcept
+        {
+            return noise_budget_;
+        }
+
+        /**
+        Returns a constant reference to the estimated invariant noise budget 
+        (in bits). This is only tracked when using the BFV encryption scheme.
+        */
+        inline auto &noise_budget() const noexcept
+        {
+            return noise_budget_;
+        }
+
         /**
         Returns the currently used MemoryPoolHandle.
         */
@@ -667,6 +694,8 @@ namespace seal
 
         double scale_ = 1.0;
 
+        double noise_budget_ = 0.0;
+
         IntArray<ct_coeff_type> data_;
     };
 }
@@ -7,18 +7,23 @@
 #include "seal/util/uintarith.h"
 #include "seal/util/uintarithsmallmod.h"
 #include "seal/util/numth.h"
+#include "seal/util/polyarithsmallmod.h"
 #include "seal/defaultparams.h"
 #include <utility>
 #include <stdexcept>
+#include <fstream>
+#include <cstdio>
+#include <random>
 
 using namespace std;
 using namespace seal::util;
 
 namespace seal
 {
-    SEALContext::ContextData SEALContext::validate(EncryptionParameters parms)
+    SEALContext::ContextData SEALContext::validate(EncryptionParameters parms,
+        MemoryPoolHandle pool, bool precompute, const ContextData *shared)
     {
-        ContextData context_data(parms, pool_);
+        ContextData context_data(parms, pool);
         context_data.qualifiers_.parameters_set = true;
 
         auto &coeff_modulus = parms.coeff_modulus();
@@ -56,8 +61,8 @@ namespace seal
         }
 
         // Compute the product of all coeff moduli
-        context_data.total_coeff_modulus_ = allocate_uint(coeff_mod_count, pool_);
-        auto temp(allocate_uint(coeff_mod_count, pool_));
+        context_data.total_coeff_modulus_ = allocate_uint(coeff_mod_count, pool);
+        auto temp(allocate_uint(coeff_mod_count, pool));
         set_uint(1, coeff_mod_count, context_data.total_coeff_modulus_.get());
         for (size_t i = 0; i < coeff_mod_count; i++)
         {
@@ -133,19 +138,51 @@ namespace seal
 #endif
         }
 
-        // Can we use NTT with coeff_modulus?
+        // Can we use NTT with coeff_modulus? When precompute is false the NTT
+        // tables, plain NTT tables, and BaseConverter are skipped: this is only
+        // done for lower levels of a lazily created chain, whose primes are a
+        // subset of those of the level above, so these cannot fail.
         context_data.qualifiers_.using_ntt = true;
-        context_data.small_ntt_tables_ = 
-            allocate<SmallNTTTables>(coeff_mod_count, pool_, pool_);
-        for (size_t i = 0; i < coeff_mod_count; i++)
+
+        // Finds NTT tables for the given modulus in the shared ContextData; the
+        // tables are immutable so levels with common primes can share them
+        auto find_shared_tables = [&](const SmallModulus &modulus) {
+            const SmallNTTTables *tables = nullptr;
+            if (shared && shared->small_ntt_tables_)
+            {
+                size_t shared_mod_count = shared->parms_.coeff_modulus().size();
+                for (size_t i = 0; i < shared_mod_count && !tables; i++)
+                {
+                    auto &shared_tables = shared->small_ntt_tables_[i];
+                    if (shared_tables.coeff_count_power() == coeff_count_power &&
+                        shared_tables.modulus() == modulus)
+                    {
+                        tables = &shared_tables;
+                    }
+                }
+            }
+            return tables;
+        };
+
+        if (precompute)
         {
-            if (!context_data.small_ntt_tables_[i].generate(coeff_count_power, 
-                coeff_modulus[i]))
+            context_data.small_ntt_tables_ = 
+                allocate<SmallNTTTables>(coeff_mod_count, pool, pool);
+            for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                // Parameters are not valid
-                context_data.qualifiers_.using_ntt = false;
-                context_data.qualifiers_.parameters_set = false;
-                return context_data;
+                auto shared_tables = find_shared_tables(coeff_modulus[i]);
+                if (shared_tables)
+                {
+                    context_data.small_ntt_tables_[i] = *shared_tables;
+                }
+                else if (!context_data.small_ntt_tables_[i].generate(coeff_count_power, 
+                    coeff_modulus[i]))
+                {
+                    // Parameters are not valid
+                    context_data.qualifiers_.using_ntt = false;
+                    context_data.qualifiers_.parameters_set = false;
+                    return context_data;
+                }
             }
         }
 
@@ -180,10 +217,23 @@ namespace seal
 
             // Can we use batching? (NTT with plain_modulus)
             context_data.qualifiers_.using_batching = false;
-            context_data.plain_ntt_tables_ = allocate<SmallNTTTables>(pool_);
-            if (context_data.plain_ntt_tables_->generate(coeff_count_power, plain_modulus))
+            if (precompute)
             {
-                context_data.qualifiers_.using_batching = true;
+                context_data.plain_ntt_tables_ = allocate<SmallNTTTables>(pool);
+                if (shared && shared->plain_ntt_tables_ &&
+                    shared->parms_.plain_modulus() == plain_modulus &&
+                    shared->parms_.poly_modulus_degree() == poly_modulus_degree)
+                {
+                    // The plain modulus is the same at all levels
+                    *context_data.plain_ntt_tables_ = *shared->plain_ntt_tables_;
+                }
+                else
+                {
+                    context_data.plain_ntt_tables_->generate(coeff_count_power, 
+                        plain_modulus);
+                }
+                context_data.qualifiers_.using_batching = 
+                    context_data.plain_ntt_tables_->is_generated();
             }
 
             // Check for plain_lift 
@@ -198,20 +248,20 @@ namespace seal
 
             // Calculate coeff_div_plain_modulus (BFV-"Delta") and the remainder 
             // upper_half_increment
-            context_data.coeff_div_plain_modulus_ = allocate_uint(coeff_mod_count, pool_);
-            context_data.upper_half_increment_ = allocate_uint(coeff_mod_count, pool_);
+            context_data.coeff_div_plain_modulus_ = allocate_uint(coeff_mod_count, pool);
+            context_data.upper_half_increment_ = allocate_uint(coeff_mod_count, pool);
             auto wide_plain_modulus(duplicate_uint_if_needed(plain_modulus.data(),
-                plain_modulus.uint64_count(), coeff_mod_count, false, pool_));
+                plain_modulus.uint64_count(), coeff_mod_count, false, pool));
             divide_uint_uint(context_data.total_coeff_modulus_.get(),
                 wide_plain_modulus.get(), coeff_mod_count,
                 context_data.coeff_div_plain_modulus_.get(),
-                context_data.upper_half_increment_.get(), pool_);
+                context_data.upper_half_increment_.get(), pool);
 
             // Decompose coeff_div_plain_modulus into RNS factors
             for (size_t i = 0; i < coeff_mod_count; i++)
             {
                 temp[i] = modulo_uint(context_data.coeff_div_plain_modulus_.get(),
-                    coeff_mod_count, coeff_modulus[i], pool_);
+                    coeff_mod_count, coeff_modulus[i], pool);
             }
             set_uint_uint(temp.get(), coeff_mod_count,
                 context_data.coeff_div_plain_modulus_.get());
@@ -220,7 +270,7 @@ namespace seal
             for (size_t i = 0; i < coeff_mod_count; i++)
             {
                 temp[i] = modulo_uint(context_data.upper_half_increment_.get(),
-                    coeff_mod_count, coeff_modulus[i], pool_);
+                    coeff_mod_count, coeff_modulus[i], pool);
             }
             set_uint_uint(temp.get(), coeff_mod_count,
                 context_data.upper_half_increment_.get());
@@ -230,7 +280,7 @@ namespace seal
 
             // Calculate coeff_modulus - plain_modulus.
             context_data.plain_upper_half_increment_ =
-                allocate_uint(coeff_mod_count, pool_);
+                allocate_uint(coeff_mod_count, pool);
             if (context_data.qualifiers_.using_fast_plain_lift)
             {
                 // Calculate coeff_modulus[i] - plain_modulus if using_fast_plain_lift
@@ -268,7 +318,7 @@ namespace seal
             context_data.plain_upper_half_threshold_ = uint64_t(1) << 63;
 
             // Calculate plain_upper_half_increment = 2^64 mod coeff_modulus for CKKS plaintexts
-            context_data.plain_upper_half_increment_ = allocate_uint(coeff_mod_count, pool_);
+            context_data.plain_upper_half_increment_ = allocate_uint(coeff_mod_count, pool);
             for (size_t i = 0; i < coeff_mod_count; i++)
             {
                 uint64_t tmp = (uint64_t(1) << 63) % coeff_modulus[i].value();
@@ -280,7 +330,7 @@ namespace seal
 
             // Compute the upper_half_threshold for this modulus.
             context_data.upper_half_threshold_ = allocate_uint(
-                coeff_mod_count, pool_);
+                coeff_mod_count, pool);
             increment_uint(context_data.total_coeff_modulus(), 
                 coeff_mod_count, context_data.upper_half_threshold_.get());
             right_shift_uint(context_data.upper_half_threshold_.get(), 1,
@@ -292,14 +342,17 @@ namespace seal
         }
 
         // Create BaseConverter
-        context_data.base_converter_ = allocate<BaseConverter>(pool_, pool_);
-        context_data.base_converter_->generate(coeff_modulus, poly_modulus_degree,
-            plain_modulus);
-        if (!context_data.base_converter_->is_generated())
+        if (precompute)
         {
-            // Parameters are not valid
-            context_data.qualifiers_.parameters_set = false;
-            return context_data;
+            context_data.base_converter_ = allocate<BaseConverter>(pool, pool);
+            context_data.base_converter_->generate(coeff_modulus, poly_modulus_degree,
+                plain_modulus, shared ? shared->base_converter_.get() : nullptr);
+            if (!context_data.base_converter_->is_generated())
+            {
+                // Parameters are not valid
+                context_data.qualifiers_.parameters_set = false;
+                return context_data;
+            }
         }
 
         // Done with validation and pre-computations
@@ -307,7 +360,7 @@ namespace seal
     }
 
     SEALContext::SEALContext(EncryptionParameters parms, bool expand_mod_chain,
-        MemoryPoolHandle pool) : pool_(move(pool))
+        bool lazy, MemoryPoolHandle pool) : pool_(move(pool))
     {
         if (!pool_)
         {
@@ -324,7 +377,7 @@ namespace seal
         // Validate parameters and add new ContextData to the map 
         // Note that this happens even if parameters are not valid
         context_data_map_.emplace(make_pair(parms.parms_id(), 
-            make_shared<const ContextData>(validate(parms))));
+            make_shared<const ContextData>(validate(parms, pool_))));
 
         first_parms_id_ = parms.parms_id();
         last_parms_id_ = first_parms_id_;
@@ -335,17 +388,21 @@ namespace seal
             context_data_map_.at(first_parms_id_)->qualifiers_.parameters_set)
         {
             auto prev_parms_id = first_parms_id_;
-            while (context_data_map_.at(prev_parms_id)->parms().coeff_modulus().size() > 1)
+            auto prev_parms = parms;
+            shared_ptr<LazyContextData> prev_lazy_context_data;
+            while (prev_parms.coeff_modulus().size() > 1)
             {
                 // Create the next set of parameters by removing last modulus
-                auto next_parms = context_data_map_.at(prev_parms_id)->parms_;
+                auto next_parms = prev_parms;
                 auto next_coeff_modulus = next_parms.coeff_modulus();
                 next_coeff_modulus.pop_back();
                 next_parms.set_coeff_modulus(next_coeff_modulus);
                 auto next_parms_id = next_parms.parms_id();
 
-                // Validate next parameters
-                auto next_context_data = validate(next_parms);
+                // Validate next parameters; in lazy mode only the checks are done.
+                // The pre-computations are shared with the previous level.
+                auto next_context_data = validate(next_parms, pool_, !lazy,
+                    context_data_map_.at(prev_parms_id).get());
 
                 // If not valid then break
                 if (!next_context_data.qualifiers_.parameters_set)
@@ -353,6 +410,31 @@ namespace seal
                     break;
                 }
 
+                prev_parms = next_parms;
+                last_parms_id_ = next_parms_id;
+                if (lazy)
+                {
+                    // Defer the pre-computations and link the lazy levels
+                    auto next_lazy_context_data = make_shared<LazyContextData>(
+                        move(next_parms), pool_);
+                    next_lazy_context_data->shared_ = 
+                        context_data_map_.at(first_parms_id_);
+                    lazy_context_data_map_.emplace(make_pair(next_parms_id,
+                        next_lazy_context_data));
+                    if (prev_lazy_context_data)
+                    {
+                        prev_lazy_context_data->next_ = next_lazy_context_data;
+                    }
+                    else
+                    {
+                        const_pointer_cast<ContextData>(
+                            context_data_map_.at(first_parms_id_))->next_lazy_context_data_ = 
+                            next_lazy_context_data;
+                    }
+                    prev_lazy_context_data = move(next_lazy_context_data);
+                    continue;
+                }
+
                 // Add them to the context_data_map_
                 context_data_map_.emplace(make_pair(next_parms_id,
                     make_shared<const ContextData>(move(next_context_data))));
@@ -363,13 +445,18 @@ namespace seal
                     context_data_map_.at(prev_parms_id))->next_context_data_ = 
                     context_data_map_.at(next_parms_id);
                 prev_parms_id = next_parms_id;
-                last_parms_id_ = prev_parms_id;
             }
         }
 
+        set_chain_indices();
+    }
+
+    void SEALContext::set_chain_indices()
+    {
         // Set the chain_index for each context_data
-        size_t parms_count = context_data_map_.size();
+        size_t parms_count = context_data_map_.size() + lazy_context_data_map_.size();
         auto context_data_ptr = context_data_map_.at(first_parms_id_);
+        auto lazy_context_data_ptr = context_data_ptr->next_lazy_context_data_;
         while (context_data_ptr)
         {
             // We need to remove constness first to modify this
@@ -377,5 +464,419 @@ namespace seal
                 context_data_ptr)->chain_index_ = --parms_count;
             context_data_ptr = context_data_ptr->next_context_data_;
         }
+
+        // The lazy levels get their chain_index when they are created
+        while (lazy_context_data_ptr)
+        {
+            const_pointer_cast<LazyContextData>(
+                lazy_context_data_ptr)->chain_index_ = --parms_count;
+            lazy_context_data_ptr = lazy_context_data_ptr->next_;
+        }
+    }
+
+    shared_ptr<const SEALContext::ContextData> 
+        SEALContext::ContextData::next_context_data() const
+    {
+        return next_lazy_context_data_ ? 
+            next_lazy_context_data_->get() : next_context_data_;
+    }
+
+    const vector<uint32_t> &SEALContext::galois_ntt_permutation(
+        uint64_t galois_elt) const
+    {
+        size_t coeff_count = context_data()->parms().poly_modulus_degree();
+        if (!(galois_elt & 1) || galois_elt >= 2 * static_cast<uint64_t>(coeff_count))
+        {
+            throw invalid_argument("galois element is not valid");
+        }
+
+        {
+            auto lock = galois_tables_locker_.acquire_read();
+            auto table = galois_ntt_tables_.find(galois_elt);
+            if (table != galois_ntt_tables_.end())
+            {
+                return table->second;
+            }
+        }
+
+        // Compute the table outside of the lock; if another thread got here
+        // first, emplace keeps its table
+        vector<uint32_t> new_table(coeff_count);
+        util::galois_ntt_permutation(get_power_of_two(coeff_count), galois_elt,
+            new_table.data());
+        auto lock = galois_tables_locker_.acquire_write();
+        return galois_ntt_tables_.emplace(galois_elt, move(new_table)).first->second;
+    }
+
+    const vector<uint32_t> &SEALContext::galois_permutation(
+        uint64_t galois_elt) const
+    {
+        size_t coeff_count = context_data()->parms().poly_modulus_degree();
+        if (!(galois_elt & 1) || galois_elt >= 2 * static_cast<uint64_t>(coeff_count))
+        {
+            throw invalid_argument("galois element is not valid");
+        }
+
+        {
+            auto lock = galois_tables_locker_.acquire_read();
+            auto table = galois_tables_.find(galois_elt);
+            if (table != galois_tables_.end())
+            {
+                return table->second;
+            }
+        }
+
+        // Compute the table outside of the lock; if another thread got here
+        // first, emplace keeps its table
+        vector<uint32_t> new_table(coeff_count);
+        util::galois_permutation(get_power_of_two(coeff_count), galois_elt,
+            new_table.data());
+        auto lock = galois_tables_locker_.acquire_write();
+        return galois_tables_.emplace(galois_elt, move(new_table)).first->second;
+    }
+
+    shared_ptr<const SEALContext::ContextData> SEALContext::lazy_context_data(
+        parms_id_type parms_id) const
+    {
+        auto data = lazy_context_data_map_.find(parms_id);
+        return (data != lazy_context_data_map_.end()) ?
+            data->second->get() : shared_ptr<const ContextData>{ nullptr };
+    }
+
+    shared_ptr<const SEALContext::ContextData> 
+        SEALContext::LazyContextData::get() const
+    {
+        // Fast path: the ContextData has already been published
+        auto context_data = atomic_load(&context_data_);
+        if (context_data)
+        {
+            return context_data;
+        }
+
+        lock_guard<mutex> lock(mutex_);
+        context_data = atomic_load(&context_data_);
+        if (!context_data)
+        {
+            auto shared = shared_.lock();
+            auto new_context_data = validate(parms_, pool_, true, shared.get());
+            if (!new_context_data.qualifiers_.parameters_set)
+            {
+                throw logic_error("lazily created parameters are not valid");
+            }
+            new_context_data.chain_index_ = chain_index_;
+            new_context_data.next_lazy_context_data_ = next_;
+            context_data = make_shared<const ContextData>(move(new_context_data));
+            atomic_store(&context_data_, context_data);
+        }
+        return context_data;
+    }
+
+    SEALContext::SEALContext(EncryptionParameters parms, istream &stream,
+        MemoryPoolHandle pool) : pool_(move(pool))
+    {
+        if (!pool_)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Set random generator
+        if (!parms.random_generator())
+        {
+            parms.set_random_generator(
+                UniformRandomGeneratorFactory::default_factory());
+        }
+
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            uint64_t format_id = 0;
+            stream.read(reinterpret_cast<char*>(&format_id), sizeof(uint64_t));
+            if (format_id != save_format_id_)
+            {
+                throw invalid_argument("stream does not contain a saved SEALContext");
+            }
+
+            // The saved chain must start from the given parameters
+            parms_id_type first_parms_id;
+            stream.read(reinterpret_cast<char*>(first_parms_id.data()), 
+                sizeof(parms_id_type));
+            if (first_parms_id != parms.parms_id())
+            {
+                throw invalid_argument("saved SEALContext does not match parms");
+            }
+
+            uint64_t parms_count64 = 0;
+            stream.read(reinterpret_cast<char*>(&parms_count64), sizeof(uint64_t));
+            if (parms_count64 < 1 || parms_count64 > parms.coeff_modulus().size())
+            {
+                throw invalid_argument("invalid parameter chain length");
+            }
+
+            // Load each set of parameters in the chain; they are obtained from
+            // the previous ones by removing the last modulus like above
+            first_parms_id_ = parms.parms_id();
+            last_parms_id_ = first_parms_id_;
+            context_data_map_.emplace(make_pair(first_parms_id_,
+                make_shared<const ContextData>(load_context_data(parms, stream))));
+            for (uint64_t i = 1; i < parms_count64; i++)
+            {
+                auto next_parms = context_data_map_.at(last_parms_id_)->parms_;
+                auto next_coeff_modulus = next_parms.coeff_modulus();
+                next_coeff_modulus.pop_back();
+                next_parms.set_coeff_modulus(next_coeff_modulus);
+                auto next_parms_id = next_parms.parms_id();
+
+                context_data_map_.emplace(make_pair(next_parms_id,
+                    make_shared<const ContextData>(
+                        load_context_data(move(next_parms), stream))));
+                const_pointer_cast<ContextData>(
+                    context_data_map_.at(last_parms_id_))->next_context_data_ = 
+                    context_data_map_.at(next_parms_id);
+                last_parms_id_ = next_parms_id;
+            }
+        }
+        catch (const exception &)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+        stream.exceptions(old_except_mask);
+
+        set_chain_indices();
+    }
+
+    void SEALContext::save_context_data(const ContextData &context_data, 
+        ostream &stream) const
+    {
+        auto &parms = context_data.parms_;
+        size_t coeff_mod_count = parms.coeff_modulus().size();
+        auto write_uint = [&](const uint64_t *data, size_t count) {
+            stream.write(reinterpret_cast<const char*>(data),
+                static_cast<streamsize>(count * bytes_per_uint64));
+        };
+
+        write_uint(parms.parms_id().data(), parms.parms_id().size());
+
+        auto &qualifiers = context_data.qualifiers_;
+        uint64_t qualifier_values[6]{ 
+            static_cast<uint64_t>(qualifiers.parameters_set),
+            static_cast<uint64_t>(qualifiers.using_fft),
+            static_cast<uint64_t>(qualifiers.using_ntt),
+            static_cast<uint64_t>(qualifiers.using_batching),
+            static_cast<uint64_t>(qualifiers.using_fast_plain_lift),
+            static_cast<uint64_t>(qualifiers.using_he_std_security) };
+        write_uint(qualifier_values, 6);
+
+        uint64_t total_coeff_modulus_bit_count64 = 
+            static_cast<uint64_t>(context_data.total_coeff_modulus_bit_count_);
+        write_uint(&total_coeff_modulus_bit_count64, 1);
+        write_uint(context_data.total_coeff_modulus_.get(), coeff_mod_count);
+        write_uint(&context_data.plain_upper_half_threshold_, 1);
+        write_uint(context_data.plain_upper_half_increment_.get(), coeff_mod_count);
+        for (size_t i = 0; i < coeff_mod_count; i++)
+        {
+            context_data.small_ntt_tables_[i].save(stream);
+        }
+        if (parms.scheme() == scheme_type::BFV)
+        {
+            write_uint(context_data.coeff_div_plain_modulus_.get(), coeff_mod_count);
+            write_uint(context_data.upper_half_increment_.get(), coeff_mod_count);
+            context_data.plain_ntt_tables_->save(stream);
+        }
+        else
+        {
+            write_uint(context_data.upper_half_threshold_.get(), coeff_mod_count);
+        }
+        context_data.base_converter_->save(stream);
+    }
+
+    SEALContext::ContextData SEALContext::load_context_data(
+        EncryptionParameters parms, istream &stream)
+    {
+        ContextData context_data(parms, pool_);
+        size_t coeff_mod_count = parms.coeff_modulus().size();
+        size_t poly_modulus_degree = parms.poly_modulus_degree();
+        auto read_uint = [&](uint64_t *data, size_t count) {
+            stream.read(reinterpret_cast<char*>(data),
+                static_cast<streamsize>(count * bytes_per_uint64));
+        };
+        auto load_uint = [&](size_t count) {
+            auto data(allocate_uint(count, pool_));
+            read_uint(data.get(), count);
+            return data;
+        };
+        auto check_ntt_tables = [&](const SmallNTTTables &tables, 
+            const SmallModulus &modulus) {
+            if (!tables.is_generated() || tables.modulus() != modulus ||
+                tables.coeff_count() != poly_modulus_degree)
+            {
+                throw invalid_argument("invalid NTT tables");
+            }
+        };
+
+        parms_id_type parms_id;
+        read_uint(parms_id.data(), parms_id.size());
+        if (parms_id != parms.parms_id())
+        {
+            throw invalid_argument("saved SEALContext does not match parms");
+        }
+
+        uint64_t qualifier_values[6]{ 0, 0, 0, 0, 0, 0 };
+        read_uint(qualifier_values, 6);
+        auto &qualifiers = context_data.qualifiers_;
+        qualifiers.parameters_set = !!qualifier_values[0];
+        qualifiers.using_fft = !!qualifier_values[1];
+        qualifiers.using_ntt = !!qualifier_values[2];
+        qualifiers.using_batching = !!qualifier_values[3];
+        qualifiers.using_fast_plain_lift = !!qualifier_values[4];
+        qualifiers.using_he_std_security = !!qualifier_values[5];
+        if (!qualifiers.parameters_set)
+        {
+            throw invalid_argument("saved parameters are not valid");
+        }
+
+        uint64_t total_coeff_modulus_bit_count64 = 0;
+        read_uint(&total_coeff_modulus_bit_count64, 1);
+        context_data.total_coeff_modulus_bit_count_ = 
+            safe_cast<int>(total_coeff_modulus_bit_count64);
+        context_data.total_coeff_modulus_ = load_uint(coeff_mod_count);
+        read_uint(&context_data.plain_upper_half_threshold_, 1);
+        context_data.plain_upper_half_increment_ = load_uint(coeff_mod_count);
+        context_data.small_ntt_tables_ = 
+            allocate<SmallNTTTables>(coeff_mod_count, pool_, pool_);
+        for (size_t i = 0; i < coeff_mod_count; i++)
+        {
+            context_data.small_ntt_tables_[i].load(stream);
+            check_ntt_tables(context_data.small_ntt_tables_[i], 
+                parms.coeff_modulus()[i]);
+        }
+        if (parms.scheme() == scheme_type::BFV)
+        {
+            context_data.coeff_div_plain_modulus_ = load_uint(coeff_mod_count);
+            context_data.upper_half_increment_ = load_uint(coeff_mod_count);
+            context_data.plain_ntt_tables_ = allocate<SmallNTTTables>(pool_);
+            context_data.plain_ntt_tables_->load(stream);
+            if (qualifiers.using_batching)
+            {
+                check_ntt_tables(*context_data.plain_ntt_tables_, 
+                    parms.plain_modulus());
+            }
+        }
+        else
+        {
+            context_data.upper_half_threshold_ = load_uint(coeff_mod_count);
+        }
+        context_data.base_converter_ = allocate<BaseConverter>(pool_, pool_);
+        context_data.base_converter_->load(stream);
+        if (!context_data.base_converter_->is_generated() ||
+            context_data.base_converter_->coeff_base_mod_count() != coeff_mod_count)
+        {
+            throw invalid_argument("invalid base converter");
+        }
+
+        return context_data;
+    }
+
+    void SEALContext::save(ostream &stream) const
+    {
+        if (!parameters_set())
+        {
+            throw logic_error("encryption parameters are not set correctly");
+        }
+
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            uint64_t format_id = save_format_id_;
+            stream.write(reinterpret_cast<const char*>(&format_id), sizeof(uint64_t));
+            stream.write(reinterpret_cast<const char*>(first_parms_id_.data()), 
+                sizeof(parms_id_type));
+            uint64_t parms_count64 = static_cast<uint64_t>(
+                context_data_map_.size() + lazy_context_data_map_.size());
+            stream.write(reinterpret_cast<const char*>(&parms_count64), sizeof(uint64_t));
+
+            // Write the chain in order starting from the first parameters
+            auto context_data_ptr = context_data();
+            while (context_data_ptr)
+            {
+                save_context_data(*context_data_ptr, stream);
+                context_data_ptr = context_data_ptr->next_context_data();
+            }
+        }
+        catch (const exception &)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+
+        stream.exceptions(old_except_mask);
+    }
+
+    shared_ptr<SEALContext> SEALContext::Load(const EncryptionParameters &parms,
+        istream &stream)
+    {
+        return shared_ptr<SEALContext>(
+            new SEALContext(parms, stream, MemoryManager::GetPool()));
+    }
+
+    shared_ptr<SEALContext> SEALContext::Create(const EncryptionParameters &parms,
+        bool expand_mod_chain, const string &cache_path)
+    {
+        // Try the cache first; any problem with it just means we recompute
+        {
+            ifstream cache_stream(cache_path, ios::binary);
+            if (cache_stream.is_open())
+            {
+                try
+                {
+                    auto context = Load(parms, cache_stream);
+
+                    // A chain that was not expanded has only one set of parameters
+                    bool expanded = (context->first_parms_id_ != context->last_parms_id_);
+                    if (expanded == expand_mod_chain ||
+                        parms.coeff_modulus().size() == 1)
+                    {
+                        return context;
+                    }
+                }
+                catch (const exception &)
+                {
+                }
+            }
+        }
+
+        auto context = Create(parms, expand_mod_chain);
+        if (!context->parameters_set())
+        {
+            return context;
+        }
+
+        // Write to a temporary file first so that concurrent readers never see 
+        // a partially written cache
+        random_device rd;
+        string temp_path = cache_path + "." + to_string(rd()) + ".tmp";
+        try
+        {
+            {
+                ofstream cache_stream(temp_path, ios::binary | ios::trunc);
+                context->save(cache_stream);
+            }
+            if (rename(temp_path.c_str(), cache_path.c_str()))
+            {
+                remove(temp_path.c_str());
+            }
+        }
+        catch (const exception &)
+        {
+            // Failing to write the cache is not an error
+            remove(temp_path.c_str());
+        }
+        return context;
     }
 }
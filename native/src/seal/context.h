@@ -6,11 +6,16 @@
 #include <unordered_map>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <iostream>
+#include <string>
+#include <vector>
 #include "seal/encryptionparams.h"
 #include "seal/memorymanager.h"
 #include "seal/util/smallntt.h"
 #include "seal/util/baseconverter.h"
 #include "seal/util/pointer.h"
+#include "seal/util/locks.h"
 
 namespace seal
 {
@@ -122,6 +127,8 @@ namespace seal
     */
     class SEALContext
     {
+        class LazyContextData;
+
     public:
         class ContextData
         {
@@ -254,12 +261,11 @@ namespace seal
             /**
             Returns a shared_ptr to the context data corresponding to the next parameters
             in the modulus switching chain. If the current data is the last one in the
-            chain, then the result is nullptr.
+            chain, then the result is nullptr. For a lazily created SEALContext this
+            performs the pre-computations for the next parameters if they have not 
+            been done yet.
             */
-            inline auto next_context_data() const
-            {
-                return next_context_data_;
-            }
+            std::shared_ptr<const ContextData> next_context_data() const;
 
             /**
             Returns the index of the parameter set in a chain. The initial parameters
@@ -308,6 +314,9 @@ namespace seal
 
             std::shared_ptr<const ContextData> next_context_data_{ nullptr };
 
+            // Set instead of next_context_data_ when the next level is lazy
+            std::shared_ptr<const LazyContextData> next_lazy_context_data_{ nullptr };
+
             std::size_t chain_index_ = 0;
         };
 
@@ -325,10 +334,72 @@ namespace seal
             bool expand_mod_chain = true)
         {
             return std::shared_ptr<SEALContext>(
-                new SEALContext(parms, expand_mod_chain, 
+                new SEALContext(parms, expand_mod_chain, false,
                 MemoryManager::GetPool()));
         }
 
+        /**
+        Creates an instance of SEALContext with a lazily computed modulus switching 
+        chain. The pre-computations for the first set of encryption parameters are 
+        performed immediately, but those for each lower level of the chain (NTT 
+        tables, BaseConverter, etc.) are only performed the first time that level 
+        is accessed, e.g. when a ciphertext at its parms_id is first used. This is
+        safe to do concurrently from multiple threads: the pre-computations for 
+        each level happen once and are then shared. The resulting chain is the 
+        same as with Create(parms, true).
+
+        @param[in] parms The encryption parameters
+        */
+        static auto CreateLazy(const EncryptionParameters &parms)
+        {
+            return std::shared_ptr<SEALContext>(
+                new SEALContext(parms, true, true, MemoryManager::GetPool()));
+        }
+
+        /**
+        Creates an instance of SEALContext using a file cache of the pre-computations. 
+        If the file at cache_path holds a SEALContext saved for the same parms_id 
+        and modulus switching chain, the pre-computations are loaded from it. 
+        Otherwise the SEALContext is created as usual and, if the parameters are 
+        valid, saved to cache_path for the next process to use. The cache file is 
+        trusted: its tables are checked for consistency but not recomputed.
+
+        @param[in] parms The encryption parameters
+        @param[in] expand_mod_chain Determines whether the modulus switching chain 
+        should be created
+        @param[in] cache_path The path of the cache file
+        */
+        static std::shared_ptr<SEALContext> Create(const EncryptionParameters &parms,
+            bool expand_mod_chain, const std::string &cache_path);
+
+        /**
+        Saves the SEALContext to an output stream. All pre-computations for every 
+        set of parameters in the modulus switching chain are written, including 
+        the NTT tables and the base converter tables. The output is in binary 
+        format, consists only of 64-bit words, and is not human-readable. The 
+        output stream must have the "binary" flag set.
+
+        @param[in] stream The stream to save the SEALContext to
+        @throws std::logic_error if the encryption parameters are not valid
+        @throws std::exception if the SEALContext could not be written to stream
+        */
+        void save(std::ostream &stream) const;
+
+        /**
+        Loads a SEALContext previously written by save. The pre-computations are 
+        read from the stream instead of being recomputed. The given encryption 
+        parameters must have the same parms_id as the saved ones; they provide 
+        the random number generator, which is not saved.
+
+        @param[in] parms The encryption parameters
+        @param[in] stream The stream to load the SEALContext from
+        @throws std::invalid_argument if the saved SEALContext does not match parms
+        or is otherwise invalid
+        @throws std::exception if a valid SEALContext could not be read from stream
+        */
+        static std::shared_ptr<SEALContext> Load(const EncryptionParameters &parms,
+            std::istream &stream);
+
         /**
         Returns a const reference to ContextData class corresponding to the
         encryption parameters. This is the first set of parameters in a chain
@@ -346,11 +417,12 @@ namespace seal
 
         @param[in] parms_id The parms_id of the encryption parameters
         */
-        inline auto context_data(parms_id_type parms_id) const
+        inline std::shared_ptr<const ContextData> context_data(
+            parms_id_type parms_id) const
         {
             auto data = context_data_map_.find(parms_id);
             return (data != context_data_map_.end()) ?
-                data->second : std::shared_ptr<ContextData>{ nullptr };
+                data->second : lazy_context_data(parms_id);
         }
 
         /**
@@ -379,6 +451,32 @@ namespace seal
             return last_parms_id_;
         }
 
+        /**
+        Returns the permutation that the Galois automorphism given by galois_elt
+        induces on polynomials in NTT form, for use with util::apply_galois_ntt.
+        All levels of the modulus switching chain share the same table. Tables
+        are computed on first use and cached for the lifetime of the context.
+        This function is thread-safe.
+
+        @param[in] galois_elt The Galois element
+        @throws std::invalid_argument if galois_elt is not valid
+        */
+        const std::vector<std::uint32_t> &galois_ntt_permutation(
+            std::uint64_t galois_elt) const;
+
+        /**
+        Returns the permutation and signs that the Galois automorphism given by
+        galois_elt induces on polynomials in coefficient form, for use with
+        util::apply_galois. All levels of the modulus switching chain share the
+        same table. Tables are computed on first use and cached for the lifetime
+        of the context. This function is thread-safe.
+
+        @param[in] galois_elt The Galois element
+        @throws std::invalid_argument if galois_elt is not valid
+        */
+        const std::vector<std::uint32_t> &galois_permutation(
+            std::uint64_t galois_elt) const;
+
     private:
         SEALContext(const SEALContext &copy) = delete;
 
@@ -395,13 +493,84 @@ namespace seal
         @param[in] parms The encryption parameters
         @param[in] expand_mod_chain Determines whether the modulus switching chain 
         should be created
+        @param[in] lazy Determines whether the pre-computations for the lower levels
+        of the modulus switching chain are deferred until first use
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if pool is uninitialized
         */
         SEALContext(EncryptionParameters parms, bool expand_mod_chain,
+            bool lazy, MemoryPoolHandle pool);
+
+        /**
+        Creates an instance of SEALContext by loading the pre-computations 
+        written by save.
+
+        @param[in] parms The encryption parameters
+        @param[in] stream The stream to load the pre-computations from
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        SEALContext(EncryptionParameters parms, std::istream &stream,
             MemoryPoolHandle pool);
 
-        ContextData validate(EncryptionParameters parms);
+        /**
+        Validates the encryption parameters and performs the pre-computations.
+        NTT tables and Bsk tables for primes that also appear in shared are not
+        recomputed but shared with it.
+        */
+        static ContextData validate(EncryptionParameters parms, 
+            MemoryPoolHandle pool, bool precompute = true,
+            const ContextData *shared = nullptr);
+
+        void save_context_data(const ContextData &context_data, 
+            std::ostream &stream) const;
+
+        ContextData load_context_data(EncryptionParameters parms, 
+            std::istream &stream);
+
+        void set_chain_indices();
+
+        std::shared_ptr<const ContextData> lazy_context_data(
+            parms_id_type parms_id) const;
+
+        /**
+        Holds the parameters for a level of a lazily created modulus switching 
+        chain and publishes its ContextData once it has been computed.
+        */
+        class LazyContextData
+        {
+        public:
+            LazyContextData(EncryptionParameters parms, MemoryPoolHandle pool) :
+                parms_(std::move(parms)), pool_(std::move(pool))
+            {
+            }
+
+            /**
+            Returns the ContextData, performing the pre-computations on first call.
+            */
+            std::shared_ptr<const ContextData> get() const;
+
+            EncryptionParameters parms_;
+
+            MemoryPoolHandle pool_;
+
+            std::size_t chain_index_ = 0;
+
+            std::shared_ptr<const LazyContextData> next_{ nullptr };
+
+            // The first ContextData; held weakly as it owns this object
+            std::weak_ptr<const ContextData> shared_{};
+
+        private:
+            mutable std::mutex mutex_;
+
+            mutable std::shared_ptr<const ContextData> context_data_{ nullptr };
+        };
+
+        /**
+        Identifies the format written by save
+        */
+        static constexpr std::uint64_t save_format_id_ = 0x31585443'4C414553;
 
         MemoryPoolHandle pool_;
 
@@ -411,5 +580,21 @@ namespace seal
 
         std::unordered_map<
             parms_id_type, std::shared_ptr<const ContextData>> context_data_map_{};
+
+        // Levels of a lazily created chain; the map itself is never modified 
+        // after construction
+        std::unordered_map<
+            parms_id_type, std::shared_ptr<const LazyContextData>> 
+            lazy_context_data_map_{};
+
+        // Galois permutation tables; entries are never removed, so references
+        // to them remain valid
+        mutable util::ReaderWriterLocker galois_tables_locker_;
+
+        mutable std::unordered_map<std::uint64_t, std::vector<std::uint32_t>>
+            galois_ntt_tables_{};
+
+        mutable std::unordered_map<std::uint64_t, std::vector<std::uint32_t>>
+            galois_tables_{};
     };
 }
@@ -12,6 +12,7 @@
 #include "seal/util/polycore.h"
 #include "seal/util/polyarithmod.h"
 #include "seal/util/polyarithsmallmod.h"
+#include "seal/util/parallel.h"
 
 using namespace std;
 using namespace seal::util;
@@ -78,14 +79,39 @@ namespace seal
         }
     }
 
-    void Decryptor::bfv_decrypt(const Ciphertext &encrypted, 
-        Plaintext &destination, MemoryPoolHandle pool)
+    void Decryptor::decrypt_many(const vector<Ciphertext> &encrypteds,
+        vector<Plaintext> &destinations)
     {
-        if (encrypted.is_ntt_form())
+        // Verify that encrypteds are valid.
+        size_t max_size = 0;
+        for (auto &encrypted : encrypteds)
+        {
+            if (!encrypted.is_valid_for(context_))
+            {
+                throw invalid_argument("encrypteds is not valid for encryption parameters");
+            }
+            max_size = max(max_size, encrypted.size());
+        }
+
+        // Compute all secret key powers up front so that no thread extends the
+        // array while others read it
+        if (max_size > 1)
         {
-            throw invalid_argument("encrypted cannot be in NTT form");
+            compute_secret_key_array(max_size - 1);
         }
 
+        destinations.resize(encrypteds.size());
+        parallel_for(encrypteds.size(), thread_count_, [&](size_t i) {
+            decrypt(encrypteds[i], destinations[i]);
+        });
+    }
+
+    void Decryptor::bfv_decrypt(const Ciphertext &encrypted, 
+        Plaintext &destination, MemoryPoolHandle pool)
+    {
+        // A ciphertext kept in NTT form saves the forward transforms below
+        bool is_ntt_form = encrypted.is_ntt_form();
+
         auto &context_data = *context_->context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
         auto &coeff_modulus = parms.coeff_modulus();
@@ -136,13 +162,21 @@ namespace seal
             for (size_t j = 0; j < encrypted_size - 1; j++)
             {
                 // Perform the dyadic product.
-                set_uint_uint(current_array1, coeff_count, copy_operand1.get());
-
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables[i]);
-
-                dyadic_product_coeffmod(copy_operand1.get(), current_array2, coeff_count,
-                    coeff_modulus[i], copy_operand1.get());
+                if (is_ntt_form)
+                {
+                    dyadic_product_coeffmod(current_array1, current_array2, coeff_count,
+                        coeff_modulus[i], copy_operand1.get());
+                }
+                else
+                {
+                    set_uint_uint(current_array1, coeff_count, copy_operand1.get());
+
+                    // Lazy reduction
+                    ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables[i]);
+
+                    dyadic_product_coeffmod(copy_operand1.get(), current_array2,
+                        coeff_count, coeff_modulus[i], copy_operand1.get());
+                }
                 add_poly_poly_coeffmod(tmp_dest_modq.get() + (i * coeff_count),
                     copy_operand1.get(), coeff_count, coeff_modulus[i],
                     tmp_dest_modq.get() + (i * coeff_count));
@@ -151,6 +185,14 @@ namespace seal
                 current_array2 += first_rns_poly_uint64_count;
             }
 
+            // In NTT form c_0 is added before the inverse NTT
+            if (is_ntt_form)
+            {
+                add_poly_poly_coeffmod(tmp_dest_modq.get() + (i * coeff_count),
+                    encrypted.data() + (i * coeff_count), coeff_count, coeff_modulus[i],
+                    tmp_dest_modq.get() + (i * coeff_count));
+            }
+
             // Perform inverse NTT
             inverse_ntt_negacyclic_harvey(tmp_dest_modq.get() + (i * coeff_count),
                 small_ntt_tables[i]);
@@ -164,9 +206,12 @@ namespace seal
             //  tmp_dest_modq.get() + (i * coeff_count));
 
             // Lazy reduction
-            for (size_t j = 0; j < coeff_count; j++)
+            if (!is_ntt_form)
             {
-                tmp_dest_modq[j + (i * coeff_count)] += encrypted[j + (i * coeff_count)];
+                for (size_t j = 0; j < coeff_count; j++)
+                {
+                    tmp_dest_modq[j + (i * coeff_count)] += encrypted[j + (i * coeff_count)];
+                }
             }
 
             // Compute |gamma * plain|qi * ct(s)
@@ -385,59 +430,6 @@ namespace seal
         secret_key_array_.acquire(new_secret_key_array);
     }
 
-    void Decryptor::compose(
-        const SEALContext::ContextData &context_data, uint64_t *value)
-    {
-#ifdef SEAL_DEBUG
-        if (value == nullptr)
-        {
-            throw invalid_argument("input cannot be null");
-        }
-#endif
-        auto &parms = context_data.parms();
-        auto &coeff_modulus = parms.coeff_modulus();
-        size_t coeff_count = parms.poly_modulus_degree();
-        size_t coeff_mod_count = coeff_modulus.size();
-        size_t rns_poly_uint64_count = mul_safe(coeff_count, coeff_mod_count);
-
-        auto &base_converter = context_data.base_converter();
-        auto coeff_products_array = base_converter->get_coeff_products_array();
-        auto &inv_coeff_mod_coeff_array = base_converter->get_inv_coeff_mod_coeff_array();
-
-        // Set temporary coefficients_ptr pointer to point to either an existing
-        // allocation given as parameter, or else to a new allocation from the memory pool.
-        auto coefficients(allocate_uint(rns_poly_uint64_count, pool_));
-        uint64_t *coefficients_ptr = coefficients.get();
-
-        // Re-merge the coefficients first
-        for (size_t i = 0; i < coeff_count; i++)
-        {
-            for (size_t j = 0; j < coeff_mod_count; j++)
-            {
-                coefficients_ptr[j + (i * coeff_mod_count)] = value[(j * coeff_count) + i];
-            }
-        }
-
-        auto temp(allocate_uint(coeff_mod_count, pool_));
-        set_zero_uint(rns_poly_uint64_count, value);
-
-        for (size_t i = 0; i < coeff_count; i++)
-        {
-            for (size_t j = 0; j < coeff_mod_count; j++)
-            {
-                uint64_t tmp = multiply_uint_uint_mod(coefficients_ptr[j],
-                    inv_coeff_mod_coeff_array[j], coeff_modulus[j]);
-                multiply_uint_uint64(coeff_products_array + (j * coeff_mod_count),
-                    coeff_mod_count, tmp, coeff_mod_count, temp.get());
-                add_uint_uint_mod(temp.get(), value + (i * coeff_mod_count),
-                    context_data.total_coeff_modulus(), 
-                    coeff_mod_count, value + (i * coeff_mod_count));
-            }
-            set_zero_uint(coeff_mod_count, temp.get());
-            coefficients_ptr += coeff_mod_count;
-        }
-    }
-
     int Decryptor::invariant_noise_budget(const Ciphertext &encrypted)
     {
         // Verify that encrypted is valid.
@@ -450,10 +442,7 @@ namespace seal
         {
             throw logic_error("unsupported scheme");
         }
-        if (encrypted.is_ntt_form())
-        {
-            throw invalid_argument("encrypted cannot be in NTT form");
-        }
+        bool is_ntt_form = encrypted.is_ntt_form();
 
         auto &context_data = *context_->context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
@@ -461,6 +450,8 @@ namespace seal
         size_t coeff_count = parms.poly_modulus_degree();
         size_t coeff_mod_count = coeff_modulus.size();
         size_t rns_poly_uint64_count = mul_safe(coeff_count, coeff_mod_count);
+        size_t first_rns_poly_uint64_count = mul_safe(coeff_count,
+            context_->context_data()->parms().coeff_modulus().size());
         size_t encrypted_size = encrypted.size();
         uint64_t plain_modulus = parms.plain_modulus().value();
 
@@ -483,14 +474,8 @@ namespace seal
         */
         // put < (c_1 , c_2, ... , c_{count-1}) , (s,s^2,...,s^{count-1}) > mod q
         // in destination_poly.
-        // Make a copy of the encryption for NTT (except the first polynomial is 
-        // not needed).
-        auto encrypted_copy(allocate_poly(
-            mul_safe(encrypted_size - 1, coeff_count), coeff_mod_count, pool_));
-        set_poly_poly(encrypted.data(1), mul_safe(encrypted_size - 1, coeff_count),
-            coeff_mod_count, encrypted_copy.get());
 
-        // Now do the dot product of encrypted_copy and the secret key array using NTT.
+        // Now do the dot product of encrypted and the secret key array using NTT.
         // The secret key powers are already NTT transformed.
         auto copy_operand1(allocate_uint(coeff_count, pool_));
         for (size_t i = 0; i < coeff_mod_count; i++)
@@ -502,20 +487,36 @@ namespace seal
             for (size_t j = 0; j < encrypted_size - 1; j++)
             {
                 // Perform the dyadic product.
-                set_uint_uint(current_array1, coeff_count, copy_operand1.get());
-
-                // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables[i]);
-
-                dyadic_product_coeffmod(copy_operand1.get(), current_array2, coeff_count,
-                    coeff_modulus[i], copy_operand1.get());
+                if (is_ntt_form)
+                {
+                    dyadic_product_coeffmod(current_array1, current_array2, coeff_count,
+                        coeff_modulus[i], copy_operand1.get());
+                }
+                else
+                {
+                    set_uint_uint(current_array1, coeff_count, copy_operand1.get());
+
+                    // Lazy reduction
+                    ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables[i]);
+
+                    dyadic_product_coeffmod(copy_operand1.get(), current_array2,
+                        coeff_count, coeff_modulus[i], copy_operand1.get());
+                }
                 add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count), 
                     copy_operand1.get(),
                     coeff_count, coeff_modulus[i],
                     noise_poly.get() + (i * coeff_count));
 
                 current_array1 += rns_poly_uint64_count;
-                current_array2 += rns_poly_uint64_count;
+                current_array2 += first_rns_poly_uint64_count;
+            }
+
+            // In NTT form c_0 is added before the inverse NTT
+            if (is_ntt_form)
+            {
+                add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count),
+                    encrypted.data() + (i * coeff_count), coeff_count, coeff_modulus[i],
+                    noise_poly.get() + (i * coeff_count));
             }
 
             // Perform inverse NTT
@@ -526,9 +527,12 @@ namespace seal
         for (size_t i = 0; i < coeff_mod_count; i++)
         {
             // add c_0 into noise_poly
-            add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count),
-                encrypted.data() + (i * coeff_count), coeff_count, coeff_modulus[i],
-                noise_poly.get() + (i * coeff_count));
+            if (!is_ntt_form)
+            {
+                add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count),
+                    encrypted.data() + (i * coeff_count), coeff_count, coeff_modulus[i],
+                    noise_poly.get() + (i * coeff_count));
+            }
 
             // Multiply by parms.plain_modulus() and reduce mod parms.coeff_modulus() to get
             // parms.coeff_modulus()*noise
@@ -537,12 +541,56 @@ namespace seal
                 noise_poly.get() + (i * coeff_count));
         }
 
-        // Compose the noise
-        compose(context_data, noise_poly.get());
+        // Find the coefficient of largest absolute value without composing the
+        // noise. In mixed radix form numbers compare digit by digit from the most
+        // significant one, and the absolute value of x in centered representation
+        // is the smaller of x and q - x.
+        auto &base_converter = context_data.base_converter();
+        auto neg_noise_poly(allocate_poly(coeff_count, coeff_mod_count, pool_));
+        for (size_t i = 0; i < coeff_mod_count; i++)
+        {
+            negate_poly_coeffmod(noise_poly.get() + (i * coeff_count), coeff_count,
+                coeff_modulus[i], neg_noise_poly.get() + (i * coeff_count));
+        }
+        base_converter->mixed_radix(noise_poly.get(), noise_poly.get());
+        base_converter->mixed_radix(neg_noise_poly.get(), neg_noise_poly.get());
+
+        auto is_less_than = [&](const uint64_t *poly1, size_t index1, 
+            const uint64_t *poly2, size_t index2) {
+            for (size_t j = coeff_mod_count; j--; )
+            {
+                uint64_t digit1 = poly1[index1 + (j * coeff_count)];
+                uint64_t digit2 = poly2[index2 + (j * coeff_count)];
+                if (digit1 != digit2)
+                {
+                    return digit1 < digit2;
+                }
+            }
+            return false;
+        };
+        const uint64_t *max_poly = nullptr;
+        size_t max_index = 0;
+        for (size_t i = 0; i < coeff_count; i++)
+        {
+            const uint64_t *abs_poly = is_less_than(neg_noise_poly.get(), i, 
+                noise_poly.get(), i) ? neg_noise_poly.get() : noise_poly.get();
+            if (!max_poly || is_less_than(max_poly, max_index, abs_poly, i))
+            {
+                max_poly = abs_poly;
+                max_index = i;
+            }
+        }
 
-        // Next we compute the infinity norm mod parms.coeff_modulus()
-        poly_infty_norm_coeffmod(noise_poly.get(), coeff_count, coeff_mod_count,
-            context_data.total_coeff_modulus(), destination.get(), pool_);
+        // Only the largest coefficient is composed, from the most significant digit
+        set_zero_uint(coeff_mod_count, destination.get());
+        auto temp(allocate_uint(coeff_mod_count, pool_));
+        for (size_t j = coeff_mod_count; j--; )
+        {
+            multiply_uint_uint64(destination.get(), coeff_mod_count, 
+                coeff_modulus[j].value(), coeff_mod_count, temp.get());
+            add_uint_uint64(temp.get(), max_poly[max_index + (j * coeff_count)],
+                coeff_mod_count, destination.get());
+        }
 
         // The -1 accounts for scaling the invariant noise by 2
         int bit_count_diff = context_data.total_coeff_modulus_bit_count() -
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include "seal/randomgen.h"
 #include "seal/encryptionparams.h"
 #include "seal/context.h"
@@ -44,7 +45,8 @@ namespace seal
     ciphertexts should remain by default in NTT form. We call these scheme-specific 
     NTT states the "default NTT form". Decryption requires the input ciphertexts 
     to be in the default NTT form, and will throw an exception if this is not the 
-    case.
+    case. The only exception are BFV ciphertexts kept in NTT form, which are 
+    decrypted without being transformed back first.
     */
     class Decryptor
     {
@@ -67,10 +69,27 @@ namespace seal
         @param[in] encrypted The ciphertext to decrypt
         @param[out] destination The plaintext to overwrite with the decrypted ciphertext
         @throws std::invalid_argument if encrypted is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is not
+        in NTT form
         */
         void decrypt(const Ciphertext &encrypted, Plaintext &destination);
 
+        /*
+        Decrypts a vector of Ciphertexts and stores the results in the destination
+        vector, which is resized to match. The ciphertexts are decrypted in parallel
+        using the number of threads set with set_thread_count, all sharing this
+        Decryptor and its SEALContext.
+
+        @param[in] encrypteds The ciphertexts to decrypt
+        @param[out] destinations The plaintexts to overwrite with the decrypted ciphertexts
+        @throws std::invalid_argument if any of encrypteds is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if, when using scheme_type::CKKS, any of
+        encrypteds is not in NTT form
+        */
+        void decrypt_many(const std::vector<Ciphertext> &encrypteds,
+            std::vector<Plaintext> &destinations);
+
         /*
         Computes the invariant noise budget (in bits) of a ciphertext. The invariant 
         noise budget measures the amount of room there is for the noise to grow while 
@@ -91,10 +110,28 @@ namespace seal
         @param[in] encrypted The ciphertext
         @throws std::invalid_argument if the scheme is not BFV
         @throws std::invalid_argument if encrypted is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted is in NTT form
         */
         int invariant_noise_budget(const Ciphertext &encrypted);
 
+        /**
+        Sets the number of threads used by decrypt_many. A value of zero means to
+        use as many threads as the hardware supports. The default is one.
+
+        @param[in] thread_count The number of threads to use
+        */
+        inline void set_thread_count(std::size_t thread_count) noexcept
+        {
+            thread_count_ = thread_count;
+        }
+
+        /**
+        Returns the number of threads used by decrypt_many.
+        */
+        inline std::size_t thread_count() const noexcept
+        {
+            return thread_count_;
+        }
+
     private:
         void bfv_decrypt(const Ciphertext &encrypted, Plaintext &destination,
             MemoryPoolHandle pool);
@@ -112,9 +149,6 @@ namespace seal
 
         void compute_secret_key_array(std::size_t max_power);
 
-        void compose(const SEALContext::ContextData &context_data, 
-            std::uint64_t *value);
-
         /**
         We use a fresh memory pool with `clear_on_destruction' enabled
         */
@@ -129,5 +163,7 @@ namespace seal
         util::Pointer<std::uint64_t> secret_key_array_;
 
         mutable util::ReaderWriterLocker secret_key_array_locker_;
+
+        std::size_t thread_count_ = 1;
     };
 }
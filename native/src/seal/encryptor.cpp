@@ -12,6 +12,7 @@
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/clipnormal.h"
 #include "seal/util/smallntt.h"
+#include "seal/util/noiseestimate.h"
 
 using namespace std;
 using namespace seal::util;
@@ -157,6 +158,8 @@ namespace seal
                 destination.data(1) + (i * coeff_count), coeff_count, 
                 coeff_modulus[i], destination.data(1) + (i * coeff_count));
         }
+
+        destination.noise_budget() = fresh_noise_budget(parms);
     }
 
     void Encryptor::ckks_encrypt(const Plaintext &plain, 
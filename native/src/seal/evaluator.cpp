@@ -11,6 +11,7 @@
 #include "seal/util/uintarith.h"
 #include "seal/util/polycore.h"
 #include "seal/util/polyarithsmallmod.h"
+#include "seal/util/noiseestimate.h"
 
 using namespace std;
 using namespace seal::util;
@@ -19,11 +20,137 @@ namespace seal
 {
     namespace
     {
+        // Largest number of non-zero coefficients for which multiply_plain uses
+        // monomial products instead of NTTs
+        constexpr size_t sparse_plain_max_nonzero_count = 16;
+
         template<typename T, typename S>
         bool are_same_scale(T value1, S value2)
         {
             return util::are_close<double>(value1.scale(), value2.scale());
         }
+
+        // Sums of dyadic products modulo the primes of an RNS base, kept in 128-bit
+        // accumulators and reduced only when the next products could overflow them
+        class ProductAccumulator
+        {
+        public:
+            ProductAccumulator(size_t poly_count, size_t coeff_count,
+                const SmallModulus *modulus, size_t mod_count, MemoryPool &pool,
+                int operand_excess_bit_count = 0) :
+                poly_count_(poly_count), coeff_count_(coeff_count), modulus_(modulus),
+                mod_count_(mod_count),
+                data_(allocate_zero_poly(mul_safe(size_t(2), coeff_count),
+                    mul_safe(poly_count, mod_count), pool))
+            {
+                // A product of reduced operands has at most 2 * bit_count bits; 
+                // one operand may exceed the modulus by operand_excess_bit_count bits
+                int bit_count = 0;
+                for (size_t i = 0; i < mod_count_; i++)
+                {
+                    bit_count = max(bit_count, modulus_[i].bit_count());
+                }
+                lazy_limit_ = size_t(1) << min(
+                    128 - 2 * bit_count - operand_excess_bit_count, 32);
+            }
+
+            // Makes room for product_count more products in each accumulator
+            void reserve(size_t product_count)
+            {
+                if (product_count >= lazy_limit_)
+                {
+                    throw invalid_argument("ciphertext size is too large");
+                }
+                if (product_count_ + product_count > lazy_limit_)
+                {
+                    for (size_t i = 0; i < poly_count_; i++)
+                    {
+                        for (size_t j = 0; j < mod_count_; j++)
+                        {
+                            reduce_accumulator_coeffmod(data_.get() + offset(i, j), 
+                                coeff_count_, modulus_[j]);
+                        }
+                    }
+                    product_count_ = 1;
+                }
+                product_count_ += product_count;
+            }
+
+            inline void accumulate(size_t poly_index, size_t mod_index,
+                const uint64_t *operand1, const uint64_t *operand2)
+            {
+                dyadic_product_accumulate(operand1, operand2, coeff_count_,
+                    data_.get() + offset(poly_index, mod_index));
+            }
+
+            inline void get(size_t poly_index, size_t mod_index, uint64_t *result) const
+            {
+                modulo_accumulator_coeffs(data_.get() + offset(poly_index, mod_index),
+                    coeff_count_,
+                    modulus_[mod_index], result);
+            }
+
+        private:
+            inline size_t offset(size_t poly_index, size_t mod_index) const
+            {
+                return 2 * coeff_count_ * (poly_index * mod_count_ + mod_index);
+            }
+
+            size_t poly_count_;
+
+            size_t coeff_count_;
+
+            const SmallModulus *modulus_;
+
+            size_t mod_count_;
+
+            Pointer<uint64_t> data_;
+
+            size_t lazy_limit_;
+
+            size_t product_count_ = 0;
+        };
+
+        // Number of digits a key switch multiplies with the keys at a level
+        // with coeff_mod_count primes
+        size_t key_switch_digit_count(const vector<Ciphertext> &key_vector,
+            size_t coeff_mod_count)
+        {
+            size_t digit_count = 0;
+            for (size_t i = 0; i < coeff_mod_count; i++)
+            {
+                digit_count += key_vector[i].size() / 2;
+            }
+            return digit_count;
+        }
+
+        // Budget after multiplying by plain. The noise grows with the number and
+        // size of the plaintext coefficients, taken as centered representatives
+        // modulo the plain modulus; an NTT form plaintext gives no such
+        // information, so it is bounded by the worst case.
+        double plain_product_noise_budget(const EncryptionParameters &parms,
+            double budget, const Plaintext &plain)
+        {
+            uint64_t plain_modulus = parms.plain_modulus().value();
+            if (plain.is_ntt_form())
+            {
+                return multiply_plain_noise_budget(parms, budget,
+                    parms.poly_modulus_degree(), plain_modulus >> 1);
+            }
+            size_t plain_nonzero_count = 0;
+            uint64_t plain_max_abs_value = 0;
+            for (size_t i = 0; i < plain.coeff_count(); i++)
+            {
+                if (plain[i])
+                {
+                    plain_nonzero_count++;
+                    plain_max_abs_value = max(plain_max_abs_value,
+                        min(plain[i], plain_modulus - plain[i]));
+                }
+            }
+            return multiply_plain_noise_budget(parms, budget,
+                plain_nonzero_count, plain_max_abs_value);
+        }
     }
 
     Evaluator::Evaluator(shared_ptr<SEALContext> context) : context_(move(context))
@@ -155,6 +282,8 @@ namespace seal
                 coeff_count * (encrypted2_size - encrypted1_size),
                 coeff_mod_count, encrypted1.data(encrypted1_size));
         }
+        encrypted1.noise_budget() = add_noise_budgets(
+            encrypted1.noise_budget(), encrypted2.noise_budget());
 #ifndef SEAL_ALLOW_TRANSPARENT_CIPHERTEXT
         // Transparent ciphertext output is not allowed.
         if (encrypted1.is_transparent())
@@ -249,6 +378,8 @@ namespace seal
                     encrypted1.data(encrypted1_size) + (i * coeff_count));
             }
         }
+        encrypted1.noise_budget() = add_noise_budgets(
+            encrypted1.noise_budget(), encrypted2.noise_budget());
 #ifndef SEAL_ALLOW_TRANSPARENT_CIPHERTEXT
         // Transparent ciphertext output is not allowed.
         if (encrypted1.is_transparent())
@@ -301,9 +432,23 @@ namespace seal
     void Evaluator::bfv_multiply(Ciphertext &encrypted1, 
         const Ciphertext &encrypted2, MemoryPoolHandle pool)
     {
-        if (encrypted1.is_ntt_form() || encrypted2.is_ntt_form())
+        // The tensor product is computed in coefficient form, so ciphertexts
+        // kept in NTT form are transformed back only at this point
+        if (encrypted2.is_ntt_form())
+        {
+            Ciphertext encrypted2_copy(pool);
+            encrypted2_copy = encrypted2;
+            transform_from_ntt_inplace(encrypted2_copy);
+            if (encrypted1.is_ntt_form())
+            {
+                transform_from_ntt_inplace(encrypted1);
+            }
+            bfv_multiply(encrypted1, encrypted2_copy, move(pool));
+            return;
+        }
+        if (encrypted1.is_ntt_form())
         {
-            throw invalid_argument("encrypted1 or encrypted2 cannot be in NTT form");
+            transform_from_ntt_inplace(encrypted1);
         }
 
         // Extract encryption parameters.
@@ -314,6 +459,8 @@ namespace seal
         size_t coeff_mod_count = coeff_modulus.size();
         size_t encrypted1_size = encrypted1.size();
         size_t encrypted2_size = encrypted2.size();
+        double noise_budget = multiply_noise_budget(parms, encrypted1.noise_budget(),
+            encrypted1_size, encrypted2.noise_budget(), encrypted2_size);
 
         uint64_t plain_modulus = parms.plain_modulus().value();
         auto &base_converter = context_data.base_converter();
@@ -573,6 +720,7 @@ namespace seal
                 tmp_result_bsk.get() + (i * encrypted_bsk_ptr_increment),
                 encrypted1.data(i), pool);
         }
+        encrypted1.noise_budget() = noise_budget;
     }
 
     void Evaluator::ckks_multiply(Ciphertext &encrypted1, 
@@ -729,7 +877,7 @@ namespace seal
     {
         if (encrypted.is_ntt_form())
         {
-            throw invalid_argument("encrypted cannot be in NTT form");
+            transform_from_ntt_inplace(encrypted);
         }
 
         // Extract encryption parameters.
@@ -757,6 +905,8 @@ namespace seal
 
         // Determine destination_array.size()
         size_t dest_count = sub_safe(add_safe(encrypted_size, encrypted_size), size_t(1));
+        double noise_budget = multiply_noise_budget(parms, encrypted.noise_budget(),
+            encrypted_size, encrypted.noise_budget(), encrypted_size);
 
         // Size check
         if (!product_fits_in(dest_count, coeff_count, bsk_mtilde_count))
@@ -962,6 +1112,7 @@ namespace seal
             base_converter->fastbconv_sk(
                 tmp_result_bsk.get() + (i * encrypted_bsk_ptr_increment), encrypted.data(i), pool);
         }
+        encrypted.noise_budget() = noise_budget;
     }
 
     void Evaluator::ckks_square(Ciphertext &encrypted, MemoryPoolHandle pool)
@@ -1164,14 +1315,24 @@ namespace seal
         {
             case scheme_type::BFV:
             {
-                if (encrypted.is_ntt_form())
-                {
-                    throw invalid_argument("BFV encrypted cannot be in NTT form");
-                }
                 for (size_t i = 0; i < relins_needed; i++)
                 {
-                    bfv_relinearize_one_step(encrypted.data(), encrypted_size,
-                        context_data, relin_keys, pool);
+                    // Key switching works the same for BFV ciphertexts kept in
+                    // NTT form as for CKKS ciphertexts
+                    if (encrypted.is_ntt_form())
+                    {
+                        ckks_relinearize_one_step(encrypted.data(), encrypted_size,
+                            context_data, relin_keys, pool);
+                    }
+                    else
+                    {
+                        bfv_relinearize_one_step(encrypted.data(), encrypted_size,
+                            context_data, relin_keys, pool);
+                    }
+                    encrypted.noise_budget() = key_switch_noise_budget(parms,
+                        encrypted.noise_budget(), relin_keys.decomposition_bit_count(),
+                        key_switch_digit_count(relin_keys.data()[encrypted_size - 3],
+                            parms.coeff_modulus().size()));
                     encrypted_size--;
                 }
                 break;
@@ -1245,128 +1406,28 @@ namespace seal
             throw invalid_argument("not enough relinearization keys");
         }
 #endif
-        // q/qi mod qi
         auto &first_context_data = *context_->context_data();
         auto &coeff_small_ntt_tables = first_context_data.small_ntt_tables();
 
-        // Decompose encrypted_array[count-1] into base w
-        // Want to create an array of polys, each of whose components i is
-        // (encrypted_array[count-1])^(i) - in the notation of FV paper.
-        // This allocation stores one of the decomposed factors modulo one of the primes.
-        auto decomp_encrypted_last(allocate_uint(coeff_count, pool));
-
-        // Lazy reduction
-        auto wide_innerresult0(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto wide_innerresult1(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
-        auto temp_decomp_coeff(allocate_uint(coeff_count, pool));
-
-        /*
-        For lazy reduction to work here, we need to ensure that the 128-bit accumulators
-        (wide_innerresult0 and wide_innerresult1) do not overflow. Since the modulus primes
-        are at most 60 bits, if the total number of summands is K, then the size of the
-        total sum of products (without reduction) is at most 62 + 60 + bit_length(K).
-        We need this to be at most 128, thus we need bit_length(K) <= 6. Thus, we need K <= 63.
-        In this case, this means sum_i relin_keys.data()[encrypted_size - 3][i].size() / 2 <= 63.
-        */
-        const uint64_t *encrypted_coeff = encrypted + (encrypted_size - 1) * rns_poly_uint64_count;
-
-        for (size_t i = 0; i < coeff_mod_count; i++, encrypted_coeff += coeff_count)
-        {
-            // We use HPS improvement to Bajard's RNS key switching so scaling by q_i/q not needed
-            // multiply_poly_scalar_coeffmod(
-            //     encrypted_coeff, coeff_count,
-            //     inv_coeff_products_mod_coeff_array[i], coeff_modulus[i],
-            //     encrypted_coeff_prod_inv_coeff.get());
-
-            int shift = 0;
-            auto &key_component_ref = relin_keys.data()[encrypted_size - 3][i];
-            size_t keys_size = key_component_ref.size();
-            for (size_t k = 0; k < keys_size; k += 2)
-            {
-                const uint64_t *key_ptr_0 = key_component_ref.data(k);
-                const uint64_t *key_ptr_1 = key_component_ref.data(k + 1);
-
-                // Decompose here
-                int decomposition_bit_count = relin_keys.decomposition_bit_count();
-                for (size_t coeff_index = 0; coeff_index < coeff_count; coeff_index++)
-                {
-                    decomp_encrypted_last[coeff_index] =
-                        encrypted_coeff[coeff_index] >> shift;
-                    decomp_encrypted_last[coeff_index] &= 
-                        (uint64_t(1) << decomposition_bit_count) - 1;
-                }
-
-                uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
-                uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
-                for (size_t j = 0; j < coeff_mod_count; j++)
-                {
-                    uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    set_uint_uint(decomp_encrypted_last.get(), coeff_count, temp_decomp_coeff_ptr);
-
-                    // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
-                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, coeff_small_ntt_tables[j]);
-
-                    // Lazy reduction
-                    unsigned long long wide_innerproduct[2];
-                    unsigned long long temp;
-                    for (size_t m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_0++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult0_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult0_ptr[0] = temp;
-                        wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
-                    }
-
-                    temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    for (size_t m = 0; m < coeff_count; m++, wide_innerresult1_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_1++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult1_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult1_ptr[0] = temp;
-                        wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
-                    }
-                }
-                shift += decomposition_bit_count;
-            }
-        }
-
-        uint64_t *innerresult_poly_ptr = innerresult.get();
-        uint64_t *wide_innerresult_poly_ptr = wide_innerresult0.get();
-        uint64_t *encrypted_ptr = encrypted;
-        uint64_t *innerresult_coeff_ptr = innerresult_poly_ptr;
-        uint64_t *wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
-        {
-            for (size_t m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
-            {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
-            }
-            inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, coeff_small_ntt_tables[i]);
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
-        }
+        // Key switch the last polynomial; the results are in NTT form
+        auto innerresult0(allocate_poly(coeff_count, coeff_mod_count, pool));
+        auto innerresult1(allocate_poly(coeff_count, coeff_mod_count, pool));
+        switch_key_accumulate(encrypted + (encrypted_size - 1) * rns_poly_uint64_count,
+            relin_keys.data()[encrypted_size - 3], relin_keys.decomposition_bit_count(),
+            context_data, innerresult0.get(), innerresult1.get(), pool);
 
-        innerresult_poly_ptr = innerresult.get();
-        wide_innerresult_poly_ptr = wide_innerresult1.get();
-        encrypted_ptr = encrypted + rns_poly_uint64_count;
-        innerresult_coeff_ptr = innerresult_poly_ptr;
-        wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
+        for (size_t i = 0; i < coeff_mod_count; i++)
         {
-            for (size_t m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
-            {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
-            }
-            inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, coeff_small_ntt_tables[i]);
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
+            uint64_t *innerresult0_ptr = innerresult0.get() + (i * coeff_count);
+            uint64_t *innerresult1_ptr = innerresult1.get() + (i * coeff_count);
+            uint64_t *encrypted0_ptr = encrypted + (i * coeff_count);
+            uint64_t *encrypted1_ptr = encrypted0_ptr + rns_poly_uint64_count;
+            inverse_ntt_negacyclic_harvey(innerresult0_ptr, coeff_small_ntt_tables[i]);
+            add_poly_poly_coeffmod(encrypted0_ptr, innerresult0_ptr, coeff_count,
+                coeff_modulus[i], encrypted0_ptr);
+            inverse_ntt_negacyclic_harvey(innerresult1_ptr, coeff_small_ntt_tables[i]);
+            add_poly_poly_coeffmod(encrypted1_ptr, innerresult1_ptr, coeff_count,
+                coeff_modulus[i], encrypted1_ptr);
         }
     }
 
@@ -1407,46 +1468,63 @@ namespace seal
             throw invalid_argument("not enough evaluation keys");
         }
 #endif
-        // q/qi mod qi
         auto &first_context_data = *context_->context_data();
         auto &coeff_small_ntt_tables = first_context_data.small_ntt_tables();
 
-        // Decompose encrypted_array[count-1] into base w
+        // Convert the last polynomial of encrypted from NTT to create a bit-decomposition
+        uint64_t *encrypted_last = encrypted + (encrypted_size - 1) * rns_poly_uint64_count;
+        for (size_t i = 0; i < coeff_mod_count; i++)
+        {
+            inverse_ntt_negacyclic_harvey(encrypted_last + (i * coeff_count),
+                coeff_small_ntt_tables[i]);
+        }
+
+        // Key switch the last polynomial; the results are in NTT form
+        auto innerresult0(allocate_poly(coeff_count, coeff_mod_count, pool));
+        auto innerresult1(allocate_poly(coeff_count, coeff_mod_count, pool));
+        switch_key_accumulate(encrypted_last, relin_keys.data()[encrypted_size - 3], 
+            relin_keys.decomposition_bit_count(), context_data, 
+            innerresult0.get(), innerresult1.get(), pool);
+
+        for (size_t i = 0; i < coeff_mod_count; i++)
+        {
+            uint64_t *encrypted0_ptr = encrypted + (i * coeff_count);
+            uint64_t *encrypted1_ptr = encrypted0_ptr + rns_poly_uint64_count;
+            add_poly_poly_coeffmod(encrypted0_ptr, innerresult0.get() + (i * coeff_count),
+                coeff_count, coeff_modulus[i], encrypted0_ptr);
+            add_poly_poly_coeffmod(encrypted1_ptr, innerresult1.get() + (i * coeff_count),
+                coeff_count, coeff_modulus[i], encrypted1_ptr);
+        }
+    }
+
+    void Evaluator::switch_key_accumulate(const uint64_t *target, 
+        const vector<Ciphertext> &key_vector, int decomposition_bit_count,
+        const SEALContext::ContextData &context_data, uint64_t *result0, 
+        uint64_t *result1, MemoryPool &pool)
+    {
+        auto &coeff_modulus = context_data.parms().coeff_modulus();
+        size_t coeff_count = context_data.parms().poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
+
+        // Decompose target into base w
         // Want to create an array of polys, each of whose components i is
-        // (encrypted_array[count-1])^(i) - in the notation of FV paper.
+        // (target)^(i) - in the notation of FV paper.
         // This allocation stores one of the decomposed factors modulo one of the primes.
-        auto decomp_encrypted_last(allocate_uint(coeff_count, pool));
-
-        // Lazy reduction
-        auto wide_innerresult0(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto wide_innerresult1(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
+        auto decomp_target(allocate_uint(coeff_count, pool));
         auto temp_decomp_coeff(allocate_uint(coeff_count, pool));
 
-        /*
-        For lazy reduction to work here, we need to ensure that the 128-bit accumulators
-        (wide_innerresult0 and wide_innerresult1) do not overflow. Since the modulus primes
-        are at most 60 bits, if the total number of summands is K, then the size of the
-        total sum of products (without reduction) is at most 62 + 60 + bit_length(K).
-        We need this to be at most 128, thus we need bit_length(K) <= 6. Thus, we need K <= 63.
-        In this case, this means sum_i evaluation_keys.data()[encrypted_size - 3][i].size() / 2 <= 63.
-        */
-        uint64_t *encrypted_coeff = encrypted + (encrypted_size - 1) * rns_poly_uint64_count;
-
-        // inner product of evaluation keys and the bit-decomposition of the last ciphertext polynomial
-        for (size_t i = 0; i < coeff_mod_count; i++, encrypted_coeff += coeff_count)
+        // The products of all digits are summed in 128-bit accumulators without 
+        // reduction. The lazy NTT output has up to two extra bits, so for 60-bit 
+        // primes 64 products fit; beyond that the accumulators are reduced in 
+        // between, which happens only for very small decomposition bit counts.
+        ProductAccumulator accumulator(2, coeff_count, coeff_modulus.data(),
+            coeff_mod_count, pool, 2);
+        for (size_t i = 0; i < coeff_mod_count; i++, target += coeff_count)
         {
-            // Convert the last polynomial of encrypted from NTT to create a bit-decomposition
-            inverse_ntt_negacyclic_harvey(encrypted_coeff, coeff_small_ntt_tables[i]);
-
             // We use HPS improvement to Bajard's RNS key switching so scaling by q_i/q not needed
-            // multiply_poly_scalar_coeffmod(
-            //     encrypted_coeff, coeff_count,
-            //     inv_coeff_products_mod_coeff_array[i], coeff_modulus[i],
-            //     encrypted_coeff_prod_inv_coeff.get());
-
             int shift = 0;
-            auto &key_component_ref = relin_keys.data()[encrypted_size - 3][i];
+            auto &key_component_ref = key_vector[i];
             size_t keys_size = key_component_ref.size();
             for (size_t k = 0; k < keys_size; k += 2)
             {
@@ -1454,83 +1532,33 @@ namespace seal
                 const uint64_t *key_ptr_1 = key_component_ref.data(k + 1);
 
                 // Decompose here
-                int decomposition_bit_count = relin_keys.decomposition_bit_count();
                 for (size_t coeff_index = 0; coeff_index < coeff_count; coeff_index++)
                 {
-                    decomp_encrypted_last[coeff_index] =
-                        encrypted_coeff[coeff_index] >> shift;
-                    decomp_encrypted_last[coeff_index] &= 
-                        (uint64_t(1) << decomposition_bit_count) - 1;
+                    decomp_target[coeff_index] = (target[coeff_index] >> shift) &
+                        ((uint64_t(1) << decomposition_bit_count) - 1);
                 }
 
-                uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
-                uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
+                accumulator.reserve(1);
                 for (size_t j = 0; j < coeff_mod_count; j++)
                 {
-                    uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    set_uint_uint(decomp_encrypted_last.get(), coeff_count, temp_decomp_coeff_ptr);
+                    set_uint_uint(decomp_target.get(), coeff_count, temp_decomp_coeff.get());
 
                     // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
-                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, coeff_small_ntt_tables[j]);
-
-                    // Lazy reduction
-                    unsigned long long wide_innerproduct[2];
-                    unsigned long long temp;
-                    for (size_t m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_0++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult0_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult0_ptr[0] = temp;
-                        wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
-                    }
-
-                    temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    for (size_t m = 0; m < coeff_count; m++, wide_innerresult1_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_1++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult1_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult1_ptr[0] = temp;
-                        wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
-                    }
+                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff.get(), coeff_small_ntt_tables[j]);
+                    accumulator.accumulate(0, j, temp_decomp_coeff.get(), 
+                        key_ptr_0 + (j * coeff_count));
+                    accumulator.accumulate(1, j, temp_decomp_coeff.get(), 
+                        key_ptr_1 + (j * coeff_count));
                 }
                 shift += decomposition_bit_count;
             }
         }
 
-        uint64_t *innerresult_poly_ptr = innerresult.get();
-        uint64_t *wide_innerresult_poly_ptr = wide_innerresult0.get();
-        uint64_t *encrypted_ptr = encrypted;
-        uint64_t *innerresult_coeff_ptr = innerresult_poly_ptr;
-        uint64_t *wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
-        {
-            for (size_t m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
-            {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
-            }
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
-        }
-
-        innerresult_poly_ptr = innerresult.get();
-        wide_innerresult_poly_ptr = wide_innerresult1.get();
-        encrypted_ptr = encrypted + rns_poly_uint64_count;
-        innerresult_coeff_ptr = innerresult_poly_ptr;
-        wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
+        // Reduce once per coefficient
+        for (size_t j = 0; j < coeff_mod_count; j++)
         {
-            for (size_t m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
-            {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
-            }
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
+            accumulator.get(0, j, result0 + (j * coeff_count));
+            accumulator.get(1, j, result1 + (j * coeff_count));
         }
     }
 
@@ -1538,11 +1566,6 @@ namespace seal
         Ciphertext &destination, MemoryPoolHandle pool)
     {
         auto context_data_ptr = context_->context_data(encrypted.parms_id());
-        if (context_data_ptr->parms().scheme() == scheme_type::BFV &&
-            encrypted.is_ntt_form())
-        {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
-        }
         if (context_data_ptr->parms().scheme() == scheme_type::CKKS &&
             !encrypted.is_ntt_form())
         {
@@ -1562,8 +1585,8 @@ namespace seal
         size_t next_coeff_mod_count = next_coeff_modulus.size();
         size_t coeff_count = next_parms.poly_modulus_degree();
         size_t encrypted_size = encrypted.size();
-        auto &inv_last_coeff_mod_array =
-            context_data.base_converter()->get_inv_last_coeff_mod_array();
+        auto &inv_last_coeff_mod_operands =
+            context_data.base_converter()->get_inv_last_coeff_mod_operands();
 
         // Size test
         if (!product_fits_in(coeff_count, encrypted_size, next_coeff_mod_count))
@@ -1571,10 +1594,12 @@ namespace seal
             throw logic_error("invalid parameters");
         }
 
-        // In CKKS need to transform away from NTT form
+        // Rounding by the last prime needs coefficient form; this is always the
+        // case in CKKS and for BFV ciphertexts kept in NTT form
+        bool is_ntt_form = encrypted.is_ntt_form();
         Ciphertext encrypted_copy(pool);
         encrypted_copy = encrypted;
-        if (next_parms.scheme() == scheme_type::CKKS)
+        if (is_ntt_form)
         {
             transform_from_ntt_inplace(encrypted_copy);
         }
@@ -1605,7 +1630,7 @@ namespace seal
                     coeff_count, next_coeff_modulus[mod_index], temp2_ptr);
                 // qk^(-1) * ((ct mod qi) - (ct mod qk)) mod qi
                 multiply_poly_scalar_coeffmod(temp2_ptr, coeff_count,
-                    inv_last_coeff_mod_array[mod_index],
+                    inv_last_coeff_mod_operands[mod_index],
                     next_coeff_modulus[mod_index], temp2_ptr);
             }
         }
@@ -1617,15 +1642,22 @@ namespace seal
         set_poly_poly(temp2.get(), coeff_count * encrypted_size, next_coeff_mod_count,
             destination.data());
 
-        // In CKKS need to transform back to NTT form
-        if (next_parms.scheme() == scheme_type::CKKS)
+        // Transform back to the NTT form of the input
+        if (is_ntt_form)
         {
             transform_to_ntt_inplace(destination);
-
+        }
+        if (next_parms.scheme() == scheme_type::CKKS)
+        {
             // Also change the scale
             destination.scale() = encrypted.scale() /
                 static_cast<double>(context_data.parms().coeff_modulus().back().value());
         }
+        else
+        {
+            destination.noise_budget() = mod_switch_noise_budget(next_parms,
+                encrypted_copy.noise_budget());
+        }
     }
 
     void Evaluator::mod_switch_drop_to_next(const Ciphertext &encrypted, 
@@ -1813,6 +1845,50 @@ namespace seal
         }
     }
 
+    void Evaluator::mod_switch_to_lowest_inplace(Ciphertext &encrypted, 
+        int noise_budget, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (context_data_ptr->parms().scheme() != scheme_type::BFV)
+        {
+            throw logic_error("unsupported scheme");
+        }
+        if (noise_budget < 0)
+        {
+            throw invalid_argument("noise_budget cannot be negative");
+        }
+
+        auto &parms = context_data_ptr->parms();
+        int coeff_count_power = get_power_of_two(parms.poly_modulus_degree());
+        int plain_modulus_bit_count = parms.plain_modulus().bit_count();
+
+        // Switching to q' adds invariant noise of at most t * (1 + n) / (2 * q'), 
+        // as the secret key is ternary. Together with the noise already present
+        // this costs at most one more bit than the larger of the two.
+        parms_id_type parms_id = encrypted.parms_id();
+        auto next_context_data_ptr = context_data_ptr->next_context_data();
+        while (next_context_data_ptr)
+        {
+            int rounding_budget = next_context_data_ptr->total_coeff_modulus_bit_count() -
+                plain_modulus_bit_count - coeff_count_power - 2;
+            int next_noise_budget = min(noise_budget, rounding_budget) - 1;
+            if (next_noise_budget <= 0)
+            {
+                break;
+            }
+            noise_budget = next_noise_budget;
+            parms_id = next_context_data_ptr->parms().parms_id();
+            next_context_data_ptr = next_context_data_ptr->next_context_data();
+        }
+
+        mod_switch_to_inplace(encrypted, parms_id, move(pool));
+    }
+
     void Evaluator::mod_switch_to_inplace(Plaintext &plain, parms_id_type parms_id)
     {
         // Verify parameters.
@@ -2012,96 +2088,477 @@ namespace seal
         destination = encrypteds[encrypteds.size() - 1];
     }
 
-    void Evaluator::exponentiate_inplace(Ciphertext &encrypted, uint64_t exponent,
-        const RelinKeys &relin_keys, MemoryPoolHandle pool)
+    void Evaluator::inner_product(const vector<Ciphertext> &encrypteds1,
+        const vector<Ciphertext> &encrypteds2, const RelinKeys &relin_keys,
+        Ciphertext &destination, MemoryPoolHandle pool)
     {
         // Verify parameters.
-        auto context_data_ptr = context_->context_data(encrypted.parms_id());
-        if (!context_data_ptr)
+        if (encrypteds1.empty())
         {
-            throw invalid_argument("encrypted is not valid for encryption parameters");
+            throw invalid_argument("encrypteds1 cannot be empty");
         }
-        if (!context_->context_data(relin_keys.parms_id()))
+        if (encrypteds1.size() != encrypteds2.size())
         {
-            throw invalid_argument("relin_keys is not valid for encryption parameters");
+            throw invalid_argument("encrypteds1 and encrypteds2 size mismatch");
         }
         if (!pool)
         {
             throw invalid_argument("pool is uninitialized");
         }
-        if (exponent == 0)
+        auto parms_id = encrypteds1[0].parms_id();
+        for (size_t i = 0; i < encrypteds1.size(); i++)
         {
-            throw invalid_argument("exponent cannot be 0");
+            if (!encrypteds1[i].is_metadata_valid_for(context_) ||
+                !encrypteds2[i].is_metadata_valid_for(context_))
+            {
+                throw invalid_argument("encrypteds is not valid for encryption parameters");
+            }
+            if (encrypteds1[i].parms_id() != parms_id || 
+                encrypteds2[i].parms_id() != parms_id)
+            {
+                throw invalid_argument("encrypteds parameter mismatch");
+            }
         }
 
-        // Fast case
-        if (exponent == 1)
+        // Compute into a temporary so that destination may alias an input
+        Ciphertext result(context_, parms_id, pool);
+        auto context_data_ptr = context_->context_data(parms_id);
+        switch (context_data_ptr->parms().scheme())
         {
-            return;
-        }
+        case scheme_type::BFV:
+            bfv_inner_product(encrypteds1, encrypteds2, result, pool);
+            break;
 
-        // Create a vector of copies of encrypted
-        vector<Ciphertext> exp_vector(exponent, encrypted);
-        multiply_many(exp_vector, relin_keys, encrypted, move(pool));
-    }
+        case scheme_type::CKKS:
+            ckks_inner_product(encrypteds1, encrypteds2, result, pool);
+            break;
 
-    void Evaluator::add_plain_inplace(Ciphertext &encrypted, const Plaintext &plain)
-    {
-        // Verify parameters.
-        if (!encrypted.is_metadata_valid_for(context_))
-        {
-            throw invalid_argument("encrypted is not valid for encryption parameters");
-        }
-        if (!plain.is_valid_for(context_))
-        {
-            throw invalid_argument("plain is not valid for encryption parameters");
+        default:
+            throw invalid_argument("unsupported scheme");
         }
 
-        auto &context_data = *context_->context_data(encrypted.parms_id());
-        auto &parms = context_data.parms();
-        if (parms.scheme() == scheme_type::BFV && encrypted.is_ntt_form())
-        {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
-        }
-        if (parms.scheme() == scheme_type::CKKS && !encrypted.is_ntt_form())
-        {
-            throw invalid_argument("CKKS encrypted must be in NTT form");
-        }
-        if (plain.is_ntt_form() != encrypted.is_ntt_form())
-        {
-            throw invalid_argument("NTT form mismatch");
-        }
-        if (encrypted.is_ntt_form() &&
-            (encrypted.parms_id() != plain.parms_id()))
+        // Relinearize only once
+        if (result.size() > 2)
         {
-            throw invalid_argument("encrypted and plain parameter mismatch");
+            relinearize_internal(result, relin_keys, 2, pool);
         }
-        if (!are_same_scale(encrypted, plain))
+        destination = move(result);
+#ifndef SEAL_ALLOW_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (destination.is_transparent())
         {
-            throw invalid_argument("scale mismatch");
+            throw logic_error("result ciphertext is transparent");
         }
+#endif
+    }
 
+    void Evaluator::bfv_inner_product(const vector<Ciphertext> &encrypteds1,
+        const vector<Ciphertext> &encrypteds2, Ciphertext &destination,
+        MemoryPoolHandle pool)
+    {
         // Extract encryption parameters.
+        auto &context_data = *context_->context_data(destination.parms_id());
+        auto &parms = context_data.parms();
         auto &coeff_modulus = parms.coeff_modulus();
         size_t coeff_count = parms.poly_modulus_degree();
         size_t coeff_mod_count = coeff_modulus.size();
 
+        uint64_t plain_modulus = parms.plain_modulus().value();
+        auto &base_converter = context_data.base_converter();
+        auto &bsk_modulus = base_converter->get_bsk_mod_array();
+        size_t bsk_base_mod_count = base_converter->bsk_base_mod_count();
+        size_t bsk_mtilde_count = add_safe(bsk_base_mod_count, size_t(1));
+        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
+        auto &bsk_small_ntt_tables = base_converter->get_bsk_small_ntt_tables();
+
+        // The destination size is the largest size of a product
+        size_t max_encrypted1_size = 0;
+        size_t max_encrypted2_size = 0;
+        size_t max_product_count = 0;
+        size_t dest_count = 0;
+        double noise_budget = 0;
+        for (size_t i = 0; i < encrypteds1.size(); i++)
+        {
+            if (encrypteds1[i].is_ntt_form() || encrypteds2[i].is_ntt_form())
+            {
+                throw invalid_argument("encrypteds cannot be in NTT form");
+            }
+            max_encrypted1_size = max(max_encrypted1_size, encrypteds1[i].size());
+            max_encrypted2_size = max(max_encrypted2_size, encrypteds2[i].size());
+            dest_count = max(dest_count, sub_safe(add_safe(
+                encrypteds1[i].size(), encrypteds2[i].size()), size_t(1)));
+            max_product_count = max(max_product_count, 
+                min(encrypteds1[i].size(), encrypteds2[i].size()));
+
+            // The products are summed, so their noises add up
+            double product_noise_budget = multiply_noise_budget(parms,
+                encrypteds1[i].noise_budget(), encrypteds1[i].size(),
+                encrypteds2[i].noise_budget(), encrypteds2[i].size());
+            noise_budget = i ? add_noise_budgets(noise_budget, product_noise_budget) :
+                product_noise_budget;
+        }
+
         // Size check
-        if (!product_fits_in(coeff_count, coeff_mod_count))
+        if (!product_fits_in(max(dest_count, max(max_encrypted1_size, max_encrypted2_size)),
+            coeff_count, bsk_mtilde_count))
         {
             throw logic_error("invalid parameters");
         }
 
-        switch (parms.scheme())
-        {
-        case scheme_type::BFV:
+        // The sum is floored only once, so fast_floor needs K * n * t * q^2 < q * Bsk 
+        // where K is the number of products summed into one coefficient. BaseConverter 
+        // reserves 32 bits for K * n, and each doubling of K costs one bit of them.
+        double headroom_bit_count = -log2(static_cast<double>(plain_modulus)) - 
+            log2(static_cast<double>(coeff_count));
+        for (size_t i = 0; i < bsk_base_mod_count; i++)
         {
+            headroom_bit_count += log2(static_cast<double>(bsk_modulus[i].value()));
+        }
+        for (size_t i = 0; i < coeff_mod_count; i++)
+        {
+            headroom_bit_count -= log2(static_cast<double>(coeff_modulus[i].value()));
+        }
+        if (log2(static_cast<double>(mul_safe(encrypteds1.size(), max_product_count))) >= 
+            headroom_bit_count)
+        {
+            throw invalid_argument("too many products for the encryption parameters");
+        }
+
+        size_t encrypted_ptr_increment = coeff_count * coeff_mod_count;
+        size_t encrypted_bsk_ptr_increment = coeff_count * bsk_base_mod_count;
+
+        // Converts a ciphertext to base q U Bsk and to NTT form, as in bfv_multiply
+        auto tmp_bsk_mtilde(allocate_poly(coeff_count, bsk_mtilde_count, pool));
+        auto to_ntt_coeff_bsk = [&](const Ciphertext &encrypted, 
+            uint64_t *coeff_destination, uint64_t *bsk_destination)
+        {
+            for (size_t i = 0; i < encrypted.size(); i++)
+            {
+                uint64_t *coeff_ptr = coeff_destination + (i * encrypted_ptr_increment);
+                uint64_t *bsk_ptr = bsk_destination + (i * encrypted_bsk_ptr_increment);
+                base_converter->fastbconv_mtilde(encrypted.data(i), 
+                    tmp_bsk_mtilde.get(), pool);
+                base_converter->mont_rq(tmp_bsk_mtilde.get(), bsk_ptr);
+                set_poly_poly(encrypted.data(i), coeff_count, coeff_mod_count, coeff_ptr);
+
+                // Full reduction so that the accumulators can absorb more products
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    ntt_negacyclic_harvey(coeff_ptr + (j * coeff_count), 
+                        coeff_small_ntt_tables[j]);
+                }
+                for (size_t j = 0; j < bsk_base_mod_count; j++)
+                {
+                    ntt_negacyclic_harvey(bsk_ptr + (j * coeff_count), 
+                        bsk_small_ntt_tables[j]);
+                }
+            }
+        };
+
+        auto encrypted1_coeff(allocate_poly(
+            coeff_count * max_encrypted1_size, coeff_mod_count, pool));
+        auto encrypted1_bsk(allocate_poly(
+            coeff_count * max_encrypted1_size, bsk_base_mod_count, pool));
+        auto encrypted2_coeff(allocate_poly(
+            coeff_count * max_encrypted2_size, coeff_mod_count, pool));
+        auto encrypted2_bsk(allocate_poly(
+            coeff_count * max_encrypted2_size, bsk_base_mod_count, pool));
+
+        ProductAccumulator accumulator_coeff(dest_count, coeff_count, 
+            coeff_modulus.data(), coeff_mod_count, pool);
+        ProductAccumulator accumulator_bsk(dest_count, coeff_count, 
+            bsk_modulus.get(), bsk_base_mod_count, pool);
+
+        // Accumulate the tensor products of all pairs in base q and Bsk
+        for (size_t k = 0; k < encrypteds1.size(); k++)
+        {
+            size_t encrypted1_size = encrypteds1[k].size();
+            size_t encrypted2_size = encrypteds2[k].size();
+            to_ntt_coeff_bsk(encrypteds1[k], encrypted1_coeff.get(), encrypted1_bsk.get());
+            to_ntt_coeff_bsk(encrypteds2[k], encrypted2_coeff.get(), encrypted2_bsk.get());
+
+            // Each output polynomial receives at most this many products
+            size_t product_count = min(encrypted1_size, encrypted2_size);
+            accumulator_coeff.reserve(product_count);
+            accumulator_bsk.reserve(product_count);
+
+            for (size_t encrypted1_index = 0; encrypted1_index < encrypted1_size; 
+                encrypted1_index++)
+            {
+                for (size_t encrypted2_index = 0; encrypted2_index < encrypted2_size;
+                    encrypted2_index++)
+                {
+                    size_t secret_power_index = encrypted1_index + encrypted2_index;
+                    for (size_t i = 0; i < coeff_mod_count; i++)
+                    {
+                        accumulator_coeff.accumulate(secret_power_index, i,
+                            encrypted1_coeff.get() + (i * coeff_count) +
+                            (encrypted1_index * encrypted_ptr_increment),
+                            encrypted2_coeff.get() + (i * coeff_count) +
+                            (encrypted2_index * encrypted_ptr_increment));
+                    }
+                    for (size_t i = 0; i < bsk_base_mod_count; i++)
+                    {
+                        accumulator_bsk.accumulate(secret_power_index, i,
+                            encrypted1_bsk.get() + (i * coeff_count) +
+                            (encrypted1_index * encrypted_bsk_ptr_increment),
+                            encrypted2_bsk.get() + (i * coeff_count) +
+                            (encrypted2_index * encrypted_bsk_ptr_increment));
+                    }
+                }
+            }
+        }
+
+        // Reduce once, convert back from NTT form and multiply by the plain modulus,
+        // laid out as (te0)q(te'0)Bsk | ... to make it ready for fast_floor
+        auto tmp_coeff_bsk_together(allocate_poly(
+            coeff_count, dest_count * (coeff_mod_count + bsk_base_mod_count), pool));
+        uint64_t *tmp_coeff_bsk_together_ptr = tmp_coeff_bsk_together.get();
+        for (size_t i = 0; i < dest_count; i++)
+        {
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                uint64_t *poly_ptr = tmp_coeff_bsk_together_ptr + (j * coeff_count);
+                accumulator_coeff.get(i, j, poly_ptr);
+                inverse_ntt_negacyclic_harvey(poly_ptr, coeff_small_ntt_tables[j]);
+                multiply_poly_scalar_coeffmod(poly_ptr, coeff_count, plain_modulus,
+                    coeff_modulus[j], poly_ptr);
+            }
+            tmp_coeff_bsk_together_ptr += encrypted_ptr_increment;
+
+            for (size_t j = 0; j < bsk_base_mod_count; j++)
+            {
+                uint64_t *poly_ptr = tmp_coeff_bsk_together_ptr + (j * coeff_count);
+                accumulator_bsk.get(i, j, poly_ptr);
+                inverse_ntt_negacyclic_harvey(poly_ptr, bsk_small_ntt_tables[j]);
+                multiply_poly_scalar_coeffmod(poly_ptr, coeff_count, plain_modulus,
+                    bsk_modulus[j], poly_ptr);
+            }
+            tmp_coeff_bsk_together_ptr += encrypted_bsk_ptr_increment;
+        }
+
+        // Prepare destination
+        destination.resize(context_, parms.parms_id(), dest_count);
+
+        auto tmp_result_bsk(allocate_poly(coeff_count, bsk_base_mod_count, pool));
+        for (size_t i = 0; i < dest_count; i++)
+        {
+            // Fast floor from q U {Bsk} to Bsk
+            base_converter->fast_floor(
+                tmp_coeff_bsk_together.get() +
+                (i * (encrypted_ptr_increment + encrypted_bsk_ptr_increment)),
+                tmp_result_bsk.get(), pool);
+
+            // Fast base convert from Bsk to q
+            base_converter->fastbconv_sk(tmp_result_bsk.get(), destination.data(i), pool);
+        }
+        destination.noise_budget() = noise_budget;
+    }
+
+    void Evaluator::ckks_inner_product(const vector<Ciphertext> &encrypteds1,
+        const vector<Ciphertext> &encrypteds2, Ciphertext &destination,
+        MemoryPoolHandle pool)
+    {
+        // Extract encryption parameters.
+        auto &context_data = *context_->context_data(destination.parms_id());
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+
+        // All products must have the same scale
+        double new_scale = encrypteds1[0].scale() * encrypteds2[0].scale();
+        size_t dest_count = 0;
+        for (size_t i = 0; i < encrypteds1.size(); i++)
+        {
+            if (!(encrypteds1[i].is_ntt_form() && encrypteds2[i].is_ntt_form()))
+            {
+                throw invalid_argument("encrypteds must be in NTT form");
+            }
+            if (!are_close<double>(encrypteds1[i].scale() * encrypteds2[i].scale(),
+                new_scale))
+            {
+                throw invalid_argument("scale mismatch");
+            }
+            dest_count = max(dest_count, sub_safe(add_safe(
+                encrypteds1[i].size(), encrypteds2[i].size()), size_t(1)));
+        }
+
+        // Check that scale is positive and not too large
+        if (new_scale <= 0 || (static_cast<int>(log2(new_scale)) >=
+            context_data.total_coeff_modulus_bit_count()))
+        {
+            throw invalid_argument("scale out of bounds");
+        }
+
+        // Size check
+        if (!product_fits_in(dest_count, coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Accumulate the tensor products of all pairs
+        ProductAccumulator accumulator(dest_count, coeff_count, 
+            coeff_modulus.data(), coeff_mod_count, pool);
+        for (size_t k = 0; k < encrypteds1.size(); k++)
+        {
+            auto &encrypted1 = encrypteds1[k];
+            auto &encrypted2 = encrypteds2[k];
+            accumulator.reserve(min(encrypted1.size(), encrypted2.size()));
+            for (size_t encrypted1_index = 0; encrypted1_index < encrypted1.size();
+                encrypted1_index++)
+            {
+                for (size_t encrypted2_index = 0; encrypted2_index < encrypted2.size();
+                    encrypted2_index++)
+                {
+                    for (size_t i = 0; i < coeff_mod_count; i++)
+                    {
+                        accumulator.accumulate(encrypted1_index + encrypted2_index, i,
+                            encrypted1.data(encrypted1_index) + (i * coeff_count),
+                            encrypted2.data(encrypted2_index) + (i * coeff_count));
+                    }
+                }
+            }
+        }
+
+        // Reduce once and set the result
+        destination.resize(context_, parms.parms_id(), dest_count);
+        for (size_t i = 0; i < dest_count; i++)
+        {
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                accumulator.get(i, j, destination.data(i) + (j * coeff_count));
+            }
+        }
+        destination.is_ntt_form() = true;
+        destination.scale() = new_scale;
+    }
+
+    void Evaluator::exponentiate_inplace(Ciphertext &encrypted, uint64_t exponent,
+        const RelinKeys &relin_keys, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!context_->context_data(relin_keys.parms_id()))
+        {
+            throw invalid_argument("relin_keys is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        if (exponent == 0)
+        {
+            throw invalid_argument("exponent cannot be 0");
+        }
+
+        // Fast case
+        if (exponent == 1)
+        {
+            return;
+        }
+
+        // Create a vector of copies of encrypted
+        vector<Ciphertext> exp_vector(exponent, encrypted);
+        multiply_many(exp_vector, relin_keys, encrypted, move(pool));
+    }
+
+    void Evaluator::add_plain_inplace(Ciphertext &encrypted, const Plaintext &plain)
+    {
+        // Verify parameters.
+        if (!encrypted.is_metadata_valid_for(context_))
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!plain.is_valid_for(context_))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+
+        auto &context_data = *context_->context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        if (parms.scheme() == scheme_type::BFV && plain.is_ntt_form())
+        {
+            throw invalid_argument("BFV plain cannot be in NTT form");
+        }
+        if (parms.scheme() == scheme_type::CKKS && !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+        if (parms.scheme() == scheme_type::CKKS &&
+            plain.is_ntt_form() != encrypted.is_ntt_form())
+        {
+            throw invalid_argument("NTT form mismatch");
+        }
+        if (plain.is_ntt_form() &&
+            (encrypted.parms_id() != plain.parms_id()))
+        {
+            throw invalid_argument("encrypted and plain parameter mismatch");
+        }
+        if (!are_same_scale(encrypted, plain))
+        {
+            throw invalid_argument("scale mismatch");
+        }
+
+        // Extract encryption parameters.
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+
+        // Size check
+        if (!product_fits_in(coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        switch (parms.scheme())
+        {
+        case scheme_type::BFV:
+        {
+            // Adding zero changes neither the ciphertext nor its noise
+            size_t plain_coeff_count = plain.significant_coeff_count();
+            if (!plain_coeff_count)
+            {
+                break;
+            }
+
             auto coeff_div_plain_modulus = context_data.coeff_div_plain_modulus();
             auto plain_upper_half_threshold = context_data.plain_upper_half_threshold();
             auto upper_half_increment = context_data.upper_half_increment();
 
-            for (size_t i = 0; i < plain.coeff_count(); i++)
+            // Every plaintext coefficient is multiplied by the same constants
+            auto coeff_div_plain_modulus_operands(allocate<MultiplyUIntModOperand>(
+                coeff_mod_count, MemoryManager::GetPool()));
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                coeff_div_plain_modulus_operands[j].set(
+                    coeff_div_plain_modulus[j], coeff_modulus[j]);
+            }
+
+            // A ciphertext in NTT form receives the scaled plaintext through
+            // a zeroed buffer that is transformed before being added
+            bool is_ntt_form = encrypted.is_ntt_form();
+            Pointer<uint64_t> scaled_plain;
+            uint64_t *destination = encrypted.data();
+            if (is_ntt_form)
+            {
+                scaled_plain = allocate_zero_poly(coeff_count, coeff_mod_count,
+                    MemoryManager::GetPool());
+                destination = scaled_plain.get();
+            }
+
+            for (size_t i = 0; i < plain_coeff_count; i++)
             {
+                // Zero coefficients of sparse plaintexts contribute nothing
+                if (!plain[i])
+                {
+                    continue;
+                }
+
                 // This is Encryptor::preencrypt
                 // Multiply plain by scalar coeff_div_plain_modulus and reposition 
                 // if in upper-half.
@@ -2110,12 +2567,12 @@ namespace seal
                     // Loop over primes
                     for (size_t j = 0; j < coeff_mod_count; j++)
                     {
-                        unsigned long long temp[2]{ 0, 0 };
-                        multiply_uint64(coeff_div_plain_modulus[j], plain[i], temp);
-                        temp[1] += add_uint64(temp[0], upper_half_increment[j], temp);
-                        uint64_t scaled_plain_coeff = barrett_reduce_128(temp, coeff_modulus[j]);
-                        *(encrypted.data() + i + (j * coeff_count)) = add_uint_uint_mod(
-                            *(encrypted.data() + i + (j * coeff_count)),
+                        uint64_t scaled_plain_coeff = add_uint_uint_mod(
+                            multiply_uint_mod(plain[i], coeff_div_plain_modulus_operands[j],
+                                coeff_modulus[j]),
+                            upper_half_increment[j], coeff_modulus[j]);
+                        destination[i + (j * coeff_count)] = add_uint_uint_mod(
+                            destination[i + (j * coeff_count)],
                             scaled_plain_coeff, coeff_modulus[j]);
                     }
                 }
@@ -2123,14 +2580,39 @@ namespace seal
                 {
                     for (size_t j = 0; j < coeff_mod_count; j++)
                     {
-                        uint64_t scaled_plain_coeff = multiply_uint_uint_mod(
-                            coeff_div_plain_modulus[j], plain[i], coeff_modulus[j]);
-                        *(encrypted.data() + i + (j * coeff_count)) = add_uint_uint_mod(
-                            *(encrypted.data() + i + (j * coeff_count)),
+                        uint64_t scaled_plain_coeff = multiply_uint_mod(
+                            plain[i], coeff_div_plain_modulus_operands[j], coeff_modulus[j]);
+                        destination[i + (j * coeff_count)] = add_uint_uint_mod(
+                            destination[i + (j * coeff_count)],
                             scaled_plain_coeff, coeff_modulus[j]);
                     }
                 }
             }
+
+            if (is_ntt_form)
+            {
+                auto &small_ntt_tables = context_data.small_ntt_tables();
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    // The NTT of a constant, e.g., an all-ones batched mask,
+                    // is the same constant in every coefficient
+                    if (plain_coeff_count == 1)
+                    {
+                        fill_n(destination + (j * coeff_count) + 1, coeff_count - 1,
+                            destination[j * coeff_count]);
+                    }
+                    else
+                    {
+                        ntt_negacyclic_harvey(destination + (j * coeff_count),
+                            small_ntt_tables[j]);
+                    }
+                    add_poly_poly_coeffmod(encrypted.data() + (j * coeff_count),
+                        destination + (j * coeff_count), coeff_count,
+                        coeff_modulus[j], encrypted.data() + (j * coeff_count));
+                }
+            }
+            encrypted.noise_budget() = add_plain_noise_budget(parms,
+                encrypted.noise_budget());
             break;
         }
 
@@ -2171,19 +2653,20 @@ namespace seal
 
         auto &context_data = *context_->context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
-        if (parms.scheme() == scheme_type::BFV && encrypted.is_ntt_form())
+        if (parms.scheme() == scheme_type::BFV && plain.is_ntt_form())
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            throw invalid_argument("BFV plain cannot be in NTT form");
         }
         if (parms.scheme() == scheme_type::CKKS && !encrypted.is_ntt_form())
         {
             throw invalid_argument("CKKS encrypted must be in NTT form");
         }
-        if (plain.is_ntt_form() != encrypted.is_ntt_form())
+        if (parms.scheme() == scheme_type::CKKS &&
+            plain.is_ntt_form() != encrypted.is_ntt_form())
         {
             throw invalid_argument("NTT form mismatch");
         }
-        if (encrypted.is_ntt_form() &&
+        if (plain.is_ntt_form() &&
             (encrypted.parms_id() != plain.parms_id()))
         {
             throw invalid_argument("encrypted and plain parameter mismatch");
@@ -2208,12 +2691,46 @@ namespace seal
         {
         case scheme_type::BFV:
         {
+            // Adding zero changes neither the ciphertext nor its noise
+            size_t plain_coeff_count = plain.significant_coeff_count();
+            if (!plain_coeff_count)
+            {
+                break;
+            }
+
             auto coeff_div_plain_modulus = context_data.coeff_div_plain_modulus();
             auto plain_upper_half_threshold = context_data.plain_upper_half_threshold();
             auto upper_half_increment = context_data.upper_half_increment();
 
-            for (size_t i = 0; i < plain.coeff_count(); i++)
+            // Every plaintext coefficient is multiplied by the same constants
+            auto coeff_div_plain_modulus_operands(allocate<MultiplyUIntModOperand>(
+                coeff_mod_count, MemoryManager::GetPool()));
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                coeff_div_plain_modulus_operands[j].set(
+                    coeff_div_plain_modulus[j], coeff_modulus[j]);
+            }
+
+            // A ciphertext in NTT form receives the scaled plaintext through
+            // a zeroed buffer that is transformed before being added
+            bool is_ntt_form = encrypted.is_ntt_form();
+            Pointer<uint64_t> scaled_plain;
+            uint64_t *destination = encrypted.data();
+            if (is_ntt_form)
+            {
+                scaled_plain = allocate_zero_poly(coeff_count, coeff_mod_count,
+                    MemoryManager::GetPool());
+                destination = scaled_plain.get();
+            }
+
+            for (size_t i = 0; i < plain_coeff_count; i++)
             {
+                // Zero coefficients of sparse plaintexts contribute nothing
+                if (!plain[i])
+                {
+                    continue;
+                }
+
                 // This is Encryptor::preencrypt changed to subtract instead
                 // Multiply plain by scalar coeff_div_plain_modulus and reposition 
                 // if in upper-half.
@@ -2222,12 +2739,12 @@ namespace seal
                     // Loop over primes
                     for (size_t j = 0; j < coeff_mod_count; j++)
                     {
-                        unsigned long long temp[2]{ 0, 0 };
-                        multiply_uint64(coeff_div_plain_modulus[j], plain[i], temp);
-                        temp[1] += add_uint64(temp[0], upper_half_increment[j], temp);
-                        uint64_t scaled_plain_coeff = barrett_reduce_128(temp, coeff_modulus[j]);
-                        *(encrypted.data() + i + (j * coeff_count)) = sub_uint_uint_mod(
-                            *(encrypted.data() + i + (j * coeff_count)),
+                        uint64_t scaled_plain_coeff = add_uint_uint_mod(
+                            multiply_uint_mod(plain[i], coeff_div_plain_modulus_operands[j],
+                                coeff_modulus[j]),
+                            upper_half_increment[j], coeff_modulus[j]);
+                        destination[i + (j * coeff_count)] = sub_uint_uint_mod(
+                            destination[i + (j * coeff_count)],
                             scaled_plain_coeff, coeff_modulus[j]);
                     }
                 }
@@ -2235,14 +2752,39 @@ namespace seal
                 {
                     for (size_t j = 0; j < coeff_mod_count; j++)
                     {
-                        uint64_t scaled_plain_coeff = multiply_uint_uint_mod(
-                            coeff_div_plain_modulus[j], plain[i], coeff_modulus[j]);
-                        *(encrypted.data() + i + (j * coeff_count)) = sub_uint_uint_mod(
-                            *(encrypted.data() + i + (j * coeff_count)),
+                        uint64_t scaled_plain_coeff = multiply_uint_mod(
+                            plain[i], coeff_div_plain_modulus_operands[j], coeff_modulus[j]);
+                        destination[i + (j * coeff_count)] = sub_uint_uint_mod(
+                            destination[i + (j * coeff_count)],
                             scaled_plain_coeff, coeff_modulus[j]);
                     }
                 }
             }
+
+            if (is_ntt_form)
+            {
+                auto &small_ntt_tables = context_data.small_ntt_tables();
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    // The NTT of a constant, e.g., an all-ones batched mask,
+                    // is the same constant in every coefficient
+                    if (plain_coeff_count == 1)
+                    {
+                        fill_n(destination + (j * coeff_count) + 1, coeff_count - 1,
+                            destination[j * coeff_count]);
+                    }
+                    else
+                    {
+                        ntt_negacyclic_harvey(destination + (j * coeff_count),
+                            small_ntt_tables[j]);
+                    }
+                    add_poly_poly_coeffmod(encrypted.data() + (j * coeff_count),
+                        destination + (j * coeff_count), coeff_count,
+                        coeff_modulus[j], encrypted.data() + (j * coeff_count));
+                }
+            }
+            encrypted.noise_budget() = add_plain_noise_budget(parms,
+                encrypted.noise_budget());
             break;
         }
 
@@ -2294,6 +2836,13 @@ namespace seal
             throw invalid_argument("pool is uninitialized");
         }
 
+        auto &parms = context_->context_data(encrypted.parms_id())->parms();
+        double noise_budget = 0;
+        if (parms.scheme() == scheme_type::BFV)
+        {
+            noise_budget = plain_product_noise_budget(parms, encrypted.noise_budget(), plain);
+        }
+
         if (encrypted.is_ntt_form())
         {
             multiply_plain_ntt(encrypted, plain);
@@ -2302,6 +2851,10 @@ namespace seal
         {
             multiply_plain_normal(encrypted, plain, move(pool));
         }
+        if (parms.scheme() == scheme_type::BFV)
+        {
+            encrypted.noise_budget() = noise_budget;
+        }
 #ifndef SEAL_ALLOW_TRANSPARENT_CIPHERTEXT
         // Transparent ciphertext output is not allowed.
         if (encrypted.is_transparent())
@@ -2326,7 +2879,10 @@ namespace seal
         auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
 
         size_t encrypted_size = encrypted.size();
-        size_t plain_coeff_count = plain.coeff_count();
+
+        // Leading zero coefficients are skipped, so that a plaintext such as an
+        // all-ones batched mask is recognized as a constant
+        size_t plain_coeff_count = plain.significant_coeff_count();
 
         // Size check
         if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count))
@@ -2420,6 +2976,81 @@ namespace seal
             }
         }
 
+        // Multiplying by zero?
+        if (plain_coeff_count == 0)
+        {
+            set_zero_poly(encrypted_size * coeff_mod_count, coeff_count, encrypted.data());
+            return;
+        }
+
+        // Sparse plaintexts are multiplied in one monomial at a time, which is
+        // cheaper than the two NTTs per polynomial of the generic case
+        size_t plain_nonzero_count = static_cast<size_t>(count_if(plain.data(),
+            plain.data() + plain_coeff_count, [](uint64_t coeff) { return coeff != 0; }));
+        if (plain_nonzero_count <= sparse_plain_max_nonzero_count)
+        {
+            // Lift the non-zero coefficients in each qi
+            auto mono_coeffs(allocate<MultiplyUIntModOperand>(
+                plain_nonzero_count * coeff_mod_count, pool));
+            auto mono_exponents(allocate<size_t>(plain_nonzero_count, pool));
+            auto adjusted_coeff(allocate_uint(coeff_mod_count, pool));
+            auto decomposed_coeff(allocate_uint(coeff_mod_count, pool));
+            for (size_t i = 0, k = 0; i < plain_coeff_count; i++)
+            {
+                if (!plain[i])
+                {
+                    continue;
+                }
+                mono_exponents[k] = i;
+                bool is_upper_half = plain[i] >= plain_upper_half_threshold;
+                if (is_upper_half && !context_data.qualifiers().using_fast_plain_lift)
+                {
+                    set_zero_uint(coeff_mod_count, adjusted_coeff.get());
+                    add_uint_uint64(plain_upper_half_increment, plain[i],
+                        coeff_mod_count, adjusted_coeff.get());
+                    decompose_single_coeff(context_data, adjusted_coeff.get(),
+                        decomposed_coeff.get(), pool);
+                }
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    uint64_t lifted_coeff;
+                    if (!is_upper_half)
+                    {
+                        lifted_coeff = plain[i] % coeff_modulus[j].value();
+                    }
+                    else if (context_data.qualifiers().using_fast_plain_lift)
+                    {
+                        lifted_coeff = plain[i] + plain_upper_half_increment[j];
+                    }
+                    else
+                    {
+                        lifted_coeff = decomposed_coeff[j];
+                    }
+                    mono_coeffs[k * coeff_mod_count + j].set(lifted_coeff,
+                        coeff_modulus[j]);
+                }
+                k++;
+            }
+
+            auto temp(allocate_uint(coeff_count, pool));
+            for (size_t i = 0; i < encrypted_size; i++)
+            {
+                uint64_t *encrypted_ptr = encrypted.data(i);
+                for (size_t j = 0; j < coeff_mod_count; j++, encrypted_ptr += coeff_count)
+                {
+                    set_zero_uint(coeff_count, temp.get());
+                    for (size_t k = 0; k < plain_nonzero_count; k++)
+                    {
+                        negacyclic_multiply_poly_mono_add_coeffmod(encrypted_ptr,
+                            coeff_count, mono_coeffs[k * coeff_mod_count + j],
+                            mono_exponents[k], coeff_modulus[j], temp.get());
+                    }
+                    set_uint_uint(temp.get(), coeff_count, encrypted_ptr);
+                }
+            }
+            return;
+        }
+
         // Generic plain case
         auto adjusted_poly(allocate_zero_uint(coeff_count * coeff_mod_count, pool));
         auto decomposed_poly(allocate_uint(coeff_count * coeff_mod_count, pool));
@@ -2548,6 +3179,149 @@ namespace seal
         encrypted_ntt.scale() = new_scale;
     }
 
+    void Evaluator::inner_product_plain(const vector<Ciphertext> &encrypteds,
+        const vector<Plaintext> &plains, Ciphertext &destination,
+        MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        if (encrypteds.empty())
+        {
+            throw invalid_argument("encrypteds cannot be empty");
+        }
+        if (encrypteds.size() != plains.size())
+        {
+            throw invalid_argument("encrypteds and plains size mismatch");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        auto parms_id = encrypteds[0].parms_id();
+        bool is_ntt_form = encrypteds[0].is_ntt_form();
+        double new_scale = encrypteds[0].scale() * plains[0].scale();
+        size_t dest_count = 0;
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            if (!encrypteds[i].is_metadata_valid_for(context_))
+            {
+                throw invalid_argument("encrypteds is not valid for encryption parameters");
+            }
+            if (!plains[i].is_valid_for(context_))
+            {
+                throw invalid_argument("plains is not valid for encryption parameters");
+            }
+            if (encrypteds[i].parms_id() != parms_id)
+            {
+                throw invalid_argument("encrypteds parameter mismatch");
+            }
+            if (encrypteds[i].is_ntt_form() != is_ntt_form ||
+                plains[i].is_ntt_form() != is_ntt_form)
+            {
+                throw invalid_argument("NTT form mismatch");
+            }
+            if (is_ntt_form && plains[i].parms_id() != parms_id)
+            {
+                throw invalid_argument("encrypted_ntt and plain_ntt parameter mismatch");
+            }
+            if (!are_close<double>(encrypteds[i].scale() * plains[i].scale(), new_scale))
+            {
+                throw invalid_argument("scale mismatch");
+            }
+            dest_count = max(dest_count, encrypteds[i].size());
+        }
+
+        // Extract encryption parameters.
+        auto &context_data = *context_->context_data(parms_id);
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
+
+        // Check that scale is positive and not too large
+        if (new_scale <= 0 || (static_cast<int>(log2(new_scale)) >=
+            context_data.total_coeff_modulus_bit_count()))
+        {
+            throw invalid_argument("scale out of bounds");
+        }
+
+        // Size check
+        if (!product_fits_in(dest_count, coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        ProductAccumulator accumulator(dest_count, coeff_count, 
+            coeff_modulus.data(), coeff_mod_count, pool);
+        auto encrypted_ntt(allocate_poly(coeff_count, coeff_mod_count, pool));
+        Plaintext plain_ntt(pool);
+        double noise_budget = 0;
+        for (size_t k = 0; k < encrypteds.size(); k++)
+        {
+            auto &encrypted = encrypteds[k];
+            if (parms.scheme() == scheme_type::BFV)
+            {
+                // The products are summed, so their noises add up
+                double product_noise_budget = plain_product_noise_budget(parms,
+                    encrypted.noise_budget(), plains[k]);
+                noise_budget = k ? add_noise_budgets(noise_budget, product_noise_budget) :
+                    product_noise_budget;
+            }
+            const uint64_t *plain_ptr = plains[k].data();
+            if (!is_ntt_form)
+            {
+                // Lift and transform the plaintext as in multiply_plain_normal
+                transform_to_ntt(plains[k], parms_id, plain_ntt, pool);
+                plain_ptr = plain_ntt.data();
+            }
+
+            accumulator.reserve(1);
+            for (size_t i = 0; i < encrypted.size(); i++)
+            {
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    const uint64_t *encrypted_ptr = encrypted.data(i) + (j * coeff_count);
+                    if (!is_ntt_form)
+                    {
+                        set_uint_uint(encrypted_ptr, coeff_count, encrypted_ntt.get());
+                        ntt_negacyclic_harvey(encrypted_ntt.get(), coeff_small_ntt_tables[j]);
+                        encrypted_ptr = encrypted_ntt.get();
+                    }
+                    accumulator.accumulate(i, j, encrypted_ptr, 
+                        plain_ptr + (j * coeff_count));
+                }
+            }
+        }
+
+        // Reduce once and set the result; compute into a temporary so that 
+        // destination may alias an input
+        Ciphertext result(context_, parms_id, dest_count, pool);
+        result.resize(dest_count);
+        for (size_t i = 0; i < dest_count; i++)
+        {
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                uint64_t *result_ptr = result.data(i) + (j * coeff_count);
+                accumulator.get(i, j, result_ptr);
+                if (!is_ntt_form)
+                {
+                    inverse_ntt_negacyclic_harvey(result_ptr, coeff_small_ntt_tables[j]);
+                }
+            }
+        }
+        result.is_ntt_form() = is_ntt_form;
+        result.scale() = new_scale;
+        result.noise_budget() = noise_budget;
+        destination = move(result);
+#ifndef SEAL_ALLOW_TRANSPARENT_CIPHERTEXT
+        // Transparent ciphertext output is not allowed.
+        if (destination.is_transparent())
+        {
+            throw logic_error("result ciphertext is transparent");
+        }
+#endif
+    }
+
     void Evaluator::transform_to_ntt_inplace(Plaintext &plain, 
         parms_id_type parms_id, MemoryPoolHandle pool)
     {
@@ -2773,10 +3547,6 @@ namespace seal
         {
             throw invalid_argument("parameter mismatch");
         }
-        if (parms.scheme() == scheme_type::BFV && encrypted.is_ntt_form())
-        {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
-        }
         if (parms.scheme() == scheme_type::CKKS && !encrypted.is_ntt_form())
         {
             throw invalid_argument("CKKS encrypted must be in NTT form");
@@ -2791,6 +3561,7 @@ namespace seal
         size_t coeff_count = parms.poly_modulus_degree();
         size_t coeff_mod_count = coeff_modulus.size();
         size_t encrypted_size = encrypted.size();
+        bool is_ntt_form = encrypted.is_ntt_form();
 
         // Size check
         if (!product_fits_in(coeff_count, coeff_mod_count))
@@ -2800,7 +3571,6 @@ namespace seal
 
         uint64_t m = mul_safe(static_cast<uint64_t>(coeff_count), uint64_t(2));
         uint64_t subgroup_size = static_cast<uint64_t>(coeff_count >> 1);
-        int n_power_of_two = get_power_of_two(static_cast<uint64_t>(coeff_count));
 
         // Verify parameters
         if (!(galois_elt & 1) || unsigned_geq(galois_elt, m))
@@ -2871,32 +3641,21 @@ namespace seal
         auto temp0(allocate_zero_uint(coeff_count * coeff_mod_count, pool));
         auto temp1(allocate_zero_uint(coeff_count * coeff_mod_count, pool));
 
-        if (parms.scheme() == scheme_type::BFV)
+        if (is_ntt_form)
         {
-            // Apply Galois for each ciphertext
+            // Apply Galois for each ciphertext with the cached permutation; ct[0]
+            // stays in NTT form and only ct[1] needs to be transformed for the 
+            // decomposition in key switching
+            auto &permutation = context_->galois_ntt_permutation(galois_elt);
             for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                util::apply_galois(encrypted.data() + (i * coeff_count), n_power_of_two,
-                    galois_elt, coeff_modulus[i], temp0.get() + (i * coeff_count));
+                util::apply_galois_ntt(encrypted.data() + (i * coeff_count), coeff_count,
+                    permutation.data(), temp0.get() + (i * coeff_count));
             }
             for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                util::apply_galois(encrypted.data(1) + (i * coeff_count), n_power_of_two,
-                    galois_elt, coeff_modulus[i], temp1.get() + (i * coeff_count));
-            }
-        }
-        else if (parms.scheme() == scheme_type::CKKS)
-        {
-            // Apply Galois for each ciphertext
-            for (size_t i = 0; i < coeff_mod_count; i++)
-            {
-                util::apply_galois_ntt(encrypted.data() + (i * coeff_count), n_power_of_two,
-                    galois_elt, temp0.get() + (i * coeff_count));
-            }
-            for (size_t i = 0; i < coeff_mod_count; i++)
-            {
-                util::apply_galois_ntt(encrypted.data(1) + (i * coeff_count), n_power_of_two,
-                    galois_elt, temp1.get() + (i * coeff_count));
+                util::apply_galois_ntt(encrypted.data(1) + (i * coeff_count), coeff_count,
+                    permutation.data(), temp1.get() + (i * coeff_count));
             }
 
             // Transform ct[1] from NTT
@@ -2908,143 +3667,44 @@ namespace seal
         }
         else
         {
-            throw logic_error("scheme not implemented");
-        }
-
-        // Calculate (temp1 * galois_key.first, temp1 * galois_key.second) + (temp0, 0)
-        const uint64_t *encrypted_coeff = temp1.get();
-
-        // decompose encrypted_array[count-1] into base w
-        // want to create an array of polys, each of whose components i is
-        // (encrypted_array[count-1])^(i) - in the notation of FV paper.
-        // This allocation stores one of the decomposed factors modulo one of the primes.
-        auto decomp_encrypted_last(allocate_uint(coeff_count, pool));
-
-        // Lazy reduction
-        auto wide_innerresult0(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto wide_innerresult1(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
-        auto temp_decomp_coeff(allocate_uint(coeff_count, pool));
-
-        /*
-        For lazy reduction to work here, we need to ensure that the 128-bit accumulators
-        (wide_innerresult0 and wide_innerresult1) do not overflow. Since the modulus primes
-        are at most 60 bits, if the total number of summands is K, then the size of the
-        total sum of products (without reduction) is at most 62 + 60 + bit_length(K).
-        We need this to be at most 128, thus we need bit_length(K) <= 6. Thus, we need K <= 63.
-        In this case, this means sum_i galois_keys.key(galois_elt)[i].size() / 2 <= 63.
-        */
-        for (size_t i = 0; i < coeff_mod_count; i++, encrypted_coeff += coeff_count)
-        {
-            // We use HPS improvement to Bajard's RNS key switching so scaling by q_i/q not needed
-            // multiply_poly_scalar_coeffmod(
-            //     encrypted_coeff, coeff_count,
-            //     inv_coeff_products_mod_coeff_array[i], coeff_modulus[i],
-            //     encrypted_coeff_prod_inv_coeff.get());
-
-            int shift = 0;
-            auto &key_component_ref = galois_keys.key(galois_elt)[i];
-            size_t keys_size = key_component_ref.size();
-            for (size_t k = 0; k < keys_size; k += 2)
-            {
-                const uint64_t *key_ptr_0 = key_component_ref.data(k);
-                const uint64_t *key_ptr_1 = key_component_ref.data(k + 1);
-
-                // Decompose here
-                int decomposition_bit_count = galois_keys.decomposition_bit_count();
-                for (size_t coeff_index = 0; coeff_index < coeff_count; coeff_index++)
-                {
-                    decomp_encrypted_last[coeff_index] = 
-                        encrypted_coeff[coeff_index] >> shift;
-                    decomp_encrypted_last[coeff_index] &= 
-                        (uint64_t(1) << decomposition_bit_count) - 1;
-                }
-
-                uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
-                uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
-                for (size_t j = 0; j < coeff_mod_count; j++)
-                {
-                    uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    set_uint_uint(decomp_encrypted_last.get(), coeff_count, temp_decomp_coeff_ptr);
-
-                    // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
-                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, coeff_small_ntt_tables[j]);
-
-                    // Lazy reduction
-                    unsigned long long wide_innerproduct[2];
-                    unsigned long long temp;
-                    for (size_t l = 0; l < coeff_count; l++, wide_innerresult0_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_0++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult0_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult0_ptr[0] = temp;
-                        wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
-                    }
-
-                    temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    for (size_t l = 0; l < coeff_count; l++, wide_innerresult1_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_1++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult1_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult1_ptr[0] = temp;
-                        wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
-                    }
-                }
-                shift += decomposition_bit_count;
-            }
-        }
-
-        uint64_t *temp_ptr = temp0.get();
-        uint64_t *innerresult_poly_ptr = innerresult.get();
-        uint64_t *wide_innerresult_poly_ptr = wide_innerresult0.get();
-        uint64_t *encrypted_ptr = encrypted.data();
-        uint64_t *innerresult_coeff_ptr = innerresult_poly_ptr;
-        uint64_t *wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count,
-            temp_ptr += coeff_count)
-        {
-            for (size_t k = 0; k < coeff_count; 
-                k++, wide_innerresult_coeff_ptr += 2, innerresult_coeff_ptr++)
+            // Apply Galois for each ciphertext
+            auto &permutation = context_->galois_permutation(galois_elt);
+            for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                *innerresult_coeff_ptr = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
+                util::apply_galois(encrypted.data() + (i * coeff_count), coeff_count,
+                    permutation.data(), coeff_modulus[i], temp0.get() + (i * coeff_count));
             }
-            if (parms.scheme() == scheme_type::BFV)
+            for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, 
-                    coeff_small_ntt_tables[i]);
+                util::apply_galois(encrypted.data(1) + (i * coeff_count), coeff_count,
+                    permutation.data(), coeff_modulus[i], temp1.get() + (i * coeff_count));
             }
-            add_poly_poly_coeffmod(temp_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
         }
 
-        innerresult_poly_ptr = innerresult.get();
-        wide_innerresult_poly_ptr = wide_innerresult1.get();
-        encrypted_ptr = encrypted.data(1);
-        wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
+        // Calculate (temp1 * galois_key.first, temp1 * galois_key.second) + (temp0, 0)
+        auto innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
+        switch_key_accumulate(temp1.get(), galois_keys.key(galois_elt),
+            galois_keys.decomposition_bit_count(), context_data, 
+            innerresult.get(), encrypted.data(1), pool);
+        if (parms.scheme() == scheme_type::BFV)
         {
-            innerresult_coeff_ptr = encrypted_ptr;
-            for (size_t k = 0; k < coeff_count; 
-                k++, wide_innerresult_coeff_ptr += 2, innerresult_coeff_ptr++)
-            {
-                *innerresult_coeff_ptr = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
-            }
-            if (parms.scheme() == scheme_type::BFV)
-            {
-                inverse_ntt_negacyclic_harvey(encrypted_ptr, coeff_small_ntt_tables[i]);
-            }
+            encrypted.noise_budget() = key_switch_noise_budget(parms,
+                encrypted.noise_budget(), galois_keys.decomposition_bit_count(),
+                key_switch_digit_count(galois_keys.key(galois_elt), coeff_mod_count));
         }
 
-        // If CKKS, mark encrypted as NTT form
-        if (parms.scheme() == scheme_type::CKKS)
+        for (size_t i = 0; i < coeff_mod_count; i++)
         {
-            encrypted.is_ntt_form() = true;
+            uint64_t *innerresult_ptr = innerresult.get() + (i * coeff_count);
+            uint64_t *encrypted0_ptr = encrypted.data() + (i * coeff_count);
+            uint64_t *encrypted1_ptr = encrypted.data(1) + (i * coeff_count);
+            if (!is_ntt_form)
+            {
+                inverse_ntt_negacyclic_harvey(innerresult_ptr, coeff_small_ntt_tables[i]);
+                inverse_ntt_negacyclic_harvey(encrypted1_ptr, coeff_small_ntt_tables[i]);
+            }
+            add_poly_poly_coeffmod(temp0.get() + (i * coeff_count), innerresult_ptr, 
+                coeff_count, coeff_modulus[i], encrypted0_ptr);
         }
 #ifndef SEAL_ALLOW_TRANSPARENT_CIPHERTEXT
         // Transparent ciphertext output is not allowed.
@@ -81,6 +81,14 @@ namespace seal
     and transform_from_ntt functions, which change the state. Ideally, unless these 
     two functions are called, all other functions should "just work".
 
+    BFV ciphertexts can also be kept in NTT form across additions, plaintext 
+    multiplications with NTT form plaintexts, add_plain and sub_plain with normal 
+    plaintexts, relinearization, rotations and modulus switching, all of which 
+    then avoid transforming the ciphertext back and forth. Multiplying such 
+    ciphertexts transforms them out of NTT form first, and the result is in the 
+    usual coefficient representation. Decryption accepts BFV ciphertexts in 
+    either form.
+
     @see EncryptionParameters for more details on encryption parameters.
     @see BatchEncoder for more details on batching
     @see RelinKeys for more details on relinearization keys.
@@ -236,8 +244,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for the
         encryption parameters
-        @throws std::invalid_argument if encrypted1 or encrypted2 is not in the default
-        NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted1 or
+        encrypted2 is not in NTT form
         @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
         is too large for the encryption parameters
         @throws std::invalid_argument if pool is uninitialized
@@ -258,8 +266,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for the
         encryption parameters
-        @throws std::invalid_argument if encrypted1 or encrypted2 is not in the default
-        NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted1 or
+        encrypted2 is not in NTT form
         @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
         is too large for the encryption parameters
         @throws std::invalid_argument if pool is uninitialized
@@ -289,7 +297,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted is not valid for the encryption
         parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
         is too large for the encryption parameters
         @throws std::invalid_argument if pool is uninitialized
@@ -309,7 +318,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted is not valid for the encryption
         parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
         is too large for the encryption parameters
         @throws std::invalid_argument if pool is uninitialized
@@ -334,7 +344,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted or relin_keys is not valid for the
         encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if relin_keys do not correspond to the top level
         parameters in the current context
         @throws std::invalid_argument if the size of relin_keys is too small
@@ -360,7 +371,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted or relin_keys is not valid for the
         encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if relin_keys do not correspond to the top level
         parameters in the current context
         @throws std::invalid_argument if the size of relin_keys is too small
@@ -385,7 +397,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @param[out] destination The ciphertext to overwrite with the modulus switched result
         @throws std::invalid_argument if encrypted is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if encrypted is already at lowest level
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if, when using scheme_type::CKKS, the scale is too 
@@ -404,7 +417,8 @@ namespace seal
         @param[in] encrypted The ciphertext to be switched to a smaller modulus
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if encrypted is already at lowest level
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if, when using scheme_type::CKKS, the scale is too
@@ -469,7 +483,8 @@ namespace seal
         @param[in] parms_id The target parms_id
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if parms_id is not valid for the encryption parameters
         @throws std::invalid_argument if encrypted is already at lower level in modulus chain
         than the parameters corresponding to parms_id
@@ -493,7 +508,8 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the modulus switched result
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if parms_id is not valid for the encryption parameters
         @throws std::invalid_argument if encrypted is already at lower level in modulus chain
         than the parameters corresponding to parms_id
@@ -510,6 +526,102 @@ namespace seal
             mod_switch_to_inplace(destination, parms_id, std::move(pool));
         }
 
+        /**
+        Switches a BFV ciphertext down the modulus switching chain to the lowest 
+        level at which it still decrypts correctly, given its remaining invariant 
+        noise budget. Every switch adds rounding noise that grows as the modulus 
+        shrinks, so the ciphertext stops at the last level whose estimated noise 
+        budget stays positive. Compacting results this way before saving them or 
+        decrypting them makes both considerably cheaper. Dynamic memory allocations 
+        in the process are allocated from the memory pool pointed to by the given 
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to be switched to a smaller modulus
+        @param[in] noise_budget The remaining invariant noise budget of encrypted in
+        bits, as reported by Decryptor::invariant_noise_budget or a lower bound of it
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if noise_budget is negative
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void mod_switch_to_lowest_inplace(Ciphertext &encrypted, int noise_budget,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Switches a BFV ciphertext down the modulus switching chain to the lowest 
+        level at which it still decrypts correctly, given its remaining invariant 
+        noise budget, and stores the result in the destination parameter. Dynamic 
+        memory allocations in the process are allocated from the memory pool pointed 
+        to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to be switched to a smaller modulus
+        @param[in] noise_budget The remaining invariant noise budget of encrypted in
+        bits, as reported by Decryptor::invariant_noise_budget or a lower bound of it
+        @param[out] destination The ciphertext to overwrite with the modulus switched result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if noise_budget is negative
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void mod_switch_to_lowest(const Ciphertext &encrypted, int noise_budget,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            destination = encrypted;
+            mod_switch_to_lowest_inplace(destination, noise_budget, std::move(pool));
+        }
+
+        /**
+        Switches a BFV ciphertext down the modulus switching chain to the lowest
+        level at which it still decrypts correctly, using the noise budget estimate
+        tracked in the ciphertext instead of a measured one. This needs no secret
+        key, so it can run where the computation happens. Dynamic memory allocations
+        in the process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to be switched to a smaller modulus
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void mod_switch_to_lowest_inplace(Ciphertext &encrypted,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            mod_switch_to_lowest_inplace(encrypted,
+                static_cast<int>(encrypted.noise_budget()), std::move(pool));
+        }
+
+        /**
+        Switches a BFV ciphertext down the modulus switching chain to the lowest
+        level at which it still decrypts correctly, using the noise budget estimate
+        tracked in the ciphertext, and stores the result in the destination
+        parameter. Dynamic memory allocations in the process are allocated from the
+        memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to be switched to a smaller modulus
+        @param[out] destination The ciphertext to overwrite with the modulus switched result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypted is not valid for the encryption parameters
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        inline void mod_switch_to_lowest(const Ciphertext &encrypted,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            destination = encrypted;
+            mod_switch_to_lowest_inplace(destination, std::move(pool));
+        }
+
         /**
         Given an NTT transformed plaintext modulo q_1...q_k, this function switches 
         the modulus down until the parameters reach the given parms_id.
@@ -660,7 +772,6 @@ namespace seal
         @throws std::invalid_argument if encrypteds is empty
         @throws std::invalid_argument if the ciphertexts or relin_keys are not valid for
         the encryption parameters
-        @throws std::invalid_argument if encrypteds are not in the default NTT form
         @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
         is too large for the encryption parameters
         @throws std::invalid_argument if the size of relin_keys is too small
@@ -671,6 +782,48 @@ namespace seal
             const RelinKeys &relin_keys, Ciphertext &destination,
             MemoryPoolHandle pool = MemoryManager::GetPool());
 
+        /**
+        Computes the inner product of two vectors of ciphertexts, i.e., the sum of
+        the products encrypteds1[i] * encrypteds2[i], and stores the result in the
+        destination parameter. The products are accumulated in NTT form without
+        modular reduction, and the sum is reduced and relinearized only once at the
+        end. This is faster and adds less noise than multiplying, relinearizing and
+        adding term by term. Dynamic memory allocations in the process are allocated
+        from the memory pool pointed to by the given MemoryPoolHandle.
+
+        With the BFV scheme the sum is also scaled down only once, which limits the
+        number of terms. The product of n = poly_modulus_degree, the number of terms
+        and the number of cross terms of each product (2 for fresh ciphertexts) must
+        stay below the headroom of the base used for scaling, which is at least
+        about 2^32. With n = 8192 this allows at least about 2^18 terms of fresh
+        ciphertexts.
+
+        @param[in] encrypteds1 The first vector of ciphertexts
+        @param[in] encrypteds2 The second vector of ciphertexts
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the inner product
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds1 is empty
+        @throws std::invalid_argument if encrypteds1 and encrypteds2 have different
+        sizes
+        @throws std::invalid_argument if, when using scheme_type::BFV, there are too
+        many terms for the encryption parameters
+        @throws std::invalid_argument if the ciphertexts or relin_keys are not valid
+        for the encryption parameters
+        @throws std::invalid_argument if the ciphertexts are at different levels
+        @throws std::invalid_argument if the ciphertexts are not in the default NTT
+        form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the products
+        have different scales or the output scale is too large for the encryption
+        parameters
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void inner_product(const std::vector<Ciphertext> &encrypteds1,
+            const std::vector<Ciphertext> &encrypteds2, const RelinKeys &relin_keys,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool());
+
         /**
         Exponentiates a ciphertext. This functions raises encrypted to a power. 
         Dynamic memory allocations in the process are allocated from the memory 
@@ -686,7 +839,8 @@ namespace seal
         @throws std::logic_error if scheme is not scheme_type::BFV
         @throws std::invalid_argument if encrypted or relin_keys is not valid for the
         encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
         is too large for the encryption parameters
         @throws std::invalid_argument if exponent is zero
@@ -714,7 +868,8 @@ namespace seal
         @throws std::logic_error if scheme is not scheme_type::BFV
         @throws std::invalid_argument if encrypted or relin_keys is not valid for the
         encryption parameters
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted is
+        not in NTT form
         @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
         is too large for the encryption parameters
         @throws std::invalid_argument if exponent is zero
@@ -738,7 +893,10 @@ namespace seal
         @param[in] plain The plaintext to add
         @throws std::invalid_argument if encrypted or plain is not valid for the 
         encryption parameters
-        @throws std::invalid_argument if encrypted or plain is in NTT form
+        @throws std::invalid_argument if, when using scheme_type::BFV, plain is in NTT
+        form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted or
+        plain is not in NTT form
         @throws std::logic_error if result ciphertext is transparent
         */
         void add_plain_inplace(Ciphertext &encrypted, const Plaintext &plain);
@@ -753,7 +911,10 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the addition result
         @throws std::invalid_argument if encrypted or plain is not valid for the 
         encryption parameters
-        @throws std::invalid_argument if encrypted or plain is in NTT form
+        @throws std::invalid_argument if, when using scheme_type::BFV, plain is in NTT
+        form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted or
+        plain is not in NTT form
         @throws std::logic_error if result ciphertext is transparent
         */
         inline void add_plain(const Ciphertext &encrypted, const Plaintext &plain,
@@ -771,7 +932,10 @@ namespace seal
         @param[in] plain The plaintext to subtract
         @throws std::invalid_argument if encrypted or plain is not valid for the 
         encryption parameters
-        @throws std::invalid_argument if encrypted or plain is in NTT form
+        @throws std::invalid_argument if, when using scheme_type::BFV, plain is in NTT
+        form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted or
+        plain is not in NTT form
         @throws std::logic_error if result ciphertext is transparent
         */
         void sub_plain_inplace(Ciphertext &encrypted, const Plaintext &plain);
@@ -786,7 +950,10 @@ namespace seal
         @param[out] destination The ciphertext to overwrite with the subtraction result
         @throws std::invalid_argument if encrypted or plain is not valid for the 
         encryption parameters
-        @throws std::invalid_argument if encrypted or plain is in NTT form
+        @throws std::invalid_argument if, when using scheme_type::BFV, plain is in NTT
+        form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted or
+        plain is not in NTT form
         @throws std::logic_error if result ciphertext is transparent
         */
         inline void sub_plain(const Ciphertext &encrypted, const Plaintext &plain,
@@ -844,6 +1011,35 @@ namespace seal
             multiply_plain_inplace(destination, plain, std::move(pool));
         }
 
+        /**
+        Computes the inner product of a vector of ciphertexts and a vector of
+        plaintexts, i.e., the sum of the products encrypteds[i] * plains[i], and
+        stores the result in the destination parameter. The products are accumulated
+        in NTT form without modular reduction, and the sum is reduced once at the
+        end. Dynamic memory allocations in the process are allocated from the memory
+        pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypteds The ciphertexts to multiply
+        @param[in] plains The plaintexts to multiply
+        @param[out] destination The ciphertext to overwrite with the inner product
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds is empty
+        @throws std::invalid_argument if encrypteds and plains have different sizes
+        @throws std::invalid_argument if the ciphertexts or plaintexts are not valid
+        for the encryption parameters
+        @throws std::invalid_argument if the ciphertexts are at different levels
+        @throws std::invalid_argument if a ciphertext and the corresponding plaintext
+        are in different NTT forms
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the products
+        have different scales or the output scale is too large for the encryption
+        parameters
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void inner_product_plain(const std::vector<Ciphertext> &encrypteds,
+            const std::vector<Plaintext> &plains, Ciphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
         /**
         Transforms a plaintext to NTT domain. This functions applies the Number 
         Theoretic Transform to a plaintext by first embedding integers modulo the 
@@ -976,6 +1172,10 @@ namespace seal
         In the polynomial view (not batching), a Galois automorphism by a Galois 
         element p changes Enc(plain(x)) to Enc(plain(x^p)).
 
+        A BFV ciphertext may also be in NTT form, in which case the automorphism
+        is applied directly to the NTT representation with a permutation cached in
+        the SEALContext, and the result stays in NTT form.
+
         @param[in] encrypted The ciphertext to apply the Galois automorphism to
         @param[in] galois_elt The Galois element
         @param[in] galois_keys The Galois keys
@@ -984,7 +1184,8 @@ namespace seal
         the encryption parameters
         @throws std::invalid_argument if galois_keys do not correspond to the top 
         level parameters in the current context
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if the scheme is scheme_type::CKKS and 
+        encrypted is not in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if the Galois element is not valid
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1011,6 +1212,10 @@ namespace seal
         In the polynomial view (not batching), a Galois automorphism by a Galois 
         element p changes Enc(plain(x)) to Enc(plain(x^p)).
 
+        A BFV ciphertext may also be in NTT form, in which case the automorphism
+        is applied directly to the NTT representation with a permutation cached in
+        the SEALContext, and the result stays in NTT form.
+
         @param[in] encrypted The ciphertext to apply the Galois automorphism to
         @param[in] galois_elt The Galois element
         @param[in] galois_keys The Galois keys
@@ -1020,7 +1225,8 @@ namespace seal
         the encryption parameters
         @throws std::invalid_argument if galois_keys do not correspond to the top 
         level parameters in the current context
-        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if the scheme is scheme_type::CKKS and 
+        encrypted is not in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if the Galois element is not valid
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1056,7 +1262,6 @@ namespace seal
         the encryption parameters
         @throws std::invalid_argument if galois_keys do not correspond to the top 
         level parameters in the current context
-        @throws std::invalid_argument if encrypted is not in the default NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if steps has too big absolute value
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1095,7 +1300,6 @@ namespace seal
         the encryption parameters
         @throws std::invalid_argument if galois_keys do not correspond to the top 
         level parameters in the current context
-        @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if steps has too big absolute value
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1129,7 +1333,6 @@ namespace seal
         the encryption parameters
         @throws std::invalid_argument if galois_keys do not correspond to the top 
         level parameters in the current context
-        @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if necessary Galois keys are not present
         @throws std::invalid_argument if pool is uninitialized
@@ -1165,7 +1368,6 @@ namespace seal
         the encryption parameters
         @throws std::invalid_argument if galois_keys do not correspond to the top 
         level parameters in the current context
-        @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if necessary Galois keys are not present
         @throws std::invalid_argument if pool is uninitialized
@@ -1197,7 +1399,6 @@ namespace seal
         the encryption parameters
         @throws std::invalid_argument if galois_keys do not correspond to the top 
         level parameters in the current context
-        @throws std::invalid_argument if encrypted is not in the default NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if steps has too big absolute value
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1328,6 +1529,14 @@ namespace seal
 
         void bfv_square(Ciphertext &encrypted, MemoryPoolHandle pool);
 
+        void bfv_inner_product(const std::vector<Ciphertext> &encrypteds1,
+            const std::vector<Ciphertext> &encrypteds2, Ciphertext &destination,
+            MemoryPoolHandle pool);
+
+        void ckks_inner_product(const std::vector<Ciphertext> &encrypteds1,
+            const std::vector<Ciphertext> &encrypteds2, Ciphertext &destination,
+            MemoryPoolHandle pool);
+
         void ckks_square(Ciphertext &encrypted, MemoryPoolHandle pool);
 
         void relinearize_internal(Ciphertext &encrypted, const RelinKeys &relin_keys,
@@ -1477,6 +1686,13 @@ namespace seal
             const SEALContext::ContextData &context_data,
             const RelinKeys &relin_keys, util::MemoryPool &pool);
 
+        // Computes the inner products of the base-w decomposition of target with 
+        // the two components of key_vector, reduced and in NTT form
+        void switch_key_accumulate(const std::uint64_t *target, 
+            const std::vector<Ciphertext> &key_vector, int decomposition_bit_count,
+            const SEALContext::ContextData &context_data, std::uint64_t *result0,
+            std::uint64_t *result1, util::MemoryPool &pool);
+
         void multiply_plain_normal(Ciphertext &encrypted, const Plaintext &plain,
             util::MemoryPool &pool);
 
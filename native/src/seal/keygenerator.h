@@ -145,6 +145,30 @@ namespace seal
         */
         GaloisKeys galois_keys(int decomposition_bit_count);
 
+        /**
+        Sets the number of threads used to generate relinearization keys and 
+        Galois keys. Decomposition digits and Galois elements are then processed 
+        in parallel. All randomness is still drawn in the same order, so for a 
+        fixed random generator the generated keys are identical regardless of 
+        the thread count. A value of zero means to use as many threads as the 
+        hardware supports. The default is one.
+
+        @param[in] thread_count The number of threads to use
+        */
+        inline void set_thread_count(std::size_t thread_count) noexcept
+        {
+            thread_count_ = thread_count;
+        }
+
+        /**
+        Returns the number of threads used to generate relinearization keys and 
+        Galois keys.
+        */
+        inline std::size_t thread_count() const noexcept
+        {
+            return thread_count_;
+        }
+
     private:
         KeyGenerator(const KeyGenerator &copy) = delete;
 
@@ -205,5 +229,7 @@ namespace seal
         bool sk_generated_ = false;
 
         bool pk_generated_ = false;
+
+        std::size_t thread_count_ = 1;
     };
 }
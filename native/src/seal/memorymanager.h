@@ -6,9 +6,11 @@
 #include <memory>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 #include <unordered_map>
 #include "seal/util/mempool.h"
 #include "seal/util/globals.h"
+#include "seal/util/common.h"
 
 /*
 For .NET Framework wrapper support (C++/CLI) we need to 
@@ -163,15 +165,28 @@ namespace seal
 #endif
         /**
         Returns a MemoryPoolHandle pointing to a new thread-safe memory pool.
+        Optionally the memory pool can be given a capacity: whenever the pool 
+        needs to allocate more memory and its total allocation exceeds the 
+        capacity, the memory of allocation sizes that have no memory in use is 
+        released, least recently used first, until the pool is back within the 
+        capacity. Memory that is in use is never released, so the capacity is a 
+        soft limit.
 
         @param[in] clear_on_destruction Indicates whether the memory pool data 
         should be cleared when destroyed. This can be important when memory pools 
         are used to store private data.
+        @param[in] capacity_byte_count The capacity of the memory pool in bytes, 
+        or zero for an unbounded memory pool
+        @param[in] huge_pages Indicates whether allocations of at least one huge 
+        page (2 MB) should be backed by huge pages bound to the NUMA node of the 
+        allocating thread. This has no effect on platforms without huge page 
+        support.
         */
-        inline static MemoryPoolHandle New(bool clear_on_destruction = false) 
+        inline static MemoryPoolHandle New(bool clear_on_destruction = false,
+            std::size_t capacity_byte_count = 0, bool huge_pages = false) 
         {
-            return MemoryPoolHandle(
-                std::make_shared<util::MemoryPoolMT>(clear_on_destruction));
+            return MemoryPoolHandle(std::make_shared<util::MemoryPoolMT>(
+                clear_on_destruction, capacity_byte_count, huge_pages));
         }
 
         /**
@@ -225,6 +240,114 @@ namespace seal
             return pool_->alloc_byte_count();
         }
 
+        /**
+        Returns the capacity of the memory pool in bytes, or zero if the memory 
+        pool pointed to by the current MemoryPoolHandle is unbounded.
+
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        */
+        inline std::size_t capacity_byte_count() const
+        {
+            if (!pool_)
+            {
+                throw std::logic_error("pool not initialized");
+            }
+            return pool_->capacity_byte_count();
+        }
+
+        /**
+        Returns whether the memory pool pointed to by the current MemoryPoolHandle 
+        backs large allocations with NUMA-local huge pages.
+
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        */
+        inline bool huge_pages() const
+        {
+            if (!pool_)
+            {
+                throw std::logic_error("pool not initialized");
+            }
+            return pool_->huge_pages();
+        }
+
+        /**
+        Releases unused memory. This function releases the memory of allocation
+        sizes that have no memory in use, least recently used first, until the 
+        total amount of memory allocated by the memory pool pointed to by the 
+        current MemoryPoolHandle is at most target_byte_count, or until no such 
+        allocation sizes remain. By default all unused allocation sizes are 
+        released. Returns the number of bytes released.
+
+        @param[in] target_byte_count The allocation size (in bytes) to trim to
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        */
+        inline std::size_t trim(std::size_t target_byte_count = 0)
+        {
+            if (!pool_)
+            {
+                throw std::logic_error("pool not initialized");
+            }
+            return pool_->trim(target_byte_count);
+        }
+
+        /**
+        Returns usage statistics for each allocation size. This function returns
+        one entry per allocation size the memory pool pointed to by the current
+        MemoryPoolHandle has made, ordered by decreasing item size. Each entry
+        reports the total number of items allocated, the number of items currently
+        in use, the largest number of items that have been in use at the same
+        time, and the number of failed allocations.
+
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        */
+        inline std::vector<util::MemoryPoolStats> pool_stats() const
+        {
+            if (!pool_)
+            {
+                throw std::logic_error("pool not initialized");
+            }
+            return pool_->stats();
+        }
+
+        /**
+        Returns the size of memory currently in use. This function returns the
+        total amount of memory (in bytes) that has been handed out by the memory 
+        pool pointed to by the current MemoryPoolHandle and not yet returned.
+
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        */
+        inline std::size_t in_use_byte_count() const
+        {
+            std::size_t byte_count = 0;
+            for (const auto &size_stats : pool_stats())
+            {
+                byte_count = util::add_safe(byte_count, util::mul_safe(
+                    size_stats.in_use_item_count, size_stats.item_byte_count));
+            }
+            return byte_count;
+        }
+
+        /**
+        Returns the peak size of memory in use. This function returns the sum 
+        over all allocation sizes of the largest amount of memory (in bytes) that 
+        has been in use at the same time from the memory pool pointed to by the 
+        current MemoryPoolHandle. Since the peaks for different allocation sizes 
+        need not occur simultaneously, this is an upper bound on the true peak
+        footprint of the memory pool.
+
+        @throws std::logic_error if the MemoryPoolHandle is uninitialized
+        */
+        inline std::size_t peak_in_use_byte_count() const
+        {
+            std::size_t byte_count = 0;
+            for (const auto &size_stats : pool_stats())
+            {
+                byte_count = util::add_safe(byte_count, util::mul_safe(
+                    size_stats.peak_in_use_item_count, size_stats.item_byte_count));
+            }
+            return byte_count;
+        }
+
         /**
         Returns whether the MemoryPoolHandle is initialized.
         */
@@ -411,6 +534,53 @@ namespace seal
     private:
         MemoryPoolHandle pool_;
     };
+
+    /**
+    A memory manager profile that always returns a MemoryPoolHandle pointing to 
+    a thread-safe memory pool whose large allocations are backed by 2 MB huge 
+    pages. Each such allocation is bound to the NUMA node of the thread whose 
+    request caused it, which reduces TLB misses and cross-socket memory traffic 
+    for large parameters. On platforms without huge page support the memory pool 
+    behaves like one returned by MemoryPoolHandle::New().
+    */
+    class MMProfHugePages : public MMProf
+    {
+    public:
+        /**
+        Creates a new MMProfHugePages with a new huge-page backed memory pool.
+
+        @param[in] clear_on_destruction Indicates whether the memory pool data 
+        should be cleared when destroyed
+        @param[in] capacity_byte_count The capacity of the memory pool in bytes, 
+        or zero for an unbounded memory pool
+        */
+        MMProfHugePages(bool clear_on_destruction = false, 
+            std::size_t capacity_byte_count = 0) :
+            pool_(MemoryPoolHandle::New(
+                clear_on_destruction, capacity_byte_count, true))
+        {
+        }
+
+        /**
+        Destroys the MMProfHugePages.
+        */
+        virtual ~MMProfHugePages() noexcept override
+        {
+        }
+
+        /**
+        Returns a MemoryPoolHandle pointing to the huge-page backed memory pool. 
+        The mm_prof_opt_t input parameter has no effect.
+        */
+        inline virtual MemoryPoolHandle
+            get_pool(mm_prof_opt_t) override
+        {
+            return pool_;
+        }
+
+    private:
+        MemoryPoolHandle pool_;
+    };
 #ifndef _M_CEE
     /**
     A memory manager profile that always returns a MemoryPoolHandle pointing to 
@@ -545,6 +715,20 @@ namespace seal
             return GetPool(mm_prof_opt::DEFAULT);
         }
 
+        /**
+        Returns usage statistics for the memory pool that GetPool would return 
+        for the given prof_opt under the currently set memory manager profile.
+        See MemoryPoolHandle::pool_stats for details.
+
+        @param[in] prof_opt A mm_prof_opt_t parameter used to provide additional
+        instructions to the memory manager profile for internal logic.
+        */
+        static inline std::vector<util::MemoryPoolStats> GetPoolStats(
+            mm_prof_opt_t prof_opt = mm_prof_opt::DEFAULT)
+        {
+            return GetPool(prof_opt).pool_stats();
+        }
+
     private:
         static inline std::unique_ptr<MMProf>
             SwitchProfileThreadUnsafe(
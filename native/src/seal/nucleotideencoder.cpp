@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdexcept>
+#include "seal/nucleotideencoder.h"
+#include "seal/util/common.h"
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    namespace
+    {
+        // Two-bit code of a nucleotide, or -1 for any other letter
+        inline int nucleotide_code(char nucleotide) noexcept
+        {
+            switch (nucleotide)
+            {
+            case 'A':
+            case 'a':
+                return 0;
+
+            case 'C':
+            case 'c':
+                return 1;
+
+            case 'G':
+            case 'g':
+                return 2;
+
+            case 'T':
+            case 't':
+            case 'U':
+            case 'u':
+                return 3;
+
+            default:
+                return -1;
+            }
+        }
+    }
+
+    NucleotideEncoder::NucleotideEncoder(shared_ptr<SEALContext> context) :
+        batch_encoder_(context)
+    {
+    }
+
+    void NucleotideEncoder::encode(const string &sequence, Plaintext &destination)
+    {
+        encode_internal(sequence, destination, nullptr);
+    }
+
+    void NucleotideEncoder::encode(const string &sequence, Plaintext &destination,
+        Plaintext &mask)
+    {
+        encode_internal(sequence, destination, &mask);
+    }
+
+    void NucleotideEncoder::encode_many(const vector<string> &sequences,
+        vector<Plaintext> &destinations)
+    {
+        destinations.resize(sequences.size());
+        for (size_t i = 0; i < sequences.size(); i++)
+        {
+            encode_internal(sequences[i], destinations[i], nullptr);
+        }
+    }
+
+    void NucleotideEncoder::encode_many(const vector<string> &sequences,
+        vector<Plaintext> &destinations, vector<Plaintext> &masks)
+    {
+        destinations.resize(sequences.size());
+        masks.resize(sequences.size());
+        for (size_t i = 0; i < sequences.size(); i++)
+        {
+            encode_internal(sequences[i], destinations[i], &masks[i]);
+        }
+    }
+
+    void NucleotideEncoder::encode_internal(const string &sequence,
+        Plaintext &destination, Plaintext *mask)
+    {
+        size_t row_size = sequence_capacity();
+        if (sequence.size() > row_size)
+        {
+            throw invalid_argument("sequence is too long");
+        }
+
+        // Set the low bits in the top row and the high bits in the bottom row
+        vector<uint64_t> bits(batch_encoder_.bits_uint64_count(), 0);
+        vector<uint64_t> mask_bits(mask ? bits.size() : 0, 0);
+        for (size_t i = 0; i < sequence.size(); i++)
+        {
+            int code = nucleotide_code(sequence[i]);
+            size_t high_slot = row_size + i;
+            if (code < 0)
+            {
+                if (!mask)
+                {
+                    throw invalid_argument("sequence contains an invalid nucleotide");
+                }
+                continue;
+            }
+            bits[i / bits_per_uint64] |=
+                static_cast<uint64_t>(code & 1) << (i % bits_per_uint64);
+            bits[high_slot / bits_per_uint64] |=
+                static_cast<uint64_t>(code >> 1) << (high_slot % bits_per_uint64);
+            if (mask)
+            {
+                mask_bits[i / bits_per_uint64] |= uint64_t(1) << (i % bits_per_uint64);
+                mask_bits[high_slot / bits_per_uint64] |=
+                    uint64_t(1) << (high_slot % bits_per_uint64);
+            }
+        }
+        batch_encoder_.encode_bits(bits, destination);
+        if (mask)
+        {
+            batch_encoder_.encode_bits(mask_bits, *mask);
+        }
+    }
+
+    uint64_t NucleotideEncoder::decode_mismatch_count(const Plaintext &plain,
+        MemoryPoolHandle pool)
+    {
+        // Every slot of the top row holds the count
+        vector<uint64_t> count;
+        batch_encoder_.decode_slots(plain, { 0 }, count, move(pool));
+        return count[0];
+    }
+
+    void NucleotideEncoder::decode_links(const Plaintext &plain, size_t pair_count,
+        vector<uint64_t> &destination, MemoryPoolHandle pool)
+    {
+        if (pair_count > batch_encoder_.slot_count())
+        {
+            throw invalid_argument("pair_count is too large");
+        }
+
+        // A pair is linked where its slot is zero
+        vector<uint64_t> values;
+        batch_encoder_.decode(plain, values, move(pool));
+        destination.assign(divide_round_up(pair_count,
+            static_cast<size_t>(bits_per_uint64)), 0);
+        for (size_t k = 0; k < pair_count; k++)
+        {
+            destination[k / bits_per_uint64] |=
+                static_cast<uint64_t>(values[k] == 0) << (k % bits_per_uint64);
+        }
+    }
+}
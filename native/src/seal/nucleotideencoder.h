@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "seal/batchencoder.h"
+#include "seal/context.h"
+#include "seal/plaintext.h"
+#include "seal/memorymanager.h"
+
+namespace seal
+{
+    /**
+    Encodes nucleotide sequences for computing Hamming distances with
+    SequenceEvaluator. Each nucleotide takes two bits, A = 00, C = 01, G = 10,
+    and T = 11 (U is read as T), which are bit-sliced over the two rows of
+    the batching matrix: the low bit of the i-th nucleotide goes to the i-th
+    slot of the top row, and its high bit to the i-th slot of the bottom row.
+    A plaintext thus holds a sequence of up to N/2 nucleotides, where N
+    denotes the degree of the polynomial modulus, twice as many as with a
+    one-hot encoding into four slots per nucleotide. Slots past the end of a
+    sequence are zero, so they read as A: sequences of the same length, e.g.,
+    from an alignment, are compared exactly.
+
+    @par Ambiguity
+    Aligned sequences also contain gaps and IUPAC ambiguity codes such as N or
+    R. These can be encoded together with a mask plaintext that is 1 in both
+    slots of every unambiguous nucleotide and 0 elsewhere, including past the
+    end of the sequence. The masks are encrypted along with the sequences and
+    let SequenceEvaluator::masked_mismatch_count skip any position that is not
+    an unambiguous nucleotide in both sequences.
+
+    @par Valid Parameters
+    The encryption parameters must support batching. Batching requires the
+    plaintext modulus to be congruent to 1 modulo 2N, so it is larger than any
+    mismatch count, which is at most N/2, and every count fits in a slot.
+
+    @see SequenceEvaluator for computing the mismatch count of two encrypted
+    sequences.
+    @see BatchEncoder for more information about batching.
+    */
+    class NucleotideEncoder
+    {
+    public:
+        /**
+        Creates a NucleotideEncoder. It is necessary that the encryption
+        parameters given through the SEALContext object support batching.
+
+        @param[in] context The SEALContext
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid for batching
+        @throws std::invalid_argument if scheme is not scheme_type::BFV
+        */
+        NucleotideEncoder(std::shared_ptr<SEALContext> context);
+
+        /**
+        Encodes a nucleotide sequence into a plaintext. The letters A, C, G, T,
+        and U are accepted in upper or lower case.
+
+        @param[in] sequence The nucleotide sequence to encode
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if sequence is longer than sequence_capacity()
+        @throws std::invalid_argument if sequence contains any other letter
+        */
+        void encode(const std::string &sequence, Plaintext &destination);
+
+        /**
+        Encodes a nucleotide sequence that may contain gaps and ambiguity codes
+        into a plaintext, together with its mask. The letters A, C, G, T, and U
+        in upper or lower case are nucleotides, and any other letter is encoded
+        as A with a mask of 0.
+
+        @param[in] sequence The nucleotide sequence to encode
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @param[out] mask The plaintext polynomial to overwrite with the mask
+        @throws std::invalid_argument if sequence is longer than sequence_capacity()
+        */
+        void encode(const std::string &sequence, Plaintext &destination, Plaintext &mask);
+
+        /**
+        Encodes nucleotide sequences into plaintexts, as encode does for each
+        sequence separately, and resizes the destination vector to match.
+
+        @param[in] sequences The nucleotide sequences to encode
+        @param[out] destinations The plaintext polynomials to overwrite with the results
+        @throws std::invalid_argument if any of sequences is longer than
+        sequence_capacity()
+        @throws std::invalid_argument if any of sequences contains a letter other
+        than A, C, G, T, or U
+        */
+        void encode_many(const std::vector<std::string> &sequences,
+            std::vector<Plaintext> &destinations);
+
+        /**
+        Encodes nucleotide sequences that may contain gaps and ambiguity codes
+        into plaintexts and masks, as encode does for each sequence separately,
+        and resizes the destination vectors to match.
+
+        @param[in] sequences The nucleotide sequences to encode
+        @param[out] destinations The plaintext polynomials to overwrite with the results
+        @param[out] masks The plaintext polynomials to overwrite with the masks
+        @throws std::invalid_argument if any of sequences is longer than
+        sequence_capacity()
+        */
+        void encode_many(const std::vector<std::string> &sequences,
+            std::vector<Plaintext> &destinations, std::vector<Plaintext> &masks);
+
+        /**
+        Reads the number of mismatching nucleotides from a decrypted result of
+        SequenceEvaluator::mismatch_count. Only the slot holding the count is
+        decoded. Dynamic memory allocations in the process are allocated from
+        the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] plain The decrypted mismatch count
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        std::uint64_t decode_mismatch_count(const Plaintext &plain,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Reads the linkage decisions from a decrypted result of
+        SequenceEvaluator::link_indicator, and stores them as bits packed into
+        64-bit words, so that bit k % 64 of word k / 64 is set when the k-th
+        pair of sequences is linked. Only the first pair_count slots are read.
+        Dynamic memory allocations in the process are allocated from the memory
+        pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] plain The decrypted linkage indicator
+        @param[in] pair_count The number of pairs of sequences
+        @param[out] destination The packed bits to overwrite with the decisions
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain is not valid for the encryption parameters
+        @throws std::invalid_argument if plain is in NTT form
+        @throws std::invalid_argument if pair_count is larger than the number of slots
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_links(const Plaintext &plain, std::size_t pair_count,
+            std::vector<std::uint64_t> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Returns the largest number of nucleotides in a sequence.
+        */
+        inline std::size_t sequence_capacity() const noexcept
+        {
+            return batch_encoder_.slot_count() >> 1;
+        }
+
+    private:
+        NucleotideEncoder(const NucleotideEncoder &copy) = delete;
+
+        NucleotideEncoder(NucleotideEncoder &&source) = delete;
+
+        NucleotideEncoder &operator =(const NucleotideEncoder &assign) = delete;
+
+        NucleotideEncoder &operator =(NucleotideEncoder &&assign) = delete;
+
+        // Encodes ambiguous letters as A when mask is given, and throws otherwise
+        void encode_internal(const std::string &sequence, Plaintext &destination,
+            Plaintext *mask);
+
+        BatchEncoder batch_encoder_;
+    };
+}
@@ -16,6 +16,7 @@
 #include "seal/intarray.h"
 #include "seal/keygenerator.h"
 #include "seal/memorymanager.h"
+#include "seal/nucleotideencoder.h"
 #include "seal/plaintext.h"
 #include "seal/batchencoder.h"
 #include "seal/publickey.h"
@@ -23,4 +24,5 @@
 #include "seal/randomtostd.h"
 #include "seal/relinkeys.h"
 #include "seal/secretkey.h"
+#include "seal/sequenceevaluator.h"
 #include "seal/smallmodulus.h"
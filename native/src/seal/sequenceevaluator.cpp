@@ -0,0 +1,340 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "seal/sequenceevaluator.h"
+#include "seal/encryptor.h"
+#include "seal/randomgen.h"
+#include "seal/randomtostd.h"
+#include "seal/util/common.h"
+#include "seal/util/uintcore.h"
+#include "seal/util/uintarithsmallmod.h"
+#include "seal/util/noiseestimate.h"
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    namespace
+    {
+        // Statistical distance in bits between flooded results with different
+        // circuit noise
+        constexpr int flooding_statistical_security = 40;
+
+        double log2_coeff_modulus(const EncryptionParameters &parms)
+        {
+            double result = 0;
+            for (auto &mod : parms.coeff_modulus())
+            {
+                result += log2(static_cast<double>(mod.value()));
+            }
+            return result;
+        }
+    }
+
+    SequenceEvaluator::SequenceEvaluator(shared_ptr<SEALContext> context) :
+        context_(move(context)), evaluator_(context_),
+        batch_encoder_(context_)
+    {
+        // Verify parameters
+        auto &context_data = *context_->context_data();
+        if (context_data.parms().scheme() != scheme_type::BFV)
+        {
+            throw invalid_argument("unsupported scheme");
+        }
+        if (!context_data.qualifiers().using_batching)
+        {
+            throw invalid_argument("encryption parameters are not valid for batching");
+        }
+    }
+
+    void SequenceEvaluator::mismatch_count(const Ciphertext &encrypted1,
+        const Ciphertext &encrypted2, const RelinKeys &relin_keys,
+        const GaloisKeys &galois_keys, Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        mismatch_slots(encrypted1, encrypted2, relin_keys, galois_keys,
+            destination, pool);
+        sum_rows_inplace(destination, galois_keys, move(pool));
+    }
+
+    void SequenceEvaluator::masked_mismatch_count(const Ciphertext &encrypted1,
+        const Ciphertext &mask1, const Ciphertext &encrypted2,
+        const Ciphertext &mask2, const RelinKeys &relin_keys,
+        const GaloisKeys &galois_keys, Ciphertext &destination,
+        MemoryPoolHandle pool)
+    {
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Positions where both nucleotides are unambiguous
+        Ciphertext both_unambiguous;
+        evaluator_.multiply(mask1, mask2, both_unambiguous, pool);
+        evaluator_.relinearize_inplace(both_unambiguous, relin_keys, pool);
+
+        mismatch_slots(encrypted1, encrypted2, relin_keys, galois_keys,
+            destination, pool);
+        evaluator_.multiply_inplace(destination, both_unambiguous, pool);
+        evaluator_.relinearize_inplace(destination, relin_keys, pool);
+        sum_rows_inplace(destination, galois_keys, move(pool));
+    }
+
+    void SequenceEvaluator::link_indicator(const vector<Ciphertext> &mismatch_counts,
+        uint64_t threshold, const RelinKeys &relin_keys, const PublicKey &public_key,
+        Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        size_t pair_count = mismatch_counts.size();
+        if (pair_count == 0)
+        {
+            throw invalid_argument("mismatch_counts cannot be empty");
+        }
+        if (pair_count > batch_encoder_.slot_count())
+        {
+            throw invalid_argument("mismatch_counts has too many elements");
+        }
+        uint64_t plain_modulus = 
+            context_->context_data()->parms().plain_modulus().value();
+        if (threshold >= plain_modulus)
+        {
+            throw invalid_argument("threshold is too large");
+        }
+        if (!relin_keys.is_metadata_valid_for(context_) || relin_keys.size() < 1)
+        {
+            throw invalid_argument("relin_keys is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Move the count of the k-th pair to slot k
+        vector<uint64_t> unit_bits(batch_encoder_.bits_uint64_count(), 0);
+        Plaintext unit;
+        Ciphertext packed, term;
+        for (size_t k = 0; k < pair_count; k++)
+        {
+            unit_bits[k / bits_per_uint64] = uint64_t(1) << (k % bits_per_uint64);
+            batch_encoder_.encode_bits(unit_bits, unit);
+            unit_bits[k / bits_per_uint64] = 0;
+            if (k == 0)
+            {
+                evaluator_.multiply_plain(mismatch_counts[k], unit, packed, pool);
+                continue;
+            }
+            evaluator_.multiply_plain(mismatch_counts[k], unit, term, pool);
+            evaluator_.add_inplace(packed, term);
+        }
+
+        // The flooding noise is sized for the worst noise the rest of the circuit
+        // can leave, so it cannot depend on the counts
+        auto &parms = context_->context_data(packed.parms_id())->parms();
+        double circuit_budget = link_noise_budget(parms, packed.noise_budget(),
+            threshold, relin_keys);
+        double log2_poly_modulus_degree = 
+            static_cast<double>(get_power_of_two(parms.poly_modulus_degree()));
+        double log2_plain_modulus = log2(static_cast<double>(plain_modulus));
+        int flooding_bit_count = static_cast<int>(ceil(flooding_statistical_security +
+            log2_poly_modulus_degree + log2_coeff_modulus(parms) - log2_plain_modulus -
+            circuit_budget - 1));
+        // One bit below the budget of noise 2^flooding_bit_count, as the noise
+        // of the circuit and the encryption of zero add to it
+        double flooding_budget = log2_coeff_modulus(parms) - log2_plain_modulus -
+            flooding_bit_count - 2;
+        if (flooding_budget < 1)
+        {
+            throw invalid_argument("threshold is too large for the noise budget");
+        }
+
+        // The roots of the polynomial are the counts of linked pairs. The factors
+        // are multiplied as they are made, like a binary counter: the i-th partial
+        // product is empty or holds 2^i factors, so only O(log(threshold))
+        // ciphertexts are held at a time.
+        vector<Ciphertext> partial_products;
+        Plaintext root;
+        for (uint64_t j = 0; j <= threshold; j++)
+        {
+            Ciphertext product(packed);
+            if (j)
+            {
+                root = j;
+                evaluator_.sub_plain_inplace(product, root);
+            }
+            size_t i = 0;
+            for (; i < partial_products.size() && partial_products[i].size(); i++)
+            {
+                evaluator_.multiply_inplace(product, partial_products[i], pool);
+                evaluator_.relinearize_inplace(product, relin_keys, pool);
+                partial_products[i].release();
+            }
+            if (i == partial_products.size())
+            {
+                partial_products.emplace_back(pool);
+            }
+            partial_products[i] = move(product);
+        }
+
+        // Multiply the remaining partial products, smallest first
+        bool is_first = true;
+        for (auto &partial_product : partial_products)
+        {
+            if (!partial_product.size())
+            {
+                continue;
+            }
+            if (is_first)
+            {
+                destination = move(partial_product);
+                is_first = false;
+                continue;
+            }
+            evaluator_.multiply_inplace(destination, partial_product, pool);
+            evaluator_.relinearize_inplace(destination, relin_keys, pool);
+        }
+
+        // Replace the values of unlinked pairs with random nonzero values
+        shared_ptr<UniformRandomGenerator> random(parms.random_generator()->create());
+        RandomToStandardAdapter engine(random);
+        uniform_int_distribution<uint64_t> dist(1, plain_modulus - 1);
+        vector<uint64_t> blinding(batch_encoder_.slot_count());
+        for (auto &value : blinding)
+        {
+            value = dist(engine);
+        }
+        Plaintext plain_blinding;
+        batch_encoder_.encode(blinding, plain_blinding);
+        evaluator_.multiply_plain_inplace(destination, plain_blinding, pool);
+
+        // Hide the noise left by the circuit, which depends on the counts
+        flood_noise_inplace(destination, public_key, flooding_bit_count, 
+            flooding_budget, move(pool));
+    }
+
+    double SequenceEvaluator::link_noise_budget(const EncryptionParameters &parms,
+        double budget, uint64_t threshold, const RelinKeys &relin_keys)
+    {
+        // The digits that relinearizing a product of size 3 switches
+        size_t digit_count = 0;
+        for (size_t i = 0; i < parms.coeff_modulus().size(); i++)
+        {
+            digit_count += relin_keys.data()[0][i].size() / 2;
+        }
+
+        // Every factor comes from subtracting a root, and no product in the tree
+        // is deeper than a balanced one of ceil(log2(threshold + 1)) levels
+        budget = add_plain_noise_budget(parms, budget);
+        for (int depth = get_significant_bit_count(threshold); depth > 0; depth--)
+        {
+            budget = key_switch_noise_budget(parms,
+                multiply_noise_budget(parms, budget, 2, budget, 2),
+                relin_keys.decomposition_bit_count(), digit_count);
+        }
+
+        // Multiplying by the blinding values, with all coefficients at worst
+        return multiply_plain_noise_budget(parms, budget,
+            parms.poly_modulus_degree(), parms.plain_modulus().value() >> 1);
+    }
+
+    void SequenceEvaluator::flood_noise_inplace(Ciphertext &encrypted,
+        const PublicKey &public_key, int bit_count, double flooding_budget,
+        MemoryPoolHandle pool)
+    {
+        auto &context_data = *context_->context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+
+        // A fresh encryption of zero re-randomizes the ciphertext
+        Encryptor encryptor(context_, public_key);
+        Ciphertext zero(pool);
+        encryptor.encrypt(Plaintext("0"), zero, pool);
+        evaluator_.mod_switch_to_inplace(zero, encrypted.parms_id(), pool);
+
+        // Add noise uniformly distributed in [-2^bit_count, 2^bit_count) to its
+        // first polynomial: uniform values below 2^(bit_count + 1) are reduced
+        // and then shifted down by 2^bit_count
+        size_t noise_uint64_count = 
+            safe_cast<size_t>(divide_round_up(bit_count + 1, bits_per_uint64));
+        int top_bit_count = (bit_count + 1) - 
+            safe_cast<int>(noise_uint64_count - 1) * bits_per_uint64;
+        uint64_t top_mask = (top_bit_count == bits_per_uint64) ? 
+            ~uint64_t(0) : (uint64_t(1) << top_bit_count) - 1;
+        vector<uint64_t> offsets(coeff_mod_count);
+        for (size_t i = 0; i < coeff_mod_count; i++)
+        {
+            offsets[i] = exponentiate_uint_mod(2, safe_cast<uint64_t>(bit_count),
+                coeff_modulus[i]);
+        }
+
+        shared_ptr<UniformRandomGenerator> random(parms.random_generator()->create());
+        auto noise(allocate_uint(noise_uint64_count, pool));
+        auto reduced(allocate_uint(noise_uint64_count, pool));
+        for (size_t j = 0; j < coeff_count; j++)
+        {
+            for (size_t k = 0; k < noise_uint64_count; k++)
+            {
+                noise[k] = (static_cast<uint64_t>(random->generate()) << 32) | 
+                    random->generate();
+            }
+            noise[noise_uint64_count - 1] &= top_mask;
+            for (size_t i = 0; i < coeff_mod_count; i++)
+            {
+                set_uint_uint(noise.get(), noise_uint64_count, reduced.get());
+                modulo_uint_inplace(reduced.get(), noise_uint64_count, coeff_modulus[i]);
+                uint64_t value = sub_uint_uint_mod(reduced[0], offsets[i], 
+                    coeff_modulus[i]);
+                uint64_t *coeff = zero.data() + (i * coeff_count) + j;
+                *coeff = add_uint_uint_mod(*coeff, value, coeff_modulus[i]);
+            }
+        }
+        if (encrypted.is_ntt_form())
+        {
+            evaluator_.transform_to_ntt_inplace(zero);
+        }
+
+        evaluator_.add_inplace(encrypted, zero);
+        encrypted.noise_budget() = add_noise_budgets(encrypted.noise_budget(),
+            flooding_budget);
+    }
+
+    void SequenceEvaluator::mismatch_slots(const Ciphertext &encrypted1,
+        const Ciphertext &encrypted2, const RelinKeys &relin_keys,
+        const GaloisKeys &galois_keys, Ciphertext &destination, MemoryPoolHandle pool)
+    {
+        // The bits that differ
+        evaluator_.sub(encrypted1, encrypted2, destination);
+        evaluator_.square_inplace(destination, pool);
+        evaluator_.relinearize_inplace(destination, relin_keys, pool);
+
+        // Either bit of a nucleotide differs: x + y - xy with the rows swapped
+        Ciphertext swapped;
+        evaluator_.rotate_columns(destination, galois_keys, swapped, pool);
+        Ciphertext both;
+        evaluator_.multiply(destination, swapped, both, pool);
+        evaluator_.relinearize_inplace(both, relin_keys, pool);
+        evaluator_.add_inplace(destination, swapped);
+        evaluator_.sub_inplace(destination, both);
+    }
+
+    void SequenceEvaluator::sum_rows_inplace(Ciphertext &encrypted,
+        const GaloisKeys &galois_keys, MemoryPoolHandle pool)
+    {
+        size_t row_size = context_->context_data()->parms().poly_modulus_degree() >> 1;
+        Ciphertext rotated;
+        for (size_t steps = 1; steps < row_size; steps <<= 1)
+        {
+            evaluator_.rotate_rows(encrypted, static_cast<int>(steps), galois_keys,
+                rotated, pool);
+            evaluator_.add_inplace(encrypted, rotated);
+        }
+    }
+}
@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "seal/batchencoder.h"
+#include "seal/context.h"
+#include "seal/ciphertext.h"
+#include "seal/evaluator.h"
+#include "seal/relinkeys.h"
+#include "seal/galoiskeys.h"
+#include "seal/publickey.h"
+#include "seal/memorymanager.h"
+
+namespace seal
+{
+    /**
+    Computes distances between nucleotide sequences encrypted with the BFV
+    scheme after encoding them with NucleotideEncoder. The computations are
+    circuits of Evaluator operations, so the usual requirements on keys and
+    noise budget apply.
+
+    @par Keys
+    Relinearization keys with at least one key, and Galois keys for the
+    column rotation and for row rotations by all powers of two below N/2,
+    where N denotes the degree of the polynomial modulus, are needed. These
+    are all included in the Galois keys generated by default by KeyGenerator.
+
+    @par Linkage
+    For cluster detection, the mismatch counts of many pairs of sequences can
+    be compared to a distance threshold homomorphically with link_indicator,
+    so that the decrypted result holds only which pairs are linked. The
+    result is re-randomized and its noise flooded, so that neither its values
+    nor its noise reveal the distances of unlinked pairs to the holder of the
+    secret key, provided the noise budget estimates of the inputs hold.
+
+    @see NucleotideEncoder for encoding sequences and reading the results.
+    @see Evaluator for the underlying homomorphic operations.
+    */
+    class SequenceEvaluator
+    {
+    public:
+        /**
+        Creates a SequenceEvaluator. It is necessary that the encryption
+        parameters given through the SEALContext object support batching.
+
+        @param[in] context The SEALContext
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid for batching
+        @throws std::invalid_argument if scheme is not scheme_type::BFV
+        */
+        SequenceEvaluator(std::shared_ptr<SEALContext> context);
+
+        /**
+        Computes the number of positions at which two encrypted sequences have
+        different nucleotides, and stores the result in the destination
+        parameter. Every slot of the top row of the result holds the count.
+        With each nucleotide bit-sliced over the two rows, the bits differ
+        where x = (a - b)^2 is 1, and a nucleotide differs where either of its
+        bits does, i.e., where x + y - xy is 1 for x and its rows swapped y.
+        This consumes two multiplicative levels, followed by summing the top
+        row with log2(N/2) row rotations. Dynamic memory allocations in the
+        process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] encrypted1 The first encrypted sequence
+        @param[in] encrypted2 The second encrypted sequence
+        @param[in] relin_keys The relinearization keys
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the mismatch count
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypted1 and encrypted2 are at
+        different level or have different NTT form
+        @throws std::invalid_argument if the keys are not valid for the encryption
+        parameters or do not include the needed rotations
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void mismatch_count(const Ciphertext &encrypted1, const Ciphertext &encrypted2,
+            const RelinKeys &relin_keys, const GaloisKeys &galois_keys,
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Computes the number of positions at which two encrypted sequences both
+        have an unambiguous nucleotide and these differ, and stores the result
+        in the destination parameter. The sequences and their masks are those
+        given by the ambiguity-aware NucleotideEncoder::encode, so gaps and
+        ambiguity codes in either sequence are not counted. Every slot of the
+        top row of the result holds the count. This consumes three
+        multiplicative levels, followed by summing the top row with log2(N/2)
+        row rotations. Dynamic memory allocations in the process are allocated
+        from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted1 The first encrypted sequence
+        @param[in] mask1 The encrypted mask of the first sequence
+        @param[in] encrypted2 The second encrypted sequence
+        @param[in] mask2 The encrypted mask of the second sequence
+        @param[in] relin_keys The relinearization keys
+        @param[in] galois_keys The Galois keys
+        @param[out] destination The ciphertext to overwrite with the mismatch count
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if any of the ciphertexts is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if the ciphertexts are at different level or
+        have different NTT form
+        @throws std::invalid_argument if the keys are not valid for the encryption
+        parameters or do not include the needed rotations
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void masked_mismatch_count(const Ciphertext &encrypted1,
+            const Ciphertext &mask1, const Ciphertext &encrypted2,
+            const Ciphertext &mask2, const RelinKeys &relin_keys,
+            const GaloisKeys &galois_keys, Ciphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Decides for encrypted mismatch counts of many pairs of sequences whether
+        each is at most the given threshold, and stores the decisions in the
+        destination parameter. The count of the k-th pair is moved to slot k,
+        where the polynomial (x - 0)(x - 1)...(x - threshold) is evaluated; it
+        vanishes exactly when the count is at most the threshold. The values
+        are then multiplied by uniformly random nonzero values, so the k-th
+        slot of the result is zero when the k-th pair is linked and uniformly
+        random otherwise. Read the result with NucleotideEncoder::decode_links.
+
+        Finally an encryption of zero with public_key is added, with noise 
+        uniform in a range 2^40 N times larger than the worst noise the circuit
+        can leave, as bounded from the noise budget estimates of the counts. 
+        This makes the noise of the result statistically independent of the 
+        counts. The bound assumes the estimates, so counts must carry them, 
+        e.g., by coming from Encryptor and Evaluator directly or through 
+        Ciphertext::save and Ciphertext::load.
+
+        The polynomial is evaluated as its factors are made, multiplying
+        products of equally many factors like a binary counter, so at most
+        about log2(threshold + 1) ciphertexts are held at a time. This consumes
+        ceil(log2(threshold + 1)) multiplicative levels and two plaintext 
+        multiplications on top of those of the counts, and the flooding needs 
+        about 40 + log2(N) more bits of noise budget, so larger thresholds need
+        a larger coefficient modulus. Dynamic memory allocations in the process
+        are allocated from the memory pool pointed to by the given 
+        MemoryPoolHandle.
+
+        @param[in] mismatch_counts The encrypted mismatch counts, e.g., from
+        mismatch_count or masked_mismatch_count
+        @param[in] threshold The largest mismatch count of a linked pair
+        @param[in] relin_keys The relinearization keys
+        @param[in] public_key The public key the counts are encrypted with
+        @param[out] destination The ciphertext to overwrite with the decisions
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if mismatch_counts is empty or has more
+        elements than the number of slots
+        @throws std::invalid_argument if threshold is not smaller than the
+        plaintext modulus
+        @throws std::invalid_argument if the estimated noise budget of the counts
+        is too small for threshold and the flooding
+        @throws std::invalid_argument if the ciphertexts, relin_keys or public_key
+        are not valid for the encryption parameters
+        @throws std::invalid_argument if the ciphertexts are at different level
+        or have different NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        @throws std::logic_error if result ciphertext is transparent
+        */
+        void link_indicator(const std::vector<Ciphertext> &mismatch_counts,
+            std::uint64_t threshold, const RelinKeys &relin_keys,
+            const PublicKey &public_key, Ciphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+    private:
+        SequenceEvaluator(const SequenceEvaluator &copy) = delete;
+
+        SequenceEvaluator(SequenceEvaluator &&source) = delete;
+
+        SequenceEvaluator &operator =(const SequenceEvaluator &assign) = delete;
+
+        SequenceEvaluator &operator =(SequenceEvaluator &&assign) = delete;
+
+        // Sets the slots that differ in either bit of their nucleotide to 1
+        void mismatch_slots(const Ciphertext &encrypted1, const Ciphertext &encrypted2,
+            const RelinKeys &relin_keys, const GaloisKeys &galois_keys,
+            Ciphertext &destination, MemoryPoolHandle pool);
+
+        // Sums the slots of each row into every slot of that row
+        void sum_rows_inplace(Ciphertext &encrypted, const GaloisKeys &galois_keys,
+            MemoryPoolHandle pool);
+
+        // Bounds the estimated noise budget that link_indicator leaves before
+        // flooding, given that of the packed counts
+        double link_noise_budget(const EncryptionParameters &parms, double budget,
+            std::uint64_t threshold, const RelinKeys &relin_keys);
+
+        // Adds an encryption of zero with noise uniform in [-2^bit_count,
+        // 2^bit_count), whose noise budget is flooding_budget
+        void flood_noise_inplace(Ciphertext &encrypted, const PublicKey &public_key,
+            int bit_count, double flooding_budget, MemoryPoolHandle pool);
+
+        std::shared_ptr<SEALContext> context_{ nullptr };
+
+        Evaluator evaluator_;
+
+        BatchEncoder batch_encoder_;
+    };
+}
@@ -22,6 +22,67 @@ namespace seal
 {
     namespace util
     {
+        namespace
+        {
+            // The fast base conversions process this many coefficients at a time,
+            // so that the scaled residues of a block stay in L1 while every output
+            // modulus reads them
+            inline size_t conversion_block_size(size_t input_count)
+            {
+                return max<size_t>(size_t(2048) / input_count, 1);
+            }
+
+            // Writes input[i * coeff_count + k] * scale[i] mod base[i] to
+            // destination[k * input_count + i] for k < block_size, i.e., the
+            // scaled residues of each coefficient are stored contiguously
+            void scale_block(const uint64_t *input, size_t coeff_count,
+                const MultiplyUIntModOperand *scale, const SmallModulus *base,
+                size_t input_count, size_t block_size, uint64_t *destination)
+            {
+                for (size_t i = 0; i < input_count; i++, input += coeff_count)
+                {
+                    const MultiplyUIntModOperand &scale_elt = scale[i];
+                    const SmallModulus &base_elt = base[i];
+                    uint64_t *destination_ptr = destination + i;
+                    for (size_t k = 0; k < block_size; k++, destination_ptr += input_count)
+                    {
+                        *destination_ptr = multiply_uint_mod(input[k], scale_elt, base_elt);
+                    }
+                }
+            }
+
+            // Writes the inner product of the scaled residues of each coefficient
+            // in the block with matrix_row, reduced modulo modulus, to destination.
+            // Products are at most 122 bits, so up to 63 of them can be summed with
+            // no reduction. Two accumulators shorten the carry chain.
+            void convert_block_row(const uint64_t *scaled, size_t input_count,
+                size_t block_size, const uint64_t *matrix_row,
+                const SmallModulus &modulus, uint64_t *destination)
+            {
+                for (size_t k = 0; k < block_size; k++, scaled += input_count)
+                {
+                    unsigned long long even[2]{ 0, 0 };
+                    unsigned long long odd[2]{ 0, 0 };
+                    unsigned long long temp[2];
+                    size_t i = 0;
+                    for (; i + 1 < input_count; i += 2)
+                    {
+                        multiply_uint64(scaled[i], matrix_row[i], temp);
+                        even[1] += temp[1] + add_uint64(even[0], temp[0], even);
+                        multiply_uint64(scaled[i + 1], matrix_row[i + 1], temp);
+                        odd[1] += temp[1] + add_uint64(odd[0], temp[0], odd);
+                    }
+                    if (i < input_count)
+                    {
+                        multiply_uint64(scaled[i], matrix_row[i], temp);
+                        even[1] += temp[1] + add_uint64(even[0], temp[0], even);
+                    }
+                    even[1] += odd[1] + add_uint64(even[0], odd[0], even);
+                    destination[k] = barrett_reduce_128(even, modulus);
+                }
+            }
+        }
+
         BaseConverter::BaseConverter(const std::vector<SmallModulus> &coeff_base,
             size_t coeff_count, const SmallModulus &small_plain_mod,
             MemoryPoolHandle pool) : pool_(move(pool))
@@ -36,7 +97,8 @@ namespace seal
         }
 
         void BaseConverter::generate(const std::vector<SmallModulus> &coeff_base,
-            size_t coeff_count, const SmallModulus &small_plain_mod)
+            size_t coeff_count, const SmallModulus &small_plain_mod,
+            const BaseConverter *shared)
         {
 #ifdef SEAL_DEBUG
             if (get_power_of_two(coeff_count) < 0)
@@ -120,7 +182,25 @@ namespace seal
             bsk_small_ntt_tables_ = allocate<SmallNTTTables>(bsk_base_mod_count_, pool_);
             for (size_t i = 0; i < bsk_base_mod_count_; i++)
             {
-                if (!bsk_small_ntt_tables_[i].generate(coeff_count_power, bsk_base_array_[i]))
+                // Share the tables if the other BaseConverter has them
+                const SmallNTTTables *shared_tables = nullptr;
+                if (shared && shared->generated_)
+                {
+                    auto tables_end = shared->bsk_small_ntt_tables_.get() + 
+                        shared->bsk_base_mod_count_;
+                    shared_tables = find_if(shared->bsk_small_ntt_tables_.get(), 
+                        tables_end, [&](const SmallNTTTables &tables) {
+                            return tables.coeff_count_power() == coeff_count_power &&
+                                tables.modulus() == bsk_base_array_[i];
+                        });
+                    shared_tables = (shared_tables == tables_end) ? nullptr : shared_tables;
+                }
+                if (shared_tables)
+                {
+                    bsk_small_ntt_tables_[i] = *shared_tables;
+                }
+                else if (!bsk_small_ntt_tables_[i].generate(coeff_count_power, 
+                    bsk_base_array_[i]))
                 {
                     reset();
                     return;
@@ -457,9 +537,299 @@ namespace seal
             }
 
             // Everything went well
+            generate_multiply_operands();
             generated_ = true;
         }
 
+        void BaseConverter::save(ostream &stream) const
+        {
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                auto write_uint = [&](const uint64_t *data, size_t count) {
+                    stream.write(reinterpret_cast<const char*>(data),
+                        static_cast<streamsize>(mul_safe(count, 
+                        static_cast<size_t>(bytes_per_uint64))));
+                };
+                auto write_mods = [&](const SmallModulus *data, size_t count) {
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        data[i].save(stream);
+                    }
+                };
+                auto write_matrix = [&](const Pointer<uint64_t> *data, 
+                    size_t rows, size_t cols) {
+                    for (size_t i = 0; i < rows; i++)
+                    {
+                        write_uint(data[i].get(), cols);
+                    }
+                };
+
+                uint64_t generated64 = static_cast<uint64_t>(generated_);
+                write_uint(&generated64, 1);
+                if (!generated_)
+                {
+                    stream.exceptions(old_except_mask);
+                    return;
+                }
+
+                uint64_t counts[3]{ static_cast<uint64_t>(coeff_count_),
+                    static_cast<uint64_t>(coeff_base_mod_count_),
+                    static_cast<uint64_t>(aux_base_mod_count_) };
+                write_uint(counts, 3);
+                small_plain_mod_.save(stream);
+                m_tilde_.save(stream);
+                m_sk_.save(stream);
+                gamma_.save(stream);
+
+                uint64_t scalars[3]{ inv_coeff_products_mod_mtilde_,
+                    inv_aux_products_mod_msk_, inv_gamma_mod_plain_ };
+                write_uint(scalars, 3);
+
+                write_mods(coeff_base_array_.get(), coeff_base_mod_count_);
+                write_mods(aux_base_array_.get(), aux_base_mod_count_);
+                write_mods(bsk_base_array_.get(), bsk_base_mod_count_);
+                write_uint(coeff_products_array_.get(), 
+                    coeff_base_mod_count_ * coeff_base_mod_count_);
+                write_matrix(coeff_base_products_mod_aux_bsk_array_.get(), 
+                    bsk_base_mod_count_, coeff_base_mod_count_);
+                write_uint(inv_coeff_base_products_mod_coeff_array_.get(), 
+                    coeff_base_mod_count_);
+                write_uint(coeff_base_products_mod_mtilde_array_.get(), 
+                    coeff_base_mod_count_);
+                write_uint(mtilde_inv_coeff_base_products_mod_coeff_array_.get(), 
+                    coeff_base_mod_count_);
+                write_uint(inv_coeff_products_all_mod_aux_bsk_array_.get(), 
+                    bsk_base_mod_count_);
+                write_matrix(aux_base_products_mod_coeff_array_.get(), 
+                    coeff_base_mod_count_, aux_base_mod_count_);
+                write_uint(inv_aux_base_products_mod_aux_array_.get(), 
+                    aux_base_mod_count_);
+                write_uint(aux_base_products_mod_msk_array_.get(), aux_base_mod_count_);
+                write_uint(aux_products_all_mod_coeff_array_.get(), coeff_base_mod_count_);
+                write_uint(inv_mtilde_mod_bsk_array_.get(), bsk_base_mod_count_);
+                write_uint(coeff_products_all_mod_bsk_array_.get(), bsk_base_mod_count_);
+                write_uint(inv_last_coeff_mod_array_.get(), coeff_base_mod_count_ - 1);
+                for (size_t i = 0; i < bsk_base_mod_count_; i++)
+                {
+                    bsk_small_ntt_tables_[i].save(stream);
+                }
+
+                // The plain gamma tables only exist for BFV
+                if (!small_plain_mod_.is_zero())
+                {
+                    write_mods(plain_gamma_array_.get(), plain_gamma_count_);
+                    write_matrix(coeff_products_mod_plain_gamma_array_.get(), 
+                        plain_gamma_count_, coeff_base_mod_count_);
+                    write_uint(neg_inv_coeff_products_all_mod_plain_gamma_array_.get(), 
+                        plain_gamma_count_);
+                    write_uint(plain_gamma_product_mod_coeff_array_.get(), 
+                        coeff_base_mod_count_);
+                }
+            }
+            catch (const exception &)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void BaseConverter::load(istream &stream)
+        {
+            reset();
+
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                auto read_uint = [&](uint64_t *data, size_t count) {
+                    stream.read(reinterpret_cast<char*>(data),
+                        static_cast<streamsize>(mul_safe(count, 
+                        static_cast<size_t>(bytes_per_uint64))));
+                };
+                auto load_uint = [&](size_t count) {
+                    auto data(allocate_uint(count, pool_));
+                    read_uint(data.get(), count);
+                    return data;
+                };
+                auto load_mods = [&](size_t count) {
+                    auto data(allocate<SmallModulus>(count, pool_));
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        data[i].load(stream);
+                    }
+                    return data;
+                };
+                auto load_matrix = [&](size_t rows, size_t cols) {
+                    auto data(allocate<Pointer<uint64_t>>(rows, pool_));
+                    for (size_t i = 0; i < rows; i++)
+                    {
+                        data[i] = load_uint(cols);
+                    }
+                    return data;
+                };
+
+                uint64_t generated64 = 0;
+                read_uint(&generated64, 1);
+                if (!generated64)
+                {
+                    stream.exceptions(old_except_mask);
+                    return;
+                }
+
+                uint64_t counts[3]{ 0, 0, 0 };
+                read_uint(counts, 3);
+                if (get_power_of_two(counts[0]) < 0 ||
+                    counts[0] < SEAL_POLY_MOD_DEGREE_MIN ||
+                    counts[0] > SEAL_POLY_MOD_DEGREE_MAX ||
+                    counts[1] < SEAL_COEFF_MOD_COUNT_MIN ||
+                    counts[1] > SEAL_COEFF_MOD_COUNT_MAX ||
+                    (counts[2] != counts[1] && counts[2] != counts[1] + 1) ||
+                    counts[2] > global_variables::internal_mods::aux_small_mods.size())
+                {
+                    throw invalid_argument("invalid base converter data");
+                }
+                coeff_count_ = safe_cast<size_t>(counts[0]);
+                coeff_base_mod_count_ = safe_cast<size_t>(counts[1]);
+                aux_base_mod_count_ = safe_cast<size_t>(counts[2]);
+                bsk_base_mod_count_ = aux_base_mod_count_ + 1;
+                plain_gamma_count_ = 2;
+                small_plain_mod_.load(stream);
+                m_tilde_.load(stream);
+                m_sk_.load(stream);
+                gamma_.load(stream);
+
+                uint64_t scalars[3]{ 0, 0, 0 };
+                read_uint(scalars, 3);
+                inv_coeff_products_mod_mtilde_ = scalars[0];
+                inv_aux_products_mod_msk_ = scalars[1];
+                inv_gamma_mod_plain_ = scalars[2];
+
+                coeff_base_array_ = load_mods(coeff_base_mod_count_);
+                aux_base_array_ = load_mods(aux_base_mod_count_);
+                bsk_base_array_ = load_mods(bsk_base_mod_count_);
+                coeff_products_array_ = 
+                    load_uint(coeff_base_mod_count_ * coeff_base_mod_count_);
+                coeff_base_products_mod_aux_bsk_array_ = 
+                    load_matrix(bsk_base_mod_count_, coeff_base_mod_count_);
+                inv_coeff_base_products_mod_coeff_array_ = load_uint(coeff_base_mod_count_);
+                coeff_base_products_mod_mtilde_array_ = load_uint(coeff_base_mod_count_);
+                mtilde_inv_coeff_base_products_mod_coeff_array_ = 
+                    load_uint(coeff_base_mod_count_);
+                inv_coeff_products_all_mod_aux_bsk_array_ = load_uint(bsk_base_mod_count_);
+                aux_base_products_mod_coeff_array_ = 
+                    load_matrix(coeff_base_mod_count_, aux_base_mod_count_);
+                inv_aux_base_products_mod_aux_array_ = load_uint(aux_base_mod_count_);
+                aux_base_products_mod_msk_array_ = load_uint(aux_base_mod_count_);
+                aux_products_all_mod_coeff_array_ = load_uint(coeff_base_mod_count_);
+                inv_mtilde_mod_bsk_array_ = load_uint(bsk_base_mod_count_);
+                coeff_products_all_mod_bsk_array_ = load_uint(bsk_base_mod_count_);
+                inv_last_coeff_mod_array_ = load_uint(coeff_base_mod_count_ - 1);
+                bsk_small_ntt_tables_ = allocate<SmallNTTTables>(bsk_base_mod_count_, pool_);
+                for (size_t i = 0; i < bsk_base_mod_count_; i++)
+                {
+                    bsk_small_ntt_tables_[i].load(stream);
+                    if (!bsk_small_ntt_tables_[i].is_generated() ||
+                        bsk_small_ntt_tables_[i].coeff_count() != coeff_count_)
+                    {
+                        throw invalid_argument("invalid base converter data");
+                    }
+                }
+
+                // The plain gamma tables only exist for BFV
+                if (!small_plain_mod_.is_zero())
+                {
+                    plain_gamma_array_ = load_mods(plain_gamma_count_);
+                    coeff_products_mod_plain_gamma_array_ = 
+                        load_matrix(plain_gamma_count_, coeff_base_mod_count_);
+                    neg_inv_coeff_products_all_mod_plain_gamma_array_ = 
+                        load_uint(plain_gamma_count_);
+                    plain_gamma_product_mod_coeff_array_ = 
+                        load_uint(coeff_base_mod_count_);
+                }
+
+                generate_multiply_operands();
+                generated_ = true;
+            }
+            catch (const exception &)
+            {
+                reset();
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void BaseConverter::generate_multiply_operands()
+        {
+            auto generate_operands = [&](const uint64_t *values,
+                const SmallModulus *moduli, size_t count) {
+                auto operands(allocate<MultiplyUIntModOperand>(count, pool_));
+                for (size_t i = 0; i < count; i++)
+                {
+                    operands[i].set(values[i], moduli[i]);
+                }
+                return operands;
+            };
+
+            inv_coeff_base_products_mod_coeff_operands_ = generate_operands(
+                inv_coeff_base_products_mod_coeff_array_.get(),
+                coeff_base_array_.get(), coeff_base_mod_count_);
+            mtilde_inv_coeff_base_products_mod_coeff_operands_ = generate_operands(
+                mtilde_inv_coeff_base_products_mod_coeff_array_.get(),
+                coeff_base_array_.get(), coeff_base_mod_count_);
+            inv_aux_base_products_mod_aux_operands_ = generate_operands(
+                inv_aux_base_products_mod_aux_array_.get(),
+                aux_base_array_.get(), aux_base_mod_count_);
+            inv_coeff_products_all_mod_aux_bsk_operands_ = generate_operands(
+                inv_coeff_products_all_mod_aux_bsk_array_.get(),
+                bsk_base_array_.get(), bsk_base_mod_count_);
+            inv_mtilde_mod_bsk_operands_ = generate_operands(
+                inv_mtilde_mod_bsk_array_.get(),
+                bsk_base_array_.get(), bsk_base_mod_count_);
+            inv_last_coeff_mod_operands_ = generate_operands(
+                inv_last_coeff_mod_array_.get(),
+                coeff_base_array_.get(), coeff_base_mod_count_ - 1);
+
+            mixed_radix_operands_ = allocate<MultiplyUIntModOperand>(
+                mul_safe(coeff_base_mod_count_, coeff_base_mod_count_), pool_);
+            for (size_t i = 0; i < coeff_base_mod_count_; i++)
+            {
+                auto &modulus = coeff_base_array_[i];
+
+                // Products of the preceding moduli modulo q_i; all of them are
+                // invertible since the moduli are coprime
+                auto products(allocate_uint(i + 1, pool_));
+                products[0] = 1;
+                for (size_t j = 0; j < i; j++)
+                {
+                    products[j + 1] = multiply_uint_uint_mod(products[j],
+                        coeff_base_array_[j].value() % modulus.value(), modulus);
+                }
+                uint64_t inv_product = 0;
+                try_invert_uint_mod(products[i], modulus, inv_product);
+                for (size_t j = 0; j < i; j++)
+                {
+                    mixed_radix_operands_[i * coeff_base_mod_count_ + j].set(
+                        negate_uint_mod(multiply_uint_uint_mod(products[j], inv_product,
+                            modulus), modulus), modulus);
+                }
+                mixed_radix_operands_[i * coeff_base_mod_count_ + i].set(
+                    inv_product, modulus);
+            }
+            inv_coeff_products_mod_mtilde_operand_.set(
+                inv_coeff_products_mod_mtilde_, m_tilde_);
+            inv_aux_products_mod_msk_operand_.set(inv_aux_products_mod_msk_, m_sk_);
+        }
+
         void BaseConverter::reset() noexcept
         {
             generated_ = false;
@@ -484,6 +854,15 @@ namespace seal
             plain_gamma_product_mod_coeff_array_.release();
             bsk_small_ntt_tables_.release();
             inv_last_coeff_mod_array_.release();
+            inv_coeff_base_products_mod_coeff_operands_.release();
+            mtilde_inv_coeff_base_products_mod_coeff_operands_.release();
+            inv_aux_base_products_mod_aux_operands_.release();
+            inv_coeff_products_all_mod_aux_bsk_operands_.release();
+            inv_mtilde_mod_bsk_operands_.release();
+            inv_last_coeff_mod_operands_.release();
+            mixed_radix_operands_.release();
+            inv_coeff_products_mod_mtilde_operand_ = MultiplyUIntModOperand();
+            inv_aux_products_mod_msk_operand_ = MultiplyUIntModOperand();
             inv_coeff_products_mod_mtilde_ = 0;
             m_tilde_ = 0;
             m_sk_ = 0;
@@ -520,49 +899,23 @@ namespace seal
              Require: Input in q
              Ensure: Output in Bsk = {m1,...,ml} U {msk}
             */
-            auto temp_coeff_transition(allocate_uint(
-                mul_safe(coeff_count_, coeff_base_mod_count_), pool));
-            for (size_t i = 0; i < coeff_base_mod_count_; i++)
+            size_t block_size = conversion_block_size(coeff_base_mod_count_);
+            auto scaled(allocate_uint(
+                mul_safe(block_size, coeff_base_mod_count_), pool));
+            for (size_t k = 0; k < coeff_count_; k += block_size)
             {
-                uint64_t inv_coeff_base_products_mod_coeff_elt = 
-                    inv_coeff_base_products_mod_coeff_array_[i];
-                SmallModulus coeff_base_array_elt = coeff_base_array_[i];
-                for (size_t k = 0; k < coeff_count_; k++, input++)
-                {
-                    temp_coeff_transition[i + (k * coeff_base_mod_count_)] = 
-                        multiply_uint_uint_mod(
-                            *input, 
-                            inv_coeff_base_products_mod_coeff_elt, 
-                            coeff_base_array_elt
-                        );
-                }
-            }
+                size_t block_count = min(block_size, coeff_count_ - k);
+                scale_block(input + k, coeff_count_,
+                    inv_coeff_base_products_mod_coeff_operands_.get(),
+                    coeff_base_array_.get(), coeff_base_mod_count_, block_count,
+                    scaled.get());
 
-            for (size_t j = 0; j < bsk_base_mod_count_; j++)
-            {
-                uint64_t *temp_coeff_transition_ptr = temp_coeff_transition.get();
-                SmallModulus bsk_base_array_elt = bsk_base_array_[j];
-                for (size_t k = 0; k < coeff_count_; k++, destination++)
+                // Products are 60 bit + 61 bit = 121 bit, so coeff_base_mod_count_ <= 127
+                for (size_t j = 0; j < bsk_base_mod_count_; j++)
                 {
-                    const uint64_t *coeff_base_products_mod_aux_bsk_array_ptr = 
-                        coeff_base_products_mod_aux_bsk_array_[j].get();
-                    unsigned long long aux_transition[2]{ 0, 0 };
-                    for (size_t i = 0; i < coeff_base_mod_count_; 
-                        i++, temp_coeff_transition_ptr++,
-                            coeff_base_products_mod_aux_bsk_array_ptr++)
-                    {
-                        // Lazy reduction
-                        unsigned long long temp[2];
-
-                        // Product is 60 bit + 61 bit = 121 bit, so can sum up to 127 of them with no reduction
-                        // Thus need coeff_base_mod_count_ <= 127 to guarantee success
-                        multiply_uint64(*temp_coeff_transition_ptr, 
-                            *coeff_base_products_mod_aux_bsk_array_ptr, temp);
-                        unsigned char carry = add_uint64(aux_transition[0], 
-                            temp[0], aux_transition);
-                        aux_transition[1] += temp[1] + carry;
-                    }
-                    *destination = barrett_reduce_128(aux_transition, bsk_base_array_elt);
+                    convert_block_row(scaled.get(), coeff_base_mod_count_, block_count,
+                        coeff_base_products_mod_aux_bsk_array_[j].get(),
+                        bsk_base_array_[j], destination + k + j * coeff_count_);
                 }
             }
         }
@@ -589,93 +942,46 @@ namespace seal
              Ensure: Output in base q
             */
 
-            // Fast convert B -> q
-            auto temp_coeff_transition(allocate_uint(
-                mul_safe(coeff_count_, aux_base_mod_count_), pool));
-            const uint64_t *input_ptr = input;
-            for (size_t i = 0; i < aux_base_mod_count_; i++)
+            // Fast convert B -> q, and B -> m_sk for computing alpha_sk
+            auto tmp(allocate_uint(coeff_count_, pool));
+            size_t block_size = conversion_block_size(aux_base_mod_count_);
+            auto scaled(allocate_uint(
+                mul_safe(block_size, aux_base_mod_count_), pool));
+            for (size_t k = 0; k < coeff_count_; k += block_size)
             {
-                uint64_t inv_aux_base_products_mod_aux_array_elt = 
-                    inv_aux_base_products_mod_aux_array_[i];
-                SmallModulus aux_base_array_elt = aux_base_array_[i];
-                for (size_t k = 0; k < coeff_count_; k++)
-                {
-                    temp_coeff_transition[i + (k * aux_base_mod_count_)] = 
-                        multiply_uint_uint_mod(
-                            *input_ptr++, 
-                            inv_aux_base_products_mod_aux_array_elt, 
-                            aux_base_array_elt
-                        );
-                }
-            }
+                size_t block_count = min(block_size, coeff_count_ - k);
+                scale_block(input + k, coeff_count_,
+                    inv_aux_base_products_mod_aux_operands_.get(),
+                    aux_base_array_.get(), aux_base_mod_count_, block_count,
+                    scaled.get());
 
-            uint64_t *destination_ptr = destination;
-            uint64_t *temp_ptr;
-            for (size_t j = 0; j < coeff_base_mod_count_; j++)
-            {
-                temp_ptr = temp_coeff_transition.get();
-                SmallModulus coeff_base_array_elt = coeff_base_array_[j];
-                for (size_t k = 0; k < coeff_count_; k++, destination_ptr++)
+                // Products are 61 bit + 60 bit = 121 bit, so aux_base_mod_count_ <= 127
+                for (size_t j = 0; j < coeff_base_mod_count_; j++)
                 {
-                    const uint64_t *aux_base_products_mod_coeff_array_ptr = 
-                        aux_base_products_mod_coeff_array_[j].get();
-                    unsigned long long aux_transition[2]{ 0, 0 };
-                    for (size_t i = 0; i < aux_base_mod_count_; i++, temp_ptr++, 
-                        aux_base_products_mod_coeff_array_ptr++)
-                    {
-                        // Lazy reduction
-                        unsigned long long temp[2];
-
-                        // Product is 61 bit + 60 bit = 121 bit, so can sum up to 127 of them with no reduction
-                        // Thus need aux_base_mod_count_ <= 127, so coeff_base_mod_count_ <= 126 to guarantee success
-                        multiply_uint64(*temp_ptr, *aux_base_products_mod_coeff_array_ptr, temp);
-                        unsigned char carry = add_uint64(aux_transition[0], temp[0], aux_transition);
-                        aux_transition[1] += temp[1] + carry;
-                    }
-                    *destination_ptr = barrett_reduce_128(aux_transition, coeff_base_array_elt);
+                    convert_block_row(scaled.get(), aux_base_mod_count_, block_count,
+                        aux_base_products_mod_coeff_array_[j].get(),
+                        coeff_base_array_[j], destination + k + j * coeff_count_);
                 }
-            }
-            
-            // Compute alpha_sk
-            // Require: Input is in Bsk
-            // we only use coefficient in B
-            // Fast convert B -> m_sk
-            auto tmp(allocate_uint(coeff_count_, pool));
-            destination_ptr = tmp.get();
-            temp_ptr = temp_coeff_transition.get();
-            for (size_t k = 0; k < coeff_count_; k++, destination_ptr++)
-            {
-                unsigned long long msk_transition[2]{ 0, 0 };
-                const uint64_t *aux_base_products_mod_msk_array_ptr = 
-                    aux_base_products_mod_msk_array_.get();
-                for (size_t i = 0; i < aux_base_mod_count_; i++, temp_ptr++, 
-                    aux_base_products_mod_msk_array_ptr++)
-                {
-                    // Lazy reduction
-                    unsigned long long temp[2];
 
-                    // Product is 61 bit + 61 bit = 122 bit, so can sum up to 63 of them with no reduction
-                    // Thus need aux_base_mod_count_ <= 63, so coeff_base_mod_count_ <= 62 to guarantee success
-                    // This gives the strongest restriction on the number of coeff modulus primes
-                    multiply_uint64(*temp_ptr, *aux_base_products_mod_msk_array_ptr, temp);
-                    unsigned char carry = add_uint64(msk_transition[0], temp[0], msk_transition);
-                    msk_transition[1] += temp[1] + carry;
-                }
-                *destination_ptr = barrett_reduce_128(msk_transition, m_sk_);
+                // Products are 61 bit + 61 bit = 122 bit, so we need aux_base_mod_count_ <= 63,
+                // i.e., coeff_base_mod_count_ <= 62. This gives the strongest restriction on
+                // the number of coeff modulus primes.
+                convert_block_row(scaled.get(), aux_base_mod_count_, block_count,
+                    aux_base_products_mod_msk_array_.get(), m_sk_, tmp.get() + k);
             }
 
             auto alpha_sk(allocate_uint(coeff_count_, pool));
-            input_ptr = input + (aux_base_mod_count_ * coeff_count_);
-            destination_ptr = alpha_sk.get();
-            temp_ptr = tmp.get();
+            const uint64_t *input_ptr = input + (aux_base_mod_count_ * coeff_count_);
+            uint64_t *destination_ptr = alpha_sk.get();
+            uint64_t *temp_ptr = tmp.get();
             const uint64_t m_sk_value = m_sk_.value();
             // x_sk is allocated in input[aux_base_mod_count_]
             for (size_t i = 0; i < coeff_count_; i++, input_ptr++, temp_ptr++, destination_ptr++)
             {
                 // It is not necessary for the negation to be reduced modulo the small prime
                 uint64_t negated_input = m_sk_value - *input_ptr;
-                *destination_ptr = multiply_uint_uint_mod(*temp_ptr + negated_input, 
-                    inv_aux_products_mod_msk_, m_sk_);
+                *destination_ptr = multiply_uint_mod(*temp_ptr + negated_input, 
+                    inv_aux_products_mod_msk_operand_, m_sk_);
             }
 
             const uint64_t m_sk_div_2 = m_sk_value >> 1;
@@ -735,32 +1041,25 @@ namespace seal
             */
             const uint64_t *input_m_tilde_ptr = 
                 input + mul_safe(coeff_count_, bsk_base_mod_count_);
-            for (size_t k = 0; k < bsk_base_mod_count_; k++)
+            for (size_t i = 0; i < coeff_count_; i++, input_m_tilde_ptr++)
             {
-                uint64_t coeff_products_all_mod_bsk_array_elt = 
-                    coeff_products_all_mod_bsk_array_[k];
-                uint64_t inv_mtilde_mod_bsk_array_elt = inv_mtilde_mod_bsk_array_[k];
-                SmallModulus bsk_base_array_elt = bsk_base_array_[k];
-                const uint64_t *input_m_tilde_ptr_copy = input_m_tilde_ptr;
+                // Compute r_mtilde once for all Bsk primes
+                uint64_t r_mtilde = multiply_uint_mod(*input_m_tilde_ptr, 
+                    inv_coeff_products_mod_mtilde_operand_, m_tilde_);
+                r_mtilde = negate_uint_mod(r_mtilde, m_tilde_);
 
                 // Compute result for aux base
-                for (size_t i = 0; i < coeff_count_; i++, destination++, 
-                    input_m_tilde_ptr_copy++, input++)
+                for (size_t k = 0; k < bsk_base_mod_count_; k++)
                 {
-                    // Compute r_mtilde
-                    // Duplicate work here:  
-                    // This needs to be computed only once per coefficient, not per Bsk prime.
-                    uint64_t r_mtilde = multiply_uint_uint_mod(*input_m_tilde_ptr_copy, 
-                        inv_coeff_products_mod_mtilde_, m_tilde_);
-                    r_mtilde = negate_uint_mod(r_mtilde, m_tilde_);
+                    size_t index = i + k * coeff_count_;
 
                     // Lazy reduction
                     unsigned long long tmp[2];
-                    multiply_uint64(coeff_products_all_mod_bsk_array_elt, r_mtilde, tmp);
-                    tmp[1] += add_uint64(tmp[0], *input, tmp);
-                    r_mtilde = barrett_reduce_128(tmp, bsk_base_array_elt);
-                    *destination = multiply_uint_uint_mod(
-                        r_mtilde, inv_mtilde_mod_bsk_array_elt, bsk_base_array_elt);
+                    multiply_uint64(coeff_products_all_mod_bsk_array_[k], r_mtilde, tmp);
+                    tmp[1] += add_uint64(tmp[0], input[index], tmp);
+                    uint64_t sum = barrett_reduce_128(tmp, bsk_base_array_[k]);
+                    destination[index] = multiply_uint_mod(
+                        sum, inv_mtilde_mod_bsk_operands_[k], bsk_base_array_[k]);
                 }
             }
         }
@@ -794,16 +1093,16 @@ namespace seal
             {
                 SmallModulus bsk_base_array_elt = bsk_base_array_[i];
                 uint64_t bsk_base_array_value = bsk_base_array_elt.value();
-                uint64_t inv_coeff_products_all_mod_aux_bsk_array_elt = 
-                    inv_coeff_products_all_mod_aux_bsk_array_[i];
+                const MultiplyUIntModOperand &inv_coeff_products_all_mod_aux_bsk_elt = 
+                    inv_coeff_products_all_mod_aux_bsk_operands_[i];
                 for (size_t k = 0; k < coeff_count_; k++, input++, destination++)
                 {
                     // It is not necessary for the negation to be reduced modulo the small prime
                     //negate_uint_smallmod(base_convert_Bsk.get() + k + (i * coeff_count_), 
                     // bsk_base_array_[i], &negated_base_convert_Bsk);
-                    *destination = multiply_uint_uint_mod(
+                    *destination = multiply_uint_mod(
                         *input + bsk_base_array_value - *destination, 
-                        inv_coeff_products_all_mod_aux_bsk_array_elt, 
+                        inv_coeff_products_all_mod_aux_bsk_elt, 
                         bsk_base_array_elt
                     );
                 }
@@ -832,76 +1131,31 @@ namespace seal
              Ensure: Output in Bsk U {m_tilde}
             */
             
-            // Compute in Bsk first; we compute |m_tilde*q^-1i| mod qi
-            auto temp_coeff_transition(allocate_uint(
-                mul_safe(coeff_count_, coeff_base_mod_count_), pool));
-            for (size_t i = 0; i < coeff_base_mod_count_; i++)
+            // Compute |m_tilde*q^-1i| mod qi, then convert to Bsk and m_tilde
+            size_t block_size = conversion_block_size(coeff_base_mod_count_);
+            auto scaled(allocate_uint(
+                mul_safe(block_size, coeff_base_mod_count_), pool));
+            uint64_t *destination_mtilde = destination + bsk_base_mod_count_ * coeff_count_;
+            for (size_t k = 0; k < coeff_count_; k += block_size)
             {
-                SmallModulus coeff_base_array_elt = coeff_base_array_[i];
-                uint64_t mtilde_inv_coeff_base_products_mod_coeff_elt = 
-                    mtilde_inv_coeff_base_products_mod_coeff_array_[i];
-                for (size_t k = 0; k < coeff_count_; k++, input++)
-                {
-                    temp_coeff_transition[i + (k * coeff_base_mod_count_)] = 
-                        multiply_uint_uint_mod(
-                            *input, 
-                            mtilde_inv_coeff_base_products_mod_coeff_elt, 
-                            coeff_base_array_elt
-                        );
-                }
-            }
+                size_t block_count = min(block_size, coeff_count_ - k);
+                scale_block(input + k, coeff_count_,
+                    mtilde_inv_coeff_base_products_mod_coeff_operands_.get(),
+                    coeff_base_array_.get(), coeff_base_mod_count_, block_count,
+                    scaled.get());
 
-            uint64_t *destination_ptr = destination;
-            for (size_t j = 0; j < bsk_base_mod_count_; j++)
-            {
-                const uint64_t *coeff_base_products_mod_aux_bsk_array_ptr = 
-                    coeff_base_products_mod_aux_bsk_array_[j].get();
-                uint64_t *temp_coeff_transition_ptr = temp_coeff_transition.get();
-                SmallModulus bsk_base_array_elt = bsk_base_array_[j];
-                for (size_t k = 0; k < coeff_count_; k++, destination_ptr++)
+                // Products are 60 bit + 61 bit = 121 bit, so coeff_base_mod_count_ <= 127
+                for (size_t j = 0; j < bsk_base_mod_count_; j++)
                 {
-                    unsigned long long aux_transition[2]{ 0, 0 };
-                    const uint64_t *temp_ptr = coeff_base_products_mod_aux_bsk_array_ptr;
-                    for (size_t i = 0; i < coeff_base_mod_count_; 
-                        i++, temp_ptr++, temp_coeff_transition_ptr++)
-                    {
-                        // Lazy reduction
-                        unsigned long long temp[2]{ 0, 0 };
-
-                        // Product is 60 bit + 61 bit = 121 bit, so can sum up to 127 of them with no reduction
-                        // Thus need coeff_base_mod_count_ <= 127
-                        multiply_uint64(*temp_coeff_transition_ptr, *temp_ptr, temp);
-                        unsigned char carry = add_uint64(aux_transition[0], 
-                            temp[0], aux_transition);
-                        aux_transition[1] += temp[1] + carry;
-                    }
-                    *destination_ptr = barrett_reduce_128(aux_transition, bsk_base_array_elt);
+                    convert_block_row(scaled.get(), coeff_base_mod_count_, block_count,
+                        coeff_base_products_mod_aux_bsk_array_[j].get(),
+                        bsk_base_array_[j], destination + k + j * coeff_count_);
                 }
-            }
-            
-            // Computing the last element (mod m_tilde) and add it at the end of destination array
-            uint64_t *temp_coeff_transition_ptr = temp_coeff_transition.get();
-            destination += bsk_base_mod_count_ * coeff_count_;
-            for (size_t k = 0; k < coeff_count_; k++, destination++)
-            {
-                unsigned long long wide_result[2]{ 0, 0 };
-                const uint64_t *coeff_base_products_mod_mtilde_array_ptr = 
-                    coeff_base_products_mod_mtilde_array_.get();
-                for (size_t i = 0; i < coeff_base_mod_count_; i++,
-                    temp_coeff_transition_ptr++, 
-                    coeff_base_products_mod_mtilde_array_ptr++)
-                {
-                    // Lazy reduction
-                    unsigned long long aux_transition[2];
 
-                    // Product is 60 bit + 33 bit = 93 bit
-                    multiply_uint64(*temp_coeff_transition_ptr,
-                        *coeff_base_products_mod_mtilde_array_ptr, aux_transition);
-                    unsigned char carry = add_uint64(aux_transition[0], 
-                        wide_result[0], wide_result);
-                    wide_result[1] += aux_transition[1] + carry;
-                }
-                *destination = barrett_reduce_128(wide_result, m_tilde_);
+                // Products are 60 bit + 33 bit = 93 bit
+                convert_block_row(scaled.get(), coeff_base_mod_count_, block_count,
+                    coeff_base_products_mod_mtilde_array_.get(), m_tilde_,
+                    destination_mtilde + k);
             }
         }
 
@@ -926,48 +1180,64 @@ namespace seal
              Require: Input in q
              Ensure: Output in t (plain modulus) U gamma 
             */
-            auto temp_coeff_transition(allocate_uint(
-                mul_safe(coeff_count_, coeff_base_mod_count_), pool));
-            for (size_t i = 0; i < coeff_base_mod_count_; i++)
+            size_t block_size = conversion_block_size(coeff_base_mod_count_);
+            auto scaled(allocate_uint(
+                mul_safe(block_size, coeff_base_mod_count_), pool));
+            for (size_t k = 0; k < coeff_count_; k += block_size)
             {
-                uint64_t inv_coeff_base_products_mod_coeff_elt = 
-                    inv_coeff_base_products_mod_coeff_array_[i];
-                SmallModulus coeff_base_array_elt = coeff_base_array_[i];
-                for (size_t k = 0; k < coeff_count_; k++, input++)
+                size_t block_count = min(block_size, coeff_count_ - k);
+                scale_block(input + k, coeff_count_,
+                    inv_coeff_base_products_mod_coeff_operands_.get(),
+                    coeff_base_array_.get(), coeff_base_mod_count_, block_count,
+                    scaled.get());
+
+                // Products are 60 bit + 61 bit = 121 bit, so coeff_base_mod_count_ <= 127
+                for (size_t j = 0; j < plain_gamma_count_; j++)
                 {
-                    temp_coeff_transition[i + (k * coeff_base_mod_count_)] = 
-                        multiply_uint_uint_mod(
-                            *input, 
-                            inv_coeff_base_products_mod_coeff_elt, 
-                            coeff_base_array_elt
-                        );
+                    convert_block_row(scaled.get(), coeff_base_mod_count_, block_count,
+                        coeff_products_mod_plain_gamma_array_[j].get(),
+                        plain_gamma_array_[j], destination + k + j * coeff_count_);
                 }
             }
+        }
 
-            for (size_t j = 0; j < plain_gamma_count_; j++)
+        void BaseConverter::mixed_radix(const uint64_t *input, 
+            uint64_t *destination) const
+        {
+#ifdef SEAL_DEBUG
+            if (input == nullptr)
+            {
+                throw invalid_argument("input cannot be null");
+            }
+            if (destination == nullptr)
+            {
+                throw invalid_argument("destination cannot be null");
+            }
+#endif
+            // d_i = (x_i - d_0 - d_1 q_0 - ... - d_{i-1} q_0...q_{i-2}) / (q_0...q_{i-1}) 
+            // mod q_i, where the digits d_j < q_j need no reduction modulo q_i 
+            // before being multiplied
+            if (input != destination)
             {
-                SmallModulus plain_gamma_array_elt = plain_gamma_array_[j];
-                uint64_t *temp_coeff_transition_ptr = temp_coeff_transition.get();
-                const uint64_t *coeff_products_mod_plain_gamma_array_ptr = 
-                    coeff_products_mod_plain_gamma_array_[j].get();
-                for (size_t k = 0; k < coeff_count_; k++, destination++)
+                set_uint_uint(input, mul_safe(coeff_count_, coeff_base_mod_count_),
+                    destination);
+            }
+            for (size_t i = 1; i < coeff_base_mod_count_; i++)
+            {
+                auto &modulus = coeff_base_array_[i];
+                const MultiplyUIntModOperand *operands = 
+                    mixed_radix_operands_.get() + (i * coeff_base_mod_count_);
+                uint64_t *digits = destination + (i * coeff_count_);
+                for (size_t k = 0; k < coeff_count_; k++)
                 {
-                    unsigned long long wide_result[2]{ 0, 0 };
-                    const uint64_t *temp_ptr = coeff_products_mod_plain_gamma_array_ptr;
-                    for (size_t i = 0; i < coeff_base_mod_count_; i++,
-                        temp_coeff_transition_ptr++, temp_ptr++)
+                    uint64_t digit = multiply_uint_mod(digits[k], operands[i], modulus);
+                    for (size_t j = 0; j < i; j++)
                     {
-                        unsigned long long plain_transition[2];
-
-                        // Lazy reduction
-                        // Product is 60 bit + 61 bit = 121 bit, so can sum up to 127 of them with no reduction
-                        // Thus need coeff_base_mod_count_ <= 127
-                        multiply_uint64(*temp_coeff_transition_ptr, *temp_ptr, plain_transition);
-                        unsigned char carry = add_uint64(plain_transition[0], 
-                            wide_result[0], wide_result);
-                        wide_result[1] += plain_transition[1] + carry;
+                        digit = add_uint_uint_mod(digit, multiply_uint_mod(
+                            destination[k + (j * coeff_count_)], operands[j], modulus),
+                            modulus);
                     }
-                    *destination = barrett_reduce_128(wide_result, plain_gamma_array_elt);
+                    digits[k] = digit;
                 }
             }
         }
@@ -6,10 +6,12 @@
 #include <stdexcept>
 #include <vector>
 #include <memory>
+#include <iostream>
 #include "seal/util/pointer.h"
 #include "seal/memorymanager.h"
 #include "seal/smallmodulus.h"
 #include "seal/util/smallntt.h"
+#include "seal/util/uintarithsmallmod.h"
 #include "seal/biguint.h"
 
 namespace seal
@@ -32,10 +34,13 @@ namespace seal
                 MemoryPoolHandle pool);
 
             /**
-            Generates the pre-computations for the given parameters.
+            Generates the pre-computations for the given parameters. If shared is
+            given, the NTT tables for any Bsk prime that it already has tables for 
+            are shared with it instead of being generated again.
             */
             void generate(const std::vector<SmallModulus> &coeff_base, 
-                std::size_t coeff_count, const SmallModulus &small_plain_mod);
+                std::size_t coeff_count, const SmallModulus &small_plain_mod,
+                const BaseConverter *shared = nullptr);
 
             /**
             Fast base converter from q to Bsk
@@ -73,8 +78,31 @@ namespace seal
             void fastbconv_plain_gamma(const std::uint64_t *input, 
                 std::uint64_t *destination, MemoryPoolHandle pool) const;
 
+            /**
+            Conversion from q to mixed radix form: every coefficient x in [0, q) 
+            is written as d_0 + d_1 q_0 + ... + d_{k-1} q_0...q_{k-2} with digits 
+            0 <= d_j < q_j, stored where the residues modulo q_j were. Numbers in 
+            this form compare digit by digit from the last one, so they can be 
+            ordered without multi-precision arithmetic. Input and destination 
+            may be the same.
+            */
+            void mixed_radix(const std::uint64_t *input, 
+                std::uint64_t *destination) const;
+
             void reset() noexcept;
 
+            /**
+            Saves the pre-computations to an output stream so that they can be 
+            restored with load instead of calling generate again.
+            */
+            void save(std::ostream &stream) const;
+
+            /**
+            Loads pre-computations previously written by save, overwriting the 
+            current ones.
+            */
+            void load(std::istream &stream);
+
             inline auto is_generated() const noexcept
             {
                 return generated_;
@@ -165,6 +193,11 @@ namespace seal
                 return coeff_base_products_mod_aux_bsk_array_[bsk_base_mod_count_ - 1];
             }
 
+            inline auto &get_inv_last_coeff_mod_operands() const noexcept
+            {
+                return inv_last_coeff_mod_operands_;
+            }
+
         private:
             BaseConverter(const BaseConverter &copy) = delete;
 
@@ -174,6 +207,10 @@ namespace seal
 
             BaseConverter &operator =(BaseConverter &&assign) = delete;
 
+            // Precomputes the Shoup quotients of the constants that the conversions
+            // multiply by; called once all other pre-computations are in place
+            void generate_multiply_operands();
+
             MemoryPoolHandle pool_;
 
             bool generated_ = false;
@@ -260,6 +297,28 @@ namespace seal
             // For modulus switching: inverses of the last coeff base modulus
             Pointer<std::uint64_t> inv_last_coeff_mod_array_;
 
+            // Shoup operands for the constants that are multiplied by in every
+            // conversion; these are not saved but recomputed by load
+            Pointer<MultiplyUIntModOperand> inv_coeff_base_products_mod_coeff_operands_;
+
+            Pointer<MultiplyUIntModOperand> mtilde_inv_coeff_base_products_mod_coeff_operands_;
+
+            Pointer<MultiplyUIntModOperand> inv_aux_base_products_mod_aux_operands_;
+
+            Pointer<MultiplyUIntModOperand> inv_coeff_products_all_mod_aux_bsk_operands_;
+
+            Pointer<MultiplyUIntModOperand> inv_mtilde_mod_bsk_operands_;
+
+            Pointer<MultiplyUIntModOperand> inv_last_coeff_mod_operands_;
+
+            // Row i holds -(q_0...q_{j-1}) / (q_0...q_{i-1}) mod q_i for j < i and
+            // 1 / (q_0...q_{i-1}) mod q_i for j = i, for the mixed radix conversion
+            Pointer<MultiplyUIntModOperand> mixed_radix_operands_;
+
+            MultiplyUIntModOperand inv_coeff_products_mod_mtilde_operand_;
+
+            MultiplyUIntModOperand inv_aux_products_mod_msk_operand_;
+
             SmallModulus m_tilde_;
 
             SmallModulus m_sk_;
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <new>
+#include <cstdint>
+#include "seal/util/hugepages.h"
+#include "seal/util/common.h"
+
+#ifdef SEAL_USE_HUGE_PAGES
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+#ifdef SEAL_USE_HUGE_PAGES
+        namespace
+        {
+            // Memory policy from <numaif.h>; we avoid depending on libnuma
+            constexpr int mpol_preferred = 1;
+
+            inline size_t round_to_huge_pages(size_t byte_count)
+            {
+                return mul_safe(add_safe(byte_count, huge_page_byte_count - 1) / 
+                    huge_page_byte_count, huge_page_byte_count);
+            }
+
+            // Prefers the NUMA node of the calling thread for the given range.
+            // Failure is harmless: the kernel then uses its default policy.
+            void bind_to_local_node(void *data, size_t byte_count) noexcept
+            {
+                unsigned cpu = 0;
+                unsigned node = 0;
+                if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+                {
+                    return;
+                }
+                constexpr size_t mask_bit_count = 
+                    sizeof(unsigned long) * static_cast<size_t>(bits_per_byte);
+                unsigned long node_mask[16]{};
+                if (node >= mask_bit_count * 16)
+                {
+                    return;
+                }
+                node_mask[node / mask_bit_count] = 1UL << (node % mask_bit_count);
+                syscall(SYS_mbind, data, byte_count, mpol_preferred, 
+                    node_mask, mask_bit_count * 16 + 1, 0);
+            }
+        }
+
+        bool huge_pages_supported() noexcept
+        {
+            return true;
+        }
+
+        SEAL_BYTE *allocate_huge_pages(size_t byte_count)
+        {
+            size_t map_byte_count = round_to_huge_pages(byte_count);
+
+            // First try explicitly reserved huge pages
+            void *data = mmap(nullptr, map_byte_count, PROT_READ | PROT_WRITE, 
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (data == MAP_FAILED)
+            {
+                // Fall back to a 2 MB aligned mapping with transparent huge pages;
+                // over-allocate and unmap the unaligned head and tail
+                size_t over_byte_count = add_safe(map_byte_count, huge_page_byte_count);
+                void *over_data = mmap(nullptr, over_byte_count, 
+                    PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (over_data == MAP_FAILED)
+                {
+                    throw bad_alloc();
+                }
+                uintptr_t start = reinterpret_cast<uintptr_t>(over_data);
+                uintptr_t aligned_start = (start + huge_page_byte_count - 1) & 
+                    ~static_cast<uintptr_t>(huge_page_byte_count - 1);
+                size_t head_byte_count = static_cast<size_t>(aligned_start - start);
+                size_t tail_byte_count = 
+                    over_byte_count - head_byte_count - map_byte_count;
+                if (head_byte_count)
+                {
+                    munmap(over_data, head_byte_count);
+                }
+                if (tail_byte_count)
+                {
+                    munmap(reinterpret_cast<void*>(aligned_start + map_byte_count), 
+                        tail_byte_count);
+                }
+                data = reinterpret_cast<void*>(aligned_start);
+#ifdef MADV_HUGEPAGE
+                madvise(data, map_byte_count, MADV_HUGEPAGE);
+#endif
+            }
+
+            // Pages are not yet touched, so the policy takes effect on first use
+            bind_to_local_node(data, map_byte_count);
+            return static_cast<SEAL_BYTE*>(data);
+        }
+
+        void free_huge_pages(SEAL_BYTE *data, size_t byte_count) noexcept
+        {
+            if (data)
+            {
+                munmap(data, round_to_huge_pages(byte_count));
+            }
+        }
+#else
+        bool huge_pages_supported() noexcept
+        {
+            return false;
+        }
+
+        SEAL_BYTE *allocate_huge_pages(size_t byte_count)
+        {
+            return new SEAL_BYTE[byte_count];
+        }
+
+        void free_huge_pages(SEAL_BYTE *data, size_t) noexcept
+        {
+            delete[] data;
+        }
+#endif
+    }
+}
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include "seal/util/defines.h"
+
+namespace seal
+{
+    namespace util
+    {
+        // Size of a huge page; allocations are rounded up to a multiple of this
+        constexpr std::size_t huge_page_byte_count = std::size_t(1) << 21;
+
+        /**
+        Returns whether huge-page backed allocations are supported on this 
+        platform. If not, allocate_huge_pages falls back to ordinary heap memory.
+        */
+        bool huge_pages_supported() noexcept;
+
+        /**
+        Allocates byte_count bytes of memory backed by 2 MB huge pages and binds 
+        it to the NUMA node of the calling thread. Explicitly reserved huge pages 
+        are used when available; otherwise the memory is aligned to 2 MB and marked 
+        for transparent huge pages. The memory must be released with 
+        free_huge_pages using the same byte_count.
+
+        @param[in] byte_count The number of bytes to allocate
+        @throws std::bad_alloc if the allocation fails
+        */
+        SEAL_BYTE *allocate_huge_pages(std::size_t byte_count);
+
+        /**
+        Releases memory allocated with allocate_huge_pages.
+
+        @param[in] data Pointer returned by allocate_huge_pages
+        @param[in] byte_count The byte_count passed to allocate_huge_pages
+        */
+        void free_huge_pages(SEAL_BYTE *data, std::size_t byte_count) noexcept;
+    }
+}
@@ -6,8 +6,11 @@
 #include <numeric>
 #include <stdexcept>
 #include <algorithm>
+#include <limits>
+#include <new>
 #include "seal/util/mempool.h"
 #include "seal/util/common.h"
+#include "seal/util/hugepages.h"
 #include "seal/util/uintarith.h"
 
 using namespace std;
@@ -16,12 +19,80 @@ namespace seal
 {
     namespace util
     {
+        namespace
+        {
+            // Allocates memory for a batch of items, from huge pages if requested 
+            // and the batch fills at least one huge page
+            inline SEAL_BYTE *allocate_batch(size_t byte_count, bool huge_pages)
+            {
+                if (huge_pages && byte_count >= huge_page_byte_count)
+                {
+                    return allocate_huge_pages(byte_count);
+                }
+                return new SEAL_BYTE[byte_count];
+            }
+
+            inline void free_batch(SEAL_BYTE *data, size_t byte_count, 
+                bool huge_pages) noexcept
+            {
+                if (huge_pages && byte_count >= huge_page_byte_count)
+                {
+                    free_huge_pages(data, byte_count);
+                }
+                else
+                {
+                    delete[] data;
+                }
+            }
+
+            // Deletes idle pool heads, least recently used first, until the total 
+            // allocation of the remaining heads is at most target_byte_count. The 
+            // caller must guarantee exclusive access to pools.
+            size_t release_idle_heads(vector<MemoryPoolHead*> &pools, 
+                size_t target_byte_count)
+            {
+                size_t total_byte_count = 0;
+                vector<MemoryPoolHead*> idle_heads;
+                for (MemoryPoolHead *head : pools)
+                {
+                    MemoryPoolStats head_stats = head->stats();
+                    total_byte_count = add_safe(total_byte_count, 
+                        mul_safe(head_stats.item_count, head_stats.item_byte_count));
+                    if (head_stats.in_use_item_count == 0)
+                    {
+                        idle_heads.push_back(head);
+                    }
+                }
+
+                stable_sort(idle_heads.begin(), idle_heads.end(), 
+                    [](MemoryPoolHead *a, MemoryPoolHead *b) {
+                        return a->last_use() < b->last_use();
+                    });
+
+                size_t released_byte_count = 0;
+                for (MemoryPoolHead *head : idle_heads)
+                {
+                    if (total_byte_count <= target_byte_count)
+                    {
+                        break;
+                    }
+                    size_t head_byte_count = 
+                        mul_safe(head->item_count(), head->item_byte_count());
+                    pools.erase(find(pools.begin(), pools.end(), head));
+                    delete head;
+                    total_byte_count -= head_byte_count;
+                    released_byte_count += head_byte_count;
+                }
+                return released_byte_count;
+            }
+        }
+
         MemoryPoolHeadMT::MemoryPoolHeadMT(size_t item_byte_count,
-            bool clear_on_destruction) : 
-            clear_on_destruction_(clear_on_destruction),
+            bool clear_on_destruction, bool huge_pages) : 
+            clear_on_destruction_(clear_on_destruction), huge_pages_(huge_pages),
             locked_(false), item_byte_count_(item_byte_count), 
-            item_count_(MemoryPool::first_alloc_count), 
-            first_item_(nullptr)
+            item_count_(0), in_use_item_count_(0), peak_in_use_item_count_(0),
+            alloc_failure_count_(0), free_top_(0)
         {
             if ((item_byte_count_ == 0) || 
                 (item_byte_count_ > MemoryPool::max_batch_alloc_byte_count) ||
@@ -31,24 +102,30 @@ namespace seal
                 throw invalid_argument("invalid allocation size");
             }
 
+            for (auto &segment : segments_)
+            {
+                segment.store(nullptr, memory_order_relaxed);
+            }
+
             // Initial allocation
-            allocation new_alloc;
             try
             {
-                new_alloc.data_ptr = new SEAL_BYTE[
-                    mul_safe(MemoryPool::first_alloc_count, item_byte_count_)];
+                Node *first_node = grow(MemoryPool::first_alloc_count);
+                push(first_node, first_node);
             }
-            catch (const bad_alloc &)
+            catch (...)
             {
-                // Allocation failed; rethrow
+                for (auto &segment : segments_)
+                {
+                    ::operator delete(segment.load(memory_order_relaxed));
+                }
+                for (auto &alloc : allocs_)
+                {
+                    free_batch(alloc.data_ptr, mul_safe(item_byte_count_, alloc.size), 
+                        huge_pages_);
+                }
                 throw;
             }
-
-            new_alloc.size = MemoryPool::first_alloc_count;
-            new_alloc.free = MemoryPool::first_alloc_count;
-            new_alloc.head_ptr = new_alloc.data_ptr;
-            allocs_.clear();
-            allocs_.push_back(new_alloc);
         }
 
         MemoryPoolHeadMT::~MemoryPoolHeadMT() noexcept
@@ -60,15 +137,14 @@ namespace seal
                 expected = false;
             }
 
-            // Delete the items (but not the memory)
-            MemoryPoolItem *curr_item = first_item_;
-            while (curr_item)
+            // Delete the items (but not the memory); nodes are trivially 
+            // destructible so it suffices to release the segments
+            free_top_.store(0, memory_order_relaxed);
+            for (auto &segment : segments_)
             {
-                MemoryPoolItem *next_item = curr_item->next();
-                delete curr_item;
-                curr_item = next_item;
+                ::operator delete(segment.load(memory_order_relaxed));
+                segment.store(nullptr, memory_order_relaxed);
             }
-            first_item_ = nullptr;
 
             // Do we need to clear the memory?
             if (clear_on_destruction_)
@@ -84,7 +160,8 @@ namespace seal
                     }
 
                     // Delete this allocation
-                    delete[] alloc.data_ptr;
+                    free_batch(alloc.data_ptr, mul_safe(item_byte_count_, alloc.size), 
+                        huge_pages_);
                 }
             }
             else
@@ -93,87 +170,152 @@ namespace seal
                 for (auto &alloc : allocs_)
                 {
                     // Delete this allocation
-                    delete[] alloc.data_ptr;
+                    free_batch(alloc.data_ptr, mul_safe(item_byte_count_, alloc.size), 
+                        huge_pages_);
                 }
             }
 
             allocs_.clear();
         }
 
-        MemoryPoolItem *MemoryPoolHeadMT::get()
+        MemoryPoolHeadMT::Node *MemoryPoolHeadMT::grow(size_t count)
         {
-            bool expected = false;
-            while (!locked_.compare_exchange_strong(
-                expected, true, memory_order_acquire))
+            size_t first_index = item_count_.load(memory_order_relaxed);
+            if (count > static_cast<size_t>(numeric_limits<uint32_t>::max()) - 
+                first_index)
             {
-                expected = false;
+                throw runtime_error("maximum item count reached");
             }
-            MemoryPoolItem *old_first = first_item_;
 
-            // Is pool empty?
-            if (old_first == nullptr)
+            // Make sure all segments needed for the new nodes exist
+            size_t end_position = first_index + count;
+            for (size_t segment = 0; segment < max_segment_count &&
+                (size_t(1) << segment) <= end_position; segment++)
             {
-                allocation &last_alloc = allocs_.back();
-                MemoryPoolItem *new_item = nullptr;
-                if (last_alloc.free > 0)
+                if (!segments_[segment].load(memory_order_relaxed))
                 {
-                    // Pool is empty; there is memory
-                    new_item = new MemoryPoolItem(last_alloc.head_ptr);
-                    last_alloc.free--;
-                    last_alloc.head_ptr += item_byte_count_;
+                    segments_[segment].store(static_cast<Node*>(::operator new(
+                        mul_safe(size_t(1) << segment, sizeof(Node)))),
+                        memory_order_release);
+                }
+            }
+
+            allocation new_alloc;
+            new_alloc.data_ptr = allocate_batch(
+                mul_safe(count, item_byte_count_), huge_pages_);
+            new_alloc.size = count;
+            new_alloc.free = 0;
+            new_alloc.head_ptr = new_alloc.data_ptr + count * item_byte_count_;
+            try
+            {
+                allocs_.push_back(new_alloc);
+            }
+            catch (...)
+            {
+                free_batch(new_alloc.data_ptr, mul_safe(count, item_byte_count_), 
+                    huge_pages_);
+                throw;
+            }
+
+            // Create the nodes and chain all but the first one together
+            Node *first_node = nullptr;
+            Node *prev_node = nullptr;
+            for (size_t i = 0; i < count; i++)
+            {
+                uint32_t index = static_cast<uint32_t>(first_index + i);
+                Node *node = new (node_at(index)) Node(
+                    new_alloc.data_ptr + i * item_byte_count_, index);
+                if (prev_node)
+                {
+                    prev_node->next.store(index + 1, memory_order_relaxed);
                 }
                 else
                 {
-                    // Pool is empty; there is no memory
-                    allocation new_alloc;
+                    first_node = node;
+                }
+                prev_node = node;
+            }
+            item_count_.store(first_index + count, memory_order_relaxed);
+
+            // Publish all but the first node
+            if (count > 1)
+            {
+                push(node_at(static_cast<uint32_t>(first_index + 1)), prev_node);
+            }
+            return first_node;
+        }
+
+        MemoryPoolItem *MemoryPoolHeadMT::get()
+        {
+            // Fast path: lock-free pop from the free stack
+            Node *node = try_pop();
+            if (!node)
+            {
+                bool expected = false;
+                while (!locked_.compare_exchange_strong(
+                    expected, true, memory_order_acquire))
+                {
+                    expected = false;
+                }
 
+                // Another thread may have grown the pool while we waited
+                node = try_pop();
+                if (!node)
+                {
                     // Increase allocation size unless we are already at max
+                    size_t last_size = allocs_.back().size;
                     size_t new_size = safe_cast<size_t>(
                         ceil(MemoryPool::alloc_size_multiplier * 
-                            static_cast<double>(last_alloc.size)));
-                    size_t new_alloc_byte_count = mul_safe(new_size, item_byte_count_);
-                    if (new_alloc_byte_count > 
+                            static_cast<double>(last_size)));
+                    if (mul_safe(new_size, item_byte_count_) > 
                         MemoryPool::max_batch_alloc_byte_count)
                     {
-                        new_size = last_alloc.size;
-                        new_alloc_byte_count = new_size * item_byte_count_;
+                        new_size = last_size;
                     }
 
                     try
                     {
-                        new_alloc.data_ptr = new SEAL_BYTE[new_alloc_byte_count];
+                        node = grow(new_size);
                     }
                     catch (const bad_alloc &)
                     {
-                        // Allocation failed; rethrow
+                        // Allocation failed; record it, release the lock and rethrow
+                        alloc_failure_count_.fetch_add(1, memory_order_relaxed);
+                        locked_.store(false, memory_order_release);
+                        throw;
+                    }
+                    catch (...)
+                    {
+                        locked_.store(false, memory_order_release);
                         throw;
                     }
-
-                    new_alloc.size = new_size;
-                    new_alloc.free = new_size - 1;
-                    new_alloc.head_ptr = new_alloc.data_ptr + item_byte_count_;
-                    allocs_.push_back(new_alloc);
-                    item_count_ += new_size;
-                    new_item = new MemoryPoolItem(new_alloc.data_ptr);
                 }
-
                 locked_.store(false, memory_order_release);
-                return new_item;
             }
 
-            // Pool is not empty
-            first_item_ = old_first->next();
-            old_first->next() = nullptr;
-            locked_.store(false, memory_order_release);
-            return old_first;
+            record_get();
+            return &node->item;
+        }
+
+        MemoryPoolStats MemoryPoolHeadMT::stats() const noexcept
+        {
+            MemoryPoolStats result;
+            result.item_byte_count = item_byte_count_;
+            result.item_count = item_count_.load(memory_order_relaxed);
+            result.in_use_item_count = in_use_item_count_.load(memory_order_acquire);
+            result.peak_in_use_item_count = 
+                peak_in_use_item_count_.load(memory_order_relaxed);
+            result.alloc_failure_count = alloc_failure_count_.load(memory_order_relaxed);
+            return result;
         }
 
         MemoryPoolHeadST::MemoryPoolHeadST(size_t item_byte_count,
-            bool clear_on_destruction) :
-            clear_on_destruction_(clear_on_destruction),
+            bool clear_on_destruction, bool huge_pages) :
+            clear_on_destruction_(clear_on_destruction), huge_pages_(huge_pages),
             item_byte_count_(item_byte_count), 
             item_count_(MemoryPool::first_alloc_count), 
-            first_item_(nullptr)
+            in_use_item_count_(0), peak_in_use_item_count_(0),
+            alloc_failure_count_(0), first_item_(nullptr)
         {
             if ((item_byte_count_ == 0) || 
                 (item_byte_count_ > MemoryPool::max_batch_alloc_byte_count) ||
@@ -187,8 +329,8 @@ namespace seal
             allocation new_alloc;
             try
             {
-                new_alloc.data_ptr = new SEAL_BYTE[
-                    mul_safe(MemoryPool::first_alloc_count, item_byte_count_)];
+                new_alloc.data_ptr = allocate_batch(mul_safe(
+                    MemoryPool::first_alloc_count, item_byte_count_), huge_pages_);
             }
             catch (const bad_alloc &)
             {
@@ -229,7 +371,8 @@ namespace seal
                     }
 
                     // Delete this allocation
-                    delete[] alloc.data_ptr;
+                    free_batch(alloc.data_ptr, mul_safe(item_byte_count_, alloc.size), 
+                        huge_pages_);
                 }
             }
             else
@@ -238,7 +381,8 @@ namespace seal
                 for (auto &alloc : allocs_)
                 {
                     // Delete this allocation
-                    delete[] alloc.data_ptr;
+                    free_batch(alloc.data_ptr, mul_safe(item_byte_count_, alloc.size), 
+                        huge_pages_);
                 }
             }
 
@@ -280,11 +424,13 @@ namespace seal
 
                     try
                     {
-                        new_alloc.data_ptr = new SEAL_BYTE[new_alloc_byte_count];
+                        new_alloc.data_ptr = allocate_batch(
+                            new_alloc_byte_count, huge_pages_);
                     }
                     catch (const bad_alloc &)
                     {
-                        // Allocation failed; rethrow
+                        // Allocation failed; record it and rethrow
+                        alloc_failure_count_++;
                         throw;
                     }
 
@@ -296,15 +442,28 @@ namespace seal
                     new_item = new MemoryPoolItem(new_alloc.data_ptr);
                 }
 
+                record_get();
                 return new_item;
             }
 
             // Pool is not empty
             first_item_ = old_first->next();
             old_first->next() = nullptr;
+            record_get();
             return old_first;
         }
 
+        MemoryPoolStats MemoryPoolHeadST::stats() const noexcept
+        {
+            MemoryPoolStats result;
+            result.item_byte_count = item_byte_count_;
+            result.item_count = item_count_;
+            result.in_use_item_count = in_use_item_count_;
+            result.peak_in_use_item_count = peak_in_use_item_count_;
+            result.alloc_failure_count = alloc_failure_count_;
+            return result;
+        }
+
         const size_t MemoryPool::max_single_alloc_byte_count = 
             []() -> size_t {
                 int bit_shift = static_cast<int>(
@@ -369,7 +528,16 @@ namespace seal
                 }
                 else
                 {
-                    return Pointer<SEAL_BYTE>(mid_head);
+                    mid_head->touch(use_clock_.fetch_add(1, memory_order_relaxed));
+                    size_t old_item_count = mid_head->item_count();
+                    Pointer<SEAL_BYTE> result(mid_head);
+                    bool grown = (mid_head->item_count() != old_item_count);
+                    reader_lock.unlock();
+                    if (grown)
+                    {
+                        enforce_capacity();
+                    }
+                    return result;
                 }
             }
             reader_lock.unlock();
@@ -393,7 +561,16 @@ namespace seal
                 }
                 else
                 {
-                    return Pointer<SEAL_BYTE>(mid_head);
+                    mid_head->touch(use_clock_.fetch_add(1, memory_order_relaxed));
+                    size_t old_item_count = mid_head->item_count();
+                    Pointer<SEAL_BYTE> result(mid_head);
+                    bool grown = (mid_head->item_count() != old_item_count);
+                    writer_lock.unlock();
+                    if (grown)
+                    {
+                        enforce_capacity();
+                    }
+                    return result;
                 }
             }
 
@@ -404,7 +581,8 @@ namespace seal
                 throw runtime_error("maximum pool head count reached");
             }
 
-            MemoryPoolHead *new_head = new MemoryPoolHeadMT(byte_count, clear_on_destruction_);
+            MemoryPoolHead *new_head = new MemoryPoolHeadMT(
+                byte_count, clear_on_destruction_, huge_pages_);
             if (!pools_.empty())
             {
                 pools_.insert(pools_.begin() + static_cast<ptrdiff_t>(start), new_head);
@@ -414,7 +592,11 @@ namespace seal
                 pools_.emplace_back(new_head);
             }
 
-            return Pointer<SEAL_BYTE>(new_head);
+            new_head->touch(use_clock_.fetch_add(1, memory_order_relaxed));
+            Pointer<SEAL_BYTE> result(new_head);
+            writer_lock.unlock();
+            enforce_capacity();
+            return result;
         }
 
         size_t MemoryPoolMT::alloc_byte_count() const
@@ -428,6 +610,33 @@ namespace seal
                 });
         }
 
+        vector<MemoryPoolStats> MemoryPoolMT::stats() const
+        {
+            ReaderLock lock(pools_locker_.acquire_read());
+
+            vector<MemoryPoolStats> result;
+            result.reserve(pools_.size());
+            for (MemoryPoolHead *head : pools_)
+            {
+                result.push_back(head->stats());
+            }
+            return result;
+        }
+
+        size_t MemoryPoolMT::trim(size_t target_byte_count)
+        {
+            WriterLock lock(pools_locker_.acquire_write());
+            return release_idle_heads(pools_, target_byte_count);
+        }
+
+        void MemoryPoolMT::enforce_capacity()
+        {
+            if (capacity_byte_count_ && alloc_byte_count() > capacity_byte_count_)
+            {
+                trim(capacity_byte_count_);
+            }
+        }
+
         MemoryPoolST::~MemoryPoolST() noexcept
         {
             for (MemoryPoolHead *head : pools_)
@@ -466,7 +675,14 @@ namespace seal
                 }
                 else
                 {
-                    return Pointer<SEAL_BYTE>(mid_head);
+                    mid_head->touch(use_clock_++);
+                    size_t old_item_count = mid_head->item_count();
+                    Pointer<SEAL_BYTE> result(mid_head);
+                    if (mid_head->item_count() != old_item_count)
+                    {
+                        enforce_capacity();
+                    }
+                    return result;
                 }
             }
 
@@ -477,7 +693,8 @@ namespace seal
                 throw runtime_error("maximum pool head count reached");
             }
 
-            MemoryPoolHead *new_head = new MemoryPoolHeadST(byte_count, clear_on_destruction_);
+            MemoryPoolHead *new_head = new MemoryPoolHeadST(
+                byte_count, clear_on_destruction_, huge_pages_);
             if (!pools_.empty())
             {
                 pools_.insert(pools_.begin() + static_cast<ptrdiff_t>(start), new_head);
@@ -487,7 +704,10 @@ namespace seal
                 pools_.emplace_back(new_head);
             }
 
-            return Pointer<SEAL_BYTE>(new_head);
+            new_head->touch(use_clock_++);
+            Pointer<SEAL_BYTE> result(new_head);
+            enforce_capacity();
+            return result;
         }
 
         size_t MemoryPoolST::alloc_byte_count() const
@@ -498,5 +718,29 @@ namespace seal
                         mul_safe(head->item_count(), head->item_byte_count()));
                 });
         }
+
+        vector<MemoryPoolStats> MemoryPoolST::stats() const
+        {
+            vector<MemoryPoolStats> result;
+            result.reserve(pools_.size());
+            for (MemoryPoolHead *head : pools_)
+            {
+                result.push_back(head->stats());
+            }
+            return result;
+        }
+
+        size_t MemoryPoolST::trim(size_t target_byte_count)
+        {
+            return release_idle_heads(pools_, target_byte_count);
+        }
+
+        void MemoryPoolST::enforce_capacity()
+        {
+            if (capacity_byte_count_ && alloc_byte_count() > capacity_byte_count_)
+            {
+                trim(capacity_byte_count_);
+            }
+        }
     }
 }
@@ -70,6 +70,25 @@ namespace seal
             MemoryPoolItem *next_ = nullptr;
         };
 
+        // Usage statistics for a single allocation size class of a memory pool
+        struct MemoryPoolStats
+        {
+            // Byte size of the items in this size class
+            std::size_t item_byte_count = 0;
+
+            // Total number of items allocated
+            std::size_t item_count = 0;
+
+            // Number of items currently handed out and not yet returned
+            std::size_t in_use_item_count = 0;
+
+            // Largest number of items that have been in use at the same time
+            std::size_t peak_in_use_item_count = 0;
+
+            // Number of times a new allocation for this size class failed
+            std::size_t alloc_failure_count = 0;
+        };
+
         class MemoryPoolHead
         {
         public:
@@ -102,18 +121,46 @@ namespace seal
             // Total number of items allocated 
             virtual std::size_t item_count() const noexcept = 0;
 
+            // Usage statistics for this pool
+            virtual MemoryPoolStats stats() const noexcept = 0;
+
             virtual MemoryPoolItem *get() = 0;
 
             // Return item back to this pool
             virtual void add(MemoryPoolItem *new_first) noexcept = 0;
+
+            // Records the time stamp of the most recent request to this pool
+            inline void touch(std::uint64_t stamp) noexcept
+            {
+                last_use_.store(stamp, std::memory_order_relaxed);
+            }
+
+            // Time stamp of the most recent request to this pool
+            inline std::uint64_t last_use() const noexcept
+            {
+                return last_use_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<std::uint64_t> last_use_{ 0 };
         };
 
+        /*
+        Thread-safe pool head. Free items are kept on a lock-free (Treiber) stack. 
+        The top of the stack is a single 64-bit word holding a 32-bit item index 
+        and a 32-bit tag that changes on every update, which protects against the
+        ABA problem without double-width compare-and-swap. Item nodes are stored
+        in segments of doubling size so that an index can be resolved without 
+        locking. A spin lock is only taken to allocate more memory.
+        */
         class MemoryPoolHeadMT : public MemoryPoolHead
         {
         public:
             // Creates a new MemoryPoolHeadMT with allocation for one single item.
+            // If huge_pages is set, batches of at least one huge page are allocated
+            // from huge pages bound to the NUMA node of the allocating thread.
             MemoryPoolHeadMT(std::size_t item_byte_count, 
-                bool clear_on_destruction = false);
+                bool clear_on_destruction = false, bool huge_pages = false);
 
             ~MemoryPoolHeadMT() noexcept override;
 
@@ -126,49 +173,146 @@ namespace seal
             // Returns the total number of items allocated
             inline std::size_t item_count() const noexcept override
             {
-                return item_count_;
+                return item_count_.load(std::memory_order_relaxed);
             }
 
+            MemoryPoolStats stats() const noexcept override;
+
             MemoryPoolItem *get() override;
 
             inline void add(MemoryPoolItem *new_first) noexcept override
             {
-                bool expected = false;
-                while (!locked_.compare_exchange_strong(
-                    expected, true, std::memory_order_acquire))
-                {
-                    expected = false;
-                }
-                MemoryPoolItem *old_first = first_item_;
-                new_first->next() = old_first;
-                first_item_ = new_first;
-                locked_.store(false, std::memory_order_release);
+                // The item is the first member of its node
+                Node *node = reinterpret_cast<Node*>(new_first);
+                push(node, node);
+
+                // Release ordering: once a zero count is observed (with acquire) 
+                // this thread no longer touches the head, so it may be deleted
+                in_use_item_count_.fetch_sub(1, std::memory_order_release);
             }
 
         private:
+            struct Node
+            {
+                Node(SEAL_BYTE *data, std::uint32_t node_index) noexcept :
+                    item(data), index(node_index), next(0)
+                {
+                }
+
+                MemoryPoolItem item;
+
+                const std::uint32_t index;
+
+                // Index of the next free node plus one; zero marks the end
+                std::atomic<std::uint32_t> next;
+            };
+
+            static_assert(std::is_standard_layout<Node>::value,
+                "Node must be standard layout");
+
+            // Segment k holds 2^k nodes, so 32 segments hold all 32-bit indices
+            static constexpr std::size_t max_segment_count = 32;
+
             MemoryPoolHeadMT(const MemoryPoolHeadMT &copy) = delete;
 
             MemoryPoolHeadMT &operator =(const MemoryPoolHeadMT &assign) = delete;
 
+            static inline std::uint64_t next_top(
+                std::uint64_t old_top, std::uint32_t index_plus_one) noexcept
+            {
+                return (((old_top >> 32) + 1) << 32) | index_plus_one;
+            }
+
+            inline Node *node_at(std::uint32_t index) const noexcept
+            {
+                std::uint64_t position = static_cast<std::uint64_t>(index) + 1;
+                int segment = get_significant_bit_count(position) - 1;
+                return segments_[segment].load(std::memory_order_acquire) + 
+                    (position - (std::uint64_t(1) << segment));
+            }
+
+            // Pushes the chain first, ..., last onto the free stack
+            inline void push(Node *first, Node *last) noexcept
+            {
+                std::uint64_t old_top = free_top_.load(std::memory_order_relaxed);
+                std::uint64_t new_top;
+                do
+                {
+                    last->next.store(static_cast<std::uint32_t>(old_top), 
+                        std::memory_order_relaxed);
+                    new_top = next_top(old_top, first->index + 1);
+                } while (!free_top_.compare_exchange_weak(old_top, new_top, 
+                    std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            // Pops a node from the free stack; returns nullptr if it is empty
+            inline Node *try_pop() noexcept
+            {
+                std::uint64_t old_top = free_top_.load(std::memory_order_acquire);
+                while (static_cast<std::uint32_t>(old_top))
+                {
+                    Node *node = node_at(static_cast<std::uint32_t>(old_top) - 1);
+                    std::uint64_t new_top = next_top(old_top, 
+                        node->next.load(std::memory_order_relaxed));
+                    if (free_top_.compare_exchange_weak(old_top, new_top, 
+                        std::memory_order_acquire, std::memory_order_acquire))
+                    {
+                        return node;
+                    }
+                }
+                return nullptr;
+            }
+
+            // Allocates memory for count more items and returns a node for the 
+            // first one; the rest are pushed onto the free stack. The spin lock 
+            // must be held.
+            Node *grow(std::size_t count);
+
+            inline void record_get() noexcept
+            {
+                std::size_t in_use = in_use_item_count_.fetch_add(
+                    1, std::memory_order_relaxed) + 1;
+
+                // An item is pushed back before the count drops, so the count 
+                // can briefly exceed the number of items; never record that
+                in_use = std::min(in_use, item_count_.load(std::memory_order_relaxed));
+                std::size_t peak = peak_in_use_item_count_.load(
+                    std::memory_order_relaxed);
+                while (in_use > peak && !peak_in_use_item_count_.compare_exchange_weak(
+                    peak, in_use, std::memory_order_relaxed));
+            }
+
             const bool clear_on_destruction_;
 
+            const bool huge_pages_;
+
             mutable std::atomic<bool> locked_;
 
             const std::size_t item_byte_count_;
 
-            volatile std::size_t item_count_;
+            std::atomic<std::size_t> item_count_;
+
+            std::atomic<std::size_t> in_use_item_count_;
+
+            std::atomic<std::size_t> peak_in_use_item_count_;
+
+            std::atomic<std::size_t> alloc_failure_count_;
 
             std::vector<allocation> allocs_;
 
-            MemoryPoolItem* volatile first_item_;
+            std::atomic<Node*> segments_[max_segment_count];
+
+            std::atomic<std::uint64_t> free_top_;
         };
 
         class MemoryPoolHeadST : public MemoryPoolHead
         {
         public:
             // Creates a new MemoryPoolHeadST with allocation for one single item.
-            MemoryPoolHeadST(std::size_t item_byte_count,
-                bool clear_on_destruction = false);
+            // If huge_pages is set, batches of at least one huge page are allocated
+            // from huge pages bound to the NUMA node of the allocating thread.
+            MemoryPoolHeadST(std::size_t item_byte_count, 
+                bool clear_on_destruction = false, bool huge_pages = false);
 
             ~MemoryPoolHeadST() noexcept override;
 
@@ -184,12 +328,15 @@ namespace seal
                 return item_count_;
             }
 
+            MemoryPoolStats stats() const noexcept override;
+
             MemoryPoolItem *get() override;
 
             inline void add(MemoryPoolItem *new_first) noexcept override
             {
                 new_first->next() = first_item_;
                 first_item_ = new_first;
+                in_use_item_count_--;
             }
 
         private:
@@ -197,12 +344,29 @@ namespace seal
 
             MemoryPoolHeadST &operator =(const MemoryPoolHeadST &assign) = delete;
 
+            inline void record_get() noexcept
+            {
+                in_use_item_count_++;
+                if (in_use_item_count_ > peak_in_use_item_count_)
+                {
+                    peak_in_use_item_count_ = in_use_item_count_;
+                }
+            }
+
             const bool clear_on_destruction_;
 
+            const bool huge_pages_;
+
             std::size_t item_byte_count_;
 
             std::size_t item_count_;
 
+            std::size_t in_use_item_count_;
+
+            std::size_t peak_in_use_item_count_;
+
+            std::size_t alloc_failure_count_;
+
             std::vector<allocation> allocs_;
 
             MemoryPoolItem *first_item_;
@@ -232,13 +396,30 @@ namespace seal
             virtual std::size_t pool_count() const = 0;
 
             virtual std::size_t alloc_byte_count() const = 0;
+
+            // Usage statistics for each allocation size, ordered by decreasing size
+            virtual std::vector<MemoryPoolStats> stats() const = 0;
+
+            // Soft upper bound on alloc_byte_count(); zero means unbounded
+            virtual std::size_t capacity_byte_count() const noexcept = 0;
+
+            // Whether large batches are allocated from NUMA-local huge pages
+            virtual bool huge_pages() const noexcept = 0;
+
+            // Releases the memory of idle allocation sizes (no items in use), least 
+            // recently used first, until alloc_byte_count() is at most target_byte_count 
+            // or no idle allocation sizes remain. Returns the number of bytes released.
+            virtual std::size_t trim(std::size_t target_byte_count) = 0;
         };
 
         class MemoryPoolMT : public MemoryPool
         {
         public:
-            MemoryPoolMT(bool clear_on_destruction = false) :
-                clear_on_destruction_(clear_on_destruction)
+            MemoryPoolMT(bool clear_on_destruction = false,
+                std::size_t capacity_byte_count = 0, bool huge_pages = false) :
+                clear_on_destruction_(clear_on_destruction),
+                capacity_byte_count_(capacity_byte_count),
+                huge_pages_(huge_pages)
             {
             };
 
@@ -254,13 +435,36 @@ namespace seal
 
             std::size_t alloc_byte_count() const override;
 
+            std::vector<MemoryPoolStats> stats() const override;
+
+            inline std::size_t capacity_byte_count() const noexcept override
+            {
+                return capacity_byte_count_;
+            }
+
+            inline bool huge_pages() const noexcept override
+            {
+                return huge_pages_;
+            }
+
+            std::size_t trim(std::size_t target_byte_count) override;
+
         protected:
             MemoryPoolMT(const MemoryPoolMT &copy) = delete;
 
             MemoryPoolMT &operator =(const MemoryPoolMT &assign) = delete;
 
+            // Trims the pool down to its capacity if it has one
+            void enforce_capacity();
+
             const bool clear_on_destruction_;
 
+            const std::size_t capacity_byte_count_;
+
+            const bool huge_pages_;
+
+            std::atomic<std::uint64_t> use_clock_{ 0 };
+
             mutable ReaderWriterLocker pools_locker_;
 
             std::vector<MemoryPoolHead*> pools_;
@@ -269,8 +473,11 @@ namespace seal
         class MemoryPoolST : public MemoryPool
         {
         public:
-            MemoryPoolST(bool clear_on_destruction = false) :
-                clear_on_destruction_(clear_on_destruction)
+            MemoryPoolST(bool clear_on_destruction = false,
+                std::size_t capacity_byte_count = 0, bool huge_pages = false) :
+                clear_on_destruction_(clear_on_destruction),
+                capacity_byte_count_(capacity_byte_count),
+                huge_pages_(huge_pages)
             {
             };
 
@@ -284,14 +491,37 @@ namespace seal
             }
 
             std::size_t alloc_byte_count() const override;
+
+            std::vector<MemoryPoolStats> stats() const override;
+
+            inline std::size_t capacity_byte_count() const noexcept override
+            {
+                return capacity_byte_count_;
+            }
+
+            inline bool huge_pages() const noexcept override
+            {
+                return huge_pages_;
+            }
+
+            std::size_t trim(std::size_t target_byte_count) override;
             
         protected:
             MemoryPoolST(const MemoryPoolST &copy) = delete;
 
             MemoryPoolST &operator =(const MemoryPoolST &assign) = delete;
 
+            // Trims the pool down to its capacity if it has one
+            void enforce_capacity();
+
             const bool clear_on_destruction_;
 
+            const std::size_t capacity_byte_count_;
+
+            const bool huge_pages_;
+
+            std::uint64_t use_clock_ = 0;
+
             std::vector<MemoryPoolHead*> pools_;
         };
     }
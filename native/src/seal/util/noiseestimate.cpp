@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <algorithm>
+#include <cmath>
+#include "seal/util/noiseestimate.h"
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            inline double log2_coeff_modulus(const EncryptionParameters &parms)
+            {
+                double result = 0;
+                for (auto &mod : parms.coeff_modulus())
+                {
+                    result += log2(static_cast<double>(mod.value()));
+                }
+                return result;
+            }
+
+            inline double log2_plain_modulus(const EncryptionParameters &parms)
+            {
+                return log2(static_cast<double>(parms.plain_modulus().value()));
+            }
+
+            // Budget of an invariant noise of 2^log2_noise
+            inline double budget_from_log2_noise(double log2_noise)
+            {
+                return max(-log2_noise - 1, 0.0);
+            }
+        }
+
+        double add_noise_budgets(double budget1, double budget2)
+        {
+            // -log2(2 * (v1 + v2)) computed relative to the larger noise
+            double low = min(budget1, budget2);
+            double high = max(budget1, budget2);
+            return max(low - log2(1 + exp2(low - high)), 0.0);
+        }
+
+        double fresh_noise_budget(const EncryptionParameters &parms)
+        {
+            // c(s) = Delta * m + e * u + e_1 + e_2 * s with ternary u and s; the
+            // sum has about 4n/3 + 1 Gaussian terms. The remainder of q modulo t
+            // adds at most t.
+            double coeff_count = static_cast<double>(parms.poly_modulus_degree());
+            double noise = parms.noise_max_deviation() * sqrt(4 * coeff_count / 3 + 1) +
+                static_cast<double>(parms.plain_modulus().value());
+            return budget_from_log2_noise(log2_plain_modulus(parms) + log2(noise) -
+                log2_coeff_modulus(parms));
+        }
+
+        double add_plain_noise_budget(const EncryptionParameters &parms,
+            double budget)
+        {
+            // Scaling by Delta instead of q / t is off by at most t / 2
+            double plain_budget = budget_from_log2_noise(
+                2 * log2_plain_modulus(parms) - 1 - log2_coeff_modulus(parms));
+            return add_noise_budgets(budget, plain_budget);
+        }
+
+        double multiply_plain_noise_budget(const EncryptionParameters &parms,
+            double budget, size_t plain_nonzero_count, uint64_t plain_max_abs_value)
+        {
+            // Worst case expansion: every noise coefficient meets every non-zero
+            // plaintext coefficient
+            double plain_budget = budget_from_log2_noise(
+                2 * log2_plain_modulus(parms) - 1 - log2_coeff_modulus(parms));
+            if (plain_nonzero_count == 0 || plain_max_abs_value == 0)
+            {
+                return plain_budget;
+            }
+            double expansion = log2(static_cast<double>(plain_nonzero_count)) +
+                log2(static_cast<double>(plain_max_abs_value));
+            return max(budget - expansion, 0.0);
+        }
+
+        double multiply_noise_budget(const EncryptionParameters &parms,
+            double budget1, size_t size1, double budget2, size_t size2)
+        {
+            // v ~ t * sqrt(3n) * [(12n)^(j1/2) * v2 + (12n)^(j2/2) * v1
+            //     + (12n)^((j1+j2)/2) / q], where j1 = size1 - 1, j2 = size2 - 1
+            double coeff_count = static_cast<double>(parms.poly_modulus_degree());
+            double log2_base = log2_plain_modulus(parms) + log2(3 * coeff_count) / 2;
+            double log2_expansion = log2(12 * coeff_count) / 2;
+            double j1 = static_cast<double>(size1 - 1);
+            double j2 = static_cast<double>(size2 - 1);
+            double term1_budget = budget_from_log2_noise(
+                log2_base + j1 * log2_expansion - budget2 - 1);
+            double term2_budget = budget_from_log2_noise(
+                log2_base + j2 * log2_expansion - budget1 - 1);
+            double rounding_budget = budget_from_log2_noise(
+                log2_base + (j1 + j2) * log2_expansion - log2_coeff_modulus(parms));
+            return add_noise_budgets(add_noise_budgets(term1_budget, term2_budget),
+                rounding_budget);
+        }
+
+        double key_switch_noise_budget(const EncryptionParameters &parms,
+            double budget, int decomposition_bit_count, size_t decomposition_count)
+        {
+            // Sum of n * decomposition_count products of digits below 2^w with
+            // the Gaussian errors of the keys
+            double coeff_count = static_cast<double>(parms.poly_modulus_degree());
+            double log2_noise = static_cast<double>(decomposition_bit_count) +
+                log2(parms.noise_max_deviation()) +
+                log2(coeff_count * static_cast<double>(decomposition_count)) / 2;
+            double switch_budget = budget_from_log2_noise(log2_plain_modulus(parms) +
+                log2_noise - log2_coeff_modulus(parms));
+            return add_noise_budgets(budget, switch_budget);
+        }
+
+        double mod_switch_noise_budget(const EncryptionParameters &next_parms,
+            double budget)
+        {
+            // Rounding adds at most (1 + n) / 2 with a ternary secret key
+            double coeff_count = static_cast<double>(next_parms.poly_modulus_degree());
+            double rounding_budget = budget_from_log2_noise(
+                log2_plain_modulus(next_parms) + log2(1 + coeff_count) - 1 -
+                log2_coeff_modulus(next_parms));
+            return add_noise_budgets(budget, rounding_budget);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "seal/encryptionparams.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /*
+        Heuristic estimates of the invariant noise budget of BFV ciphertexts,
+        used to track the budget without the secret key. A budget b in bits
+        corresponds to invariant noise v = 2^(-b-1), so noises add by combining
+        budgets with add_noise_budgets. Every estimate is meant to stay a few
+        bits below what Decryptor::invariant_noise_budget reports, and is clamped
+        at zero, which stands for no budget that can be relied on.
+        */
+
+        // Budget of the sum of two ciphertexts with the given budgets
+        double add_noise_budgets(double budget1, double budget2);
+
+        // Budget of a fresh encryption with parms
+        double fresh_noise_budget(const EncryptionParameters &parms);
+
+        // Budget after adding or subtracting a plaintext
+        double add_plain_noise_budget(const EncryptionParameters &parms,
+            double budget);
+
+        // Budget after multiplying by a plaintext with plain_nonzero_count
+        // non-zero coefficients, each of absolute value (centered modulo the
+        // plain modulus) at most plain_max_abs_value
+        double multiply_plain_noise_budget(const EncryptionParameters &parms,
+            double budget, std::size_t plain_nonzero_count,
+            std::uint64_t plain_max_abs_value);
+
+        // Budget of the product of two ciphertexts of sizes size1 and size2
+        double multiply_noise_budget(const EncryptionParameters &parms,
+            double budget1, std::size_t size1, double budget2, std::size_t size2);
+
+        // Budget after key switching with decomposition_count digits of
+        // decomposition_bit_count bits each, as in relinearization and rotations
+        double key_switch_noise_budget(const EncryptionParameters &parms,
+            double budget, int decomposition_bit_count,
+            std::size_t decomposition_count);
+
+        // Budget after modulus switching to the parameters next_parms
+        double mod_switch_noise_budget(const EncryptionParameters &next_parms,
+            double budget);
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Returns the number of threads to use when thread_count is zero, i.e.,
+        the number of hardware threads, or one if that cannot be determined.
+        */
+        inline std::size_t default_thread_count() noexcept
+        {
+            std::size_t count = static_cast<std::size_t>(
+                std::thread::hardware_concurrency());
+            return count ? count : 1;
+        }
+
+        /**
+        Calls f(i) for every i in [0, count) using up to thread_count threads,
+        the calling thread included. Indices are handed out dynamically so that
+        tasks of uneven cost are balanced. The order in which the calls happen
+        is unspecified, so f must only write to state owned by index i. If any
+        call throws, the remaining indices are skipped and the first exception
+        is rethrown in the calling thread.
+
+        @param[in] count The number of indices
+        @param[in] thread_count The maximum number of threads; zero means
+        default_thread_count()
+        @param[in] f The function to call
+        */
+        template<typename F>
+        void parallel_for(std::size_t count, std::size_t thread_count, F &&f)
+        {
+            if (!thread_count)
+            {
+                thread_count = default_thread_count();
+            }
+            thread_count = std::min(thread_count, count);
+            if (thread_count <= 1)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    f(i);
+                }
+                return;
+            }
+
+            std::atomic<std::size_t> next{ 0 };
+            std::atomic<bool> failed{ false };
+            std::exception_ptr error;
+            std::mutex error_mutex;
+
+            auto worker = [&]() {
+                std::size_t i;
+                while (!failed.load(std::memory_order_relaxed) &&
+                    (i = next.fetch_add(1, std::memory_order_relaxed)) < count)
+                {
+                    try
+                    {
+                        f(i);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        if (!error)
+                        {
+                            error = std::current_exception();
+                        }
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(thread_count - 1);
+            try
+            {
+                for (std::size_t t = 1; t < thread_count; t++)
+                {
+                    threads.emplace_back(worker);
+                }
+            }
+            catch (...)
+            {
+                // Could not start all threads; run with the ones we have
+            }
+            worker();
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+}
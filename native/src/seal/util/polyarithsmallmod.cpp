@@ -34,41 +34,10 @@ namespace seal
                 throw invalid_argument("modulus");
             }
 #endif
-            // Explicit inline
-            //for (int i = 0; i < coeff_count; i++)
-            //{
-            //    *result++ = multiply_uint_uint_mod(*poly++, scalar, modulus);
-            //}
-            const uint64_t modulus_value = modulus.value();
-            const uint64_t const_ratio_0 = modulus.const_ratio()[0];
-            const uint64_t const_ratio_1 = modulus.const_ratio()[1];
-            for (; coeff_count--; poly++, result++)
-            {
-                unsigned long long z[2], tmp1, tmp2[2], tmp3, carry;
-                multiply_uint64(*poly, scalar, z);
-            
-                // Reduces z using base 2^64 Barrett reduction
-                
-                // Multiply input and const_ratio
-                // Round 1
-                multiply_uint64_hw64(z[0], const_ratio_0, &carry);
-                multiply_uint64(z[0], const_ratio_1, tmp2);
-                tmp3 = tmp2[1] + add_uint64(tmp2[0], carry, &tmp1);
-
-                // Round 2
-                multiply_uint64(z[1], const_ratio_0, tmp2);
-                carry = tmp2[1] + add_uint64(tmp1, tmp2[0], &tmp1);
-
-                // This is all we care about
-                tmp1 = z[1] * const_ratio_1 + tmp3 + carry;
-
-                // Barrett subtraction
-                tmp3 = z[0] - tmp1 * modulus_value;
-
-                // Claim: One more subtraction is enough
-                *result = tmp3 - (modulus_value & static_cast<uint64_t>(
-                    -static_cast<int64_t>(tmp3 >= modulus_value)));
-            }
+            // Shoup multiplication needs a reduced scalar
+            MultiplyUIntModOperand scalar_operand(scalar % modulus.value(), modulus);
+            multiply_poly_scalar_coeffmod(poly, coeff_count, scalar_operand,
+                modulus, result);
         }
 
         void multiply_poly_poly_coeffmod(const uint64_t *operand1, 
@@ -394,6 +363,67 @@ namespace seal
             }
         }
 
+        void galois_permutation(int coeff_count_power, uint64_t galois_elt,
+            uint32_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (result == nullptr)
+            {
+                throw invalid_argument("result");
+            }
+            if (coeff_count_power <= 0 || coeff_count_power > 31)
+            {
+                throw invalid_argument("coeff_count_power");
+            }
+            // Verify coprime conditions.
+            if (!(galois_elt & 1) || 
+                (galois_elt >= 2 * (uint64_t(1) << coeff_count_power)))
+            {
+                throw invalid_argument("galois element is not valid");
+            }
+#endif
+            // Invert the map i -> i * galois_elt mod (X^n + 1) used by apply_galois
+            uint64_t coeff_count_minus_one = (uint64_t(1) << coeff_count_power) - 1;
+            for (uint64_t i = 0; i <= coeff_count_minus_one; i++)
+            {
+                uint64_t index_raw = i * galois_elt;
+                uint64_t index = index_raw & coeff_count_minus_one;
+                uint32_t negate = static_cast<uint32_t>((index_raw >> coeff_count_power) & 1);
+                result[index] = static_cast<uint32_t>(i) | (negate << 31);
+            }
+        }
+
+        void galois_ntt_permutation(int coeff_count_power, uint64_t galois_elt,
+            uint32_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (result == nullptr)
+            {
+                throw invalid_argument("result");
+            }
+            if (coeff_count_power <= 0 || coeff_count_power > 31)
+            {
+                throw invalid_argument("coeff_count_power");
+            }
+            // Verify coprime conditions.
+            if (!(galois_elt & 1) || 
+                (galois_elt >= 2 * (uint64_t(1) << coeff_count_power)))
+            {
+                throw invalid_argument("galois element is not valid");
+            }
+#endif
+            size_t coeff_count = size_t(1) << coeff_count_power;
+            uint64_t m_minus_one = 2 * coeff_count - 1;
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                uint64_t reversed = reverse_bits(i, coeff_count_power);
+                uint64_t index_raw = galois_elt * (2 * reversed + 1);
+                index_raw &= m_minus_one;
+                result[i] = static_cast<uint32_t>(
+                    reverse_bits((index_raw - 1) >> 1, coeff_count_power));
+            }
+        }
+
         void dyadic_product_coeffmod(const uint64_t *operand1, 
             const uint64_t *operand2, size_t coeff_count, 
             const SmallModulus &modulus, uint64_t *result)
@@ -456,6 +486,75 @@ namespace seal
             }
         }
 
+        void dyadic_product_accumulate(const uint64_t *operand1,
+            const uint64_t *operand2, size_t coeff_count, uint64_t *accumulator)
+        {
+#ifdef SEAL_DEBUG
+            if (operand1 == nullptr)
+            {
+                throw invalid_argument("operand1");
+            }
+            if (operand2 == nullptr)
+            {
+                throw invalid_argument("operand2");
+            }
+            if (accumulator == nullptr)
+            {
+                throw invalid_argument("accumulator");
+            }
+#endif
+            for (; coeff_count--; operand1++, operand2++, accumulator += 2)
+            {
+                unsigned long long product[2];
+                multiply_uint64(*operand1, *operand2, product);
+                unsigned char carry = add_uint64(accumulator[0], product[0], accumulator);
+                accumulator[1] += product[1] + carry;
+            }
+        }
+
+        void reduce_accumulator_coeffmod(uint64_t *accumulator,
+            size_t coeff_count, const SmallModulus &modulus)
+        {
+#ifdef SEAL_DEBUG
+            if (accumulator == nullptr)
+            {
+                throw invalid_argument("accumulator");
+            }
+            if (modulus.is_zero())
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            for (; coeff_count--; accumulator += 2)
+            {
+                accumulator[0] = barrett_reduce_128(accumulator, modulus);
+                accumulator[1] = 0;
+            }
+        }
+
+        void modulo_accumulator_coeffs(const uint64_t *accumulator,
+            size_t coeff_count, const SmallModulus &modulus, uint64_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (accumulator == nullptr)
+            {
+                throw invalid_argument("accumulator");
+            }
+            if (result == nullptr)
+            {
+                throw invalid_argument("result");
+            }
+            if (modulus.is_zero())
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            for (; coeff_count--; accumulator += 2, result++)
+            {
+                *result = barrett_reduce_128(accumulator, modulus);
+            }
+        }
+
         uint64_t poly_infty_norm_coeffmod(const uint64_t *operand, 
             size_t coeff_count, const SmallModulus &modulus)
         {
@@ -710,5 +809,49 @@ namespace seal
                 }
             }
         }
+
+        void negacyclic_multiply_poly_mono_add_coeffmod(const uint64_t *operand,
+            size_t coeff_count, const MultiplyUIntModOperand &mono_coeff,
+            size_t mono_exponent, const SmallModulus &modulus, uint64_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (operand == nullptr && coeff_count > 0)
+            {
+                throw invalid_argument("operand");
+            }
+            if (result == nullptr && coeff_count > 0)
+            {
+                throw invalid_argument("result");
+            }
+            if (operand == result && coeff_count > 0)
+            {
+                throw invalid_argument("operand cannot point to the same location as result");
+            }
+            if (modulus.is_zero())
+            {
+                throw invalid_argument("modulus");
+            }
+            if (util::get_power_of_two(static_cast<uint64_t>(coeff_count)) < 0)
+            {
+                throw invalid_argument("coeff_count");
+            }
+            if (mono_exponent >= coeff_count && coeff_count > 0)
+            {
+                throw invalid_argument("mono_exponent");
+            }
+#endif
+            // Coefficients that wrap around x^n = -1 are subtracted
+            size_t wrap_index = coeff_count - mono_exponent;
+            for (size_t i = 0; i < wrap_index; i++)
+            {
+                result[i + mono_exponent] = add_uint_uint_mod(result[i + mono_exponent],
+                    multiply_uint_mod(operand[i], mono_coeff, modulus), modulus);
+            }
+            for (size_t i = wrap_index; i < coeff_count; i++)
+            {
+                result[i - wrap_index] = sub_uint_uint_mod(result[i - wrap_index],
+                    multiply_uint_mod(operand[i], mono_coeff, modulus), modulus);
+            }
+        }
     }
 }
@@ -11,6 +11,7 @@
 #include "seal/util/polycore.h"
 #include "seal/util/uintarithsmallmod.h"
 #include "seal/util/pointer.h"
+#include "seal/util/simd.h"
 
 namespace seal
 {
@@ -58,6 +59,12 @@ namespace seal
             }
 #endif
             const uint64_t modulus_value = modulus.value();
+#if defined(SEAL_USE_AVX) && !defined(SEAL_DEBUG)
+            if (negate_poly_coeffmod_simd(poly, coeff_count, modulus_value, result))
+            {
+                return;
+            }
+#endif
             for (; coeff_count--; poly++, result++)
             {
                 // Explicit inline
@@ -97,6 +104,13 @@ namespace seal
             }
 #endif
             const uint64_t modulus_value = modulus.value();
+#if defined(SEAL_USE_AVX) && !defined(SEAL_DEBUG)
+            if (add_poly_poly_coeffmod_simd(operand1, operand2, coeff_count,
+                modulus_value, result))
+            {
+                return;
+            }
+#endif
             for (; coeff_count--; result++, operand1++, operand2++)
             {
                 // Explicit inline
@@ -140,6 +154,13 @@ namespace seal
             }
 #endif
             const uint64_t modulus_value = modulus.value();
+#if defined(SEAL_USE_AVX) && !defined(SEAL_DEBUG)
+            if (sub_poly_poly_coeffmod_simd(operand1, operand2, coeff_count,
+                modulus_value, result))
+            {
+                return;
+            }
+#endif
             for (; coeff_count--; result++, operand1++, operand2++)
             {
 #ifdef SEAL_DEBUG
@@ -162,6 +183,30 @@ namespace seal
             std::size_t coeff_count, std::uint64_t scalar, const SmallModulus &modulus, 
             std::uint64_t *result);
 
+        inline void multiply_poly_scalar_coeffmod(const std::uint64_t *poly,
+            std::size_t coeff_count, const MultiplyUIntModOperand &scalar,
+            const SmallModulus &modulus, std::uint64_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (poly == nullptr && coeff_count > 0)
+            {
+                throw std::invalid_argument("poly");
+            }
+            if (result == nullptr && coeff_count > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (modulus.is_zero())
+            {
+                throw std::invalid_argument("modulus");
+            }
+#endif
+            for (; coeff_count--; poly++, result++)
+            {
+                *result = multiply_uint_mod(*poly, scalar, modulus);
+            }
+        }
+
         void multiply_poly_poly_coeffmod(const std::uint64_t *operand1, 
             std::size_t operand1_coeff_count, const std::uint64_t *operand2, 
             std::size_t operand2_coeff_count, const SmallModulus &modulus, 
@@ -196,13 +241,123 @@ namespace seal
         void apply_galois(const std::uint64_t *input, int coeff_count_power, 
             std::uint64_t galois_elt, const SmallModulus &modulus, std::uint64_t *result);
 
+        /**
+        Writes the permutation that the Galois automorphism given by galois_elt
+        induces on a polynomial in coefficient form to result, so that applying
+        it is a gather: output[i] = +/- input[result[i] & 0x7FFFFFFF], where the
+        top bit of result[i] is set when the coefficient is negated.
+        */
+        void galois_permutation(int coeff_count_power, std::uint64_t galois_elt,
+            std::uint32_t *result);
+
+        inline void apply_galois(const std::uint64_t *input,
+            std::size_t coeff_count, const std::uint32_t *permutation,
+            const SmallModulus &modulus, std::uint64_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (input == nullptr && coeff_count > 0)
+            {
+                throw std::invalid_argument("input");
+            }
+            if (permutation == nullptr && coeff_count > 0)
+            {
+                throw std::invalid_argument("permutation");
+            }
+            if (result == nullptr && coeff_count > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (input == result)
+            {
+                throw std::invalid_argument("result cannot point to the same value as input");
+            }
+            if (modulus.is_zero())
+            {
+                throw std::invalid_argument("modulus");
+            }
+#endif
+            const std::uint64_t modulus_value = modulus.value();
+            for (std::size_t i = 0; i < coeff_count; i++)
+            {
+                std::uint32_t entry = permutation[i];
+                std::uint64_t value = input[entry & 0x7FFFFFFF];
+                std::uint64_t negated = (modulus_value - value) &
+                    static_cast<std::uint64_t>(-static_cast<std::int64_t>(value != 0));
+                std::uint64_t negate = static_cast<std::uint64_t>(
+                    -static_cast<std::int64_t>(entry >> 31));
+                result[i] = (value & ~negate) | (negated & negate);
+            }
+        }
+
         void apply_galois_ntt(const std::uint64_t *input, int coeff_count_power, 
             std::uint64_t galois_elt, std::uint64_t *result);
 
+        /**
+        Writes the permutation that the Galois automorphism given by galois_elt
+        induces on a polynomial in NTT form to result, so that applying it is a
+        gather: output[i] = input[result[i]].
+        */
+        void galois_ntt_permutation(int coeff_count_power, std::uint64_t galois_elt,
+            std::uint32_t *result);
+
+        inline void apply_galois_ntt(const std::uint64_t *input,
+            std::size_t coeff_count, const std::uint32_t *permutation,
+            std::uint64_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (input == nullptr && coeff_count > 0)
+            {
+                throw std::invalid_argument("input");
+            }
+            if (permutation == nullptr && coeff_count > 0)
+            {
+                throw std::invalid_argument("permutation");
+            }
+            if (result == nullptr && coeff_count > 0)
+            {
+                throw std::invalid_argument("result");
+            }
+            if (input == result)
+            {
+                throw std::invalid_argument("result cannot point to the same value as input");
+            }
+#endif
+            for (std::size_t i = 0; i < coeff_count; i++)
+            {
+                result[i] = input[permutation[i]];
+            }
+        }
+
         void dyadic_product_coeffmod(const std::uint64_t *operand1, 
             const std::uint64_t *operand2, std::size_t coeff_count, 
             const SmallModulus &modulus, std::uint64_t *result);
 
+        /**
+        Adds the dyadic product of operand1 and operand2 to accumulator without
+        any modular reduction. The accumulator holds a 128-bit value (low word
+        first) for each coefficient, so it can absorb 2^(128 - 2 * bit_count)
+        products of operands reduced modulo a bit_count-bit modulus before it
+        must be reduced with reduce_accumulator_coeffmod.
+        */
+        void dyadic_product_accumulate(const std::uint64_t *operand1,
+            const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t *accumulator);
+
+        /**
+        Reduces each 128-bit value in accumulator modulo modulus, leaving the
+        result in the accumulator as a 128-bit value.
+        */
+        void reduce_accumulator_coeffmod(std::uint64_t *accumulator,
+            std::size_t coeff_count, const SmallModulus &modulus);
+
+        /**
+        Reduces each 128-bit value in accumulator modulo modulus and writes the
+        results to a polynomial.
+        */
+        void modulo_accumulator_coeffs(const std::uint64_t *accumulator,
+            std::size_t coeff_count, const SmallModulus &modulus,
+            std::uint64_t *result);
+
         std::uint64_t poly_infty_norm_coeffmod(const std::uint64_t *operand, 
             std::size_t coeff_count, const SmallModulus &modulus);
 
@@ -213,5 +368,15 @@ namespace seal
         void negacyclic_shift_poly_coeffmod(const std::uint64_t *operand, 
             std::size_t coeff_count, std::size_t shift, const SmallModulus &modulus, 
             std::uint64_t *result);
+
+        /**
+        Adds the negacyclic product of operand with the monomial
+        mono_coeff * x^mono_exponent to result, where mono_exponent is less than
+        coeff_count. The operand must not overlap the result.
+        */
+        void negacyclic_multiply_poly_mono_add_coeffmod(const std::uint64_t *operand,
+            std::size_t coeff_count, const MultiplyUIntModOperand &mono_coeff,
+            std::size_t mono_exponent, const SmallModulus &modulus,
+            std::uint64_t *result);
     }
 }
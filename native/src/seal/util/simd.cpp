@@ -0,0 +1,340 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <atomic>
+#include <stdexcept>
+#include "seal/util/simd.h"
+
+#ifdef SEAL_USE_AVX
+#include <immintrin.h>
+
+// The kernels are compiled for their instruction set independently of the
+// flags used for the rest of the library, and are only called when the CPU
+// supports them
+#define SEAL_TARGET_AVX2 __attribute__((target("avx2")))
+#define SEAL_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            simd_level detect_simd_level() noexcept
+            {
+#ifdef SEAL_USE_AVX
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512f"))
+                {
+                    return simd_level::avx512;
+                }
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    return simd_level::avx2;
+                }
+#endif
+                return simd_level::none;
+            }
+
+            atomic<simd_level> &active_simd_level() noexcept
+            {
+                static atomic<simd_level> level{ max_simd_level() };
+                return level;
+            }
+
+            // Scalar versions for the remaining coefficients
+            inline void add_poly_poly_coeffmod_tail(const uint64_t *operand1,
+                const uint64_t *operand2, size_t coeff_count, uint64_t modulus,
+                uint64_t *result)
+            {
+                for (; coeff_count--; operand1++, operand2++, result++)
+                {
+                    uint64_t sum = *operand1 + *operand2;
+                    *result = sum - (modulus & static_cast<uint64_t>(
+                        -static_cast<int64_t>(sum >= modulus)));
+                }
+            }
+
+            inline void sub_poly_poly_coeffmod_tail(const uint64_t *operand1,
+                const uint64_t *operand2, size_t coeff_count, uint64_t modulus,
+                uint64_t *result)
+            {
+                for (; coeff_count--; operand1++, operand2++, result++)
+                {
+                    *result = *operand1 - *operand2 + (modulus & static_cast<uint64_t>(
+                        -static_cast<int64_t>(*operand1 < *operand2)));
+                }
+            }
+
+            inline void negate_poly_coeffmod_tail(const uint64_t *poly,
+                size_t coeff_count, uint64_t modulus, uint64_t *result)
+            {
+                for (; coeff_count--; poly++, result++)
+                {
+                    *result = (modulus - *poly) & static_cast<uint64_t>(
+                        -static_cast<int64_t>(*poly != 0));
+                }
+            }
+
+            inline void gather_uint64_tail(const uint64_t *input,
+                const uint64_t *indices, size_t count, uint64_t *result)
+            {
+                for (; count--; indices++, result++)
+                {
+                    *result = input[*indices];
+                }
+            }
+#ifdef SEAL_USE_AVX
+            // All values are below 2^63, so signed 64-bit comparisons are correct
+            SEAL_TARGET_AVX2 void add_poly_poly_coeffmod_avx2(
+                const uint64_t *operand1, const uint64_t *operand2,
+                size_t coeff_count, uint64_t modulus, uint64_t *result)
+            {
+                const __m256i mod = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                const __m256i mod_minus_one =
+                    _mm256_set1_epi64x(static_cast<long long>(modulus - 1));
+                size_t i = 0;
+                for (; i + 4 <= coeff_count; i += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(operand1 + i));
+                    __m256i y = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(operand2 + i));
+                    __m256i sum = _mm256_add_epi64(x, y);
+                    __m256i overflow = _mm256_cmpgt_epi64(sum, mod_minus_one);
+                    sum = _mm256_sub_epi64(sum, _mm256_and_si256(overflow, mod));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), sum);
+                }
+                add_poly_poly_coeffmod_tail(operand1 + i, operand2 + i,
+                    coeff_count - i, modulus, result + i);
+            }
+
+            SEAL_TARGET_AVX2 void sub_poly_poly_coeffmod_avx2(
+                const uint64_t *operand1, const uint64_t *operand2,
+                size_t coeff_count, uint64_t modulus, uint64_t *result)
+            {
+                const __m256i mod = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                size_t i = 0;
+                for (; i + 4 <= coeff_count; i += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(operand1 + i));
+                    __m256i y = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(operand2 + i));
+                    __m256i borrow = _mm256_cmpgt_epi64(y, x);
+                    __m256i diff = _mm256_add_epi64(_mm256_sub_epi64(x, y),
+                        _mm256_and_si256(borrow, mod));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), diff);
+                }
+                sub_poly_poly_coeffmod_tail(operand1 + i, operand2 + i,
+                    coeff_count - i, modulus, result + i);
+            }
+
+            SEAL_TARGET_AVX2 void negate_poly_coeffmod_avx2(const uint64_t *poly,
+                size_t coeff_count, uint64_t modulus, uint64_t *result)
+            {
+                const __m256i mod = _mm256_set1_epi64x(static_cast<long long>(modulus));
+                const __m256i zero = _mm256_setzero_si256();
+                size_t i = 0;
+                for (; i + 4 <= coeff_count; i += 4)
+                {
+                    __m256i x = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(poly + i));
+                    __m256i is_zero = _mm256_cmpeq_epi64(x, zero);
+                    __m256i neg = _mm256_andnot_si256(is_zero, _mm256_sub_epi64(mod, x));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), neg);
+                }
+                negate_poly_coeffmod_tail(poly + i, coeff_count - i, modulus, result + i);
+            }
+
+            SEAL_TARGET_AVX2 void gather_uint64_avx2(const uint64_t *input,
+                const uint64_t *indices, size_t count, uint64_t *result)
+            {
+                const long long *base = reinterpret_cast<const long long*>(input);
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m256i index = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(indices + i));
+                    __m256i x = _mm256_i64gather_epi64(base, index, 8);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), x);
+                }
+                gather_uint64_tail(input, indices + i, count - i, result + i);
+            }
+
+            // The remaining coefficients are handled with masked loads and stores
+            SEAL_TARGET_AVX512 void add_poly_poly_coeffmod_avx512(
+                const uint64_t *operand1, const uint64_t *operand2,
+                size_t coeff_count, uint64_t modulus, uint64_t *result)
+            {
+                const __m512i mod = _mm512_set1_epi64(static_cast<long long>(modulus));
+                for (size_t i = 0; i < coeff_count; i += 8)
+                {
+                    __mmask8 lanes = (coeff_count - i >= 8) ? __mmask8(0xFF) :
+                        static_cast<__mmask8>((1U << (coeff_count - i)) - 1);
+                    __m512i x = _mm512_maskz_loadu_epi64(lanes, operand1 + i);
+                    __m512i y = _mm512_maskz_loadu_epi64(lanes, operand2 + i);
+                    __m512i sum = _mm512_add_epi64(x, y);
+                    __mmask8 overflow = _mm512_cmpge_epu64_mask(sum, mod);
+                    sum = _mm512_mask_sub_epi64(sum, overflow, sum, mod);
+                    _mm512_mask_storeu_epi64(result + i, lanes, sum);
+                }
+            }
+
+            SEAL_TARGET_AVX512 void sub_poly_poly_coeffmod_avx512(
+                const uint64_t *operand1, const uint64_t *operand2,
+                size_t coeff_count, uint64_t modulus, uint64_t *result)
+            {
+                const __m512i mod = _mm512_set1_epi64(static_cast<long long>(modulus));
+                for (size_t i = 0; i < coeff_count; i += 8)
+                {
+                    __mmask8 lanes = (coeff_count - i >= 8) ? __mmask8(0xFF) :
+                        static_cast<__mmask8>((1U << (coeff_count - i)) - 1);
+                    __m512i x = _mm512_maskz_loadu_epi64(lanes, operand1 + i);
+                    __m512i y = _mm512_maskz_loadu_epi64(lanes, operand2 + i);
+                    __mmask8 borrow = _mm512_cmplt_epu64_mask(x, y);
+                    __m512i diff = _mm512_sub_epi64(x, y);
+                    diff = _mm512_mask_add_epi64(diff, borrow, diff, mod);
+                    _mm512_mask_storeu_epi64(result + i, lanes, diff);
+                }
+            }
+
+            SEAL_TARGET_AVX512 void negate_poly_coeffmod_avx512(const uint64_t *poly,
+                size_t coeff_count, uint64_t modulus, uint64_t *result)
+            {
+                const __m512i mod = _mm512_set1_epi64(static_cast<long long>(modulus));
+                const __m512i zero = _mm512_setzero_si512();
+                for (size_t i = 0; i < coeff_count; i += 8)
+                {
+                    __mmask8 lanes = (coeff_count - i >= 8) ? __mmask8(0xFF) :
+                        static_cast<__mmask8>((1U << (coeff_count - i)) - 1);
+                    __m512i x = _mm512_maskz_loadu_epi64(lanes, poly + i);
+                    __mmask8 non_zero = _mm512_cmpneq_epu64_mask(x, zero);
+                    __m512i neg = _mm512_maskz_sub_epi64(non_zero, mod, x);
+                    _mm512_mask_storeu_epi64(result + i, lanes, neg);
+                }
+            }
+
+            SEAL_TARGET_AVX512 void gather_uint64_avx512(const uint64_t *input,
+                const uint64_t *indices, size_t count, uint64_t *result)
+            {
+                const __m512i zero = _mm512_setzero_si512();
+                for (size_t i = 0; i < count; i += 8)
+                {
+                    __mmask8 lanes = (count - i >= 8) ? __mmask8(0xFF) :
+                        static_cast<__mmask8>((1U << (count - i)) - 1);
+                    __m512i index = _mm512_maskz_loadu_epi64(lanes, indices + i);
+                    __m512i x = _mm512_mask_i64gather_epi64(zero, lanes, index,
+                        input, 8);
+                    _mm512_mask_storeu_epi64(result + i, lanes, x);
+                }
+            }
+#endif
+        }
+
+        simd_level max_simd_level() noexcept
+        {
+            static const simd_level level = detect_simd_level();
+            return level;
+        }
+
+        simd_level get_simd_level() noexcept
+        {
+            return active_simd_level().load(memory_order_relaxed);
+        }
+
+        void set_simd_level(simd_level level)
+        {
+            if (static_cast<uint8_t>(level) > static_cast<uint8_t>(max_simd_level()))
+            {
+                throw invalid_argument("simd_level is not supported");
+            }
+            active_simd_level().store(level, memory_order_relaxed);
+        }
+
+        bool add_poly_poly_coeffmod_simd(const uint64_t *operand1,
+            const uint64_t *operand2, size_t coeff_count, uint64_t modulus,
+            uint64_t *result)
+        {
+            switch (get_simd_level())
+            {
+#ifdef SEAL_USE_AVX
+            case simd_level::avx512:
+                add_poly_poly_coeffmod_avx512(operand1, operand2, coeff_count,
+                    modulus, result);
+                return true;
+
+            case simd_level::avx2:
+                add_poly_poly_coeffmod_avx2(operand1, operand2, coeff_count,
+                    modulus, result);
+                return true;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        bool sub_poly_poly_coeffmod_simd(const uint64_t *operand1,
+            const uint64_t *operand2, size_t coeff_count, uint64_t modulus,
+            uint64_t *result)
+        {
+            switch (get_simd_level())
+            {
+#ifdef SEAL_USE_AVX
+            case simd_level::avx512:
+                sub_poly_poly_coeffmod_avx512(operand1, operand2, coeff_count,
+                    modulus, result);
+                return true;
+
+            case simd_level::avx2:
+                sub_poly_poly_coeffmod_avx2(operand1, operand2, coeff_count,
+                    modulus, result);
+                return true;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        bool negate_poly_coeffmod_simd(const uint64_t *poly, size_t coeff_count,
+            uint64_t modulus, uint64_t *result)
+        {
+            switch (get_simd_level())
+            {
+#ifdef SEAL_USE_AVX
+            case simd_level::avx512:
+                negate_poly_coeffmod_avx512(poly, coeff_count, modulus, result);
+                return true;
+
+            case simd_level::avx2:
+                negate_poly_coeffmod_avx2(poly, coeff_count, modulus, result);
+                return true;
+#endif
+            default:
+                return false;
+            }
+        }
+
+        bool gather_uint64_simd(const uint64_t *input, const uint64_t *indices,
+            size_t count, uint64_t *result)
+        {
+            switch (get_simd_level())
+            {
+#ifdef SEAL_USE_AVX
+            case simd_level::avx512:
+                gather_uint64_avx512(input, indices, count, result);
+                return true;
+
+            case simd_level::avx2:
+                gather_uint64_avx2(input, indices, count, result);
+                return true;
+#endif
+            default:
+                return false;
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "seal/util/defines.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Instruction set extensions that the vectorized polynomial kernels in
+        polyarithsmallmod.h can use.
+        */
+        enum class simd_level : std::uint8_t
+        {
+            none = 0,
+            avx2 = 1,
+            avx512 = 2
+        };
+
+        /**
+        Returns the highest simd_level supported by both the build and the CPU.
+        */
+        simd_level max_simd_level() noexcept;
+
+        /**
+        Returns the simd_level currently used by the kernels. This is initially
+        max_simd_level().
+        */
+        simd_level get_simd_level() noexcept;
+
+        /**
+        Sets the simd_level used by the kernels, e.g., to compare implementations.
+        This is not thread-safe with respect to concurrently running kernels.
+
+        @param[in] level The simd_level to use
+        @throws std::invalid_argument if level exceeds max_simd_level()
+        */
+        void set_simd_level(simd_level level);
+
+        /*
+        Vectorized kernels for whole polynomials modulo a modulus of at most 62
+        bits. Operands must be reduced modulo the modulus. These do nothing and
+        return false when get_simd_level() is simd_level::none, in which case the
+        caller must fall back to the scalar implementation.
+        */
+        bool add_poly_poly_coeffmod_simd(const std::uint64_t *operand1,
+            const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, std::uint64_t *result);
+
+        bool sub_poly_poly_coeffmod_simd(const std::uint64_t *operand1,
+            const std::uint64_t *operand2, std::size_t coeff_count,
+            std::uint64_t modulus, std::uint64_t *result);
+
+        bool negate_poly_coeffmod_simd(const std::uint64_t *poly,
+            std::size_t coeff_count, std::uint64_t modulus, std::uint64_t *result);
+
+        /*
+        Vectorized gather setting result[i] = input[indices[i]] for i less than
+        count, as used to permute slots in BatchEncoder. The result must not
+        overlap the input. Like the kernels above, this returns false when
+        get_simd_level() is simd_level::none.
+        */
+        bool gather_uint64_simd(const std::uint64_t *input,
+            const std::uint64_t *indices, std::size_t count, std::uint64_t *result);
+    }
+}
@@ -33,12 +33,13 @@ namespace seal
             generated_ = false;
             modulus_ = SmallModulus();
             root_ = 0;
-            root_powers_.release();
-            scaled_root_powers_.release();
-            inv_root_powers_.release();
-            scaled_inv_root_powers_.release();
-            inv_root_powers_div_two_.release();
-            scaled_inv_root_powers_div_two_.release();
+            data_.reset();
+            root_powers_ = nullptr;
+            scaled_root_powers_ = nullptr;
+            inv_root_powers_ = nullptr;
+            scaled_inv_root_powers_ = nullptr;
+            inv_root_powers_div_two_ = nullptr;
+            scaled_inv_root_powers_div_two_ = nullptr;
             inv_degree_modulo_ = 0;
             coeff_count_power_ = 0;
             coeff_count_ = 0;
@@ -59,12 +60,9 @@ namespace seal
             coeff_count_ = size_t(1) << coeff_count_power_;
 
             // Allocate memory for the tables
-            root_powers_ = allocate_uint(coeff_count_, pool_);
-            inv_root_powers_ = allocate_uint(coeff_count_, pool_);
-            scaled_root_powers_ = allocate_uint(coeff_count_, pool_);
-            scaled_inv_root_powers_ = allocate_uint(coeff_count_, pool_);
-            inv_root_powers_div_two_ = allocate_uint(coeff_count_, pool_);
-            scaled_inv_root_powers_div_two_ = allocate_uint(coeff_count_, pool_);
+            data_ = std::make_shared<Pointer<uint64_t>>(
+                allocate_uint(6 * coeff_count_, pool_));
+            set_table_pointers();
             modulus_ = modulus;
 
             // We defer parameter checking to try_minimal_primitive_root(...)
@@ -83,15 +81,15 @@ namespace seal
 
             // Populate the tables storing (scaled version of) powers of root 
             // mod q in bit-scrambled order.  
-            ntt_powers_of_primitive_root(root_, root_powers_.get());
-            ntt_scale_powers_of_primitive_root(root_powers_.get(), 
-                scaled_root_powers_.get());
+            ntt_powers_of_primitive_root(root_, root_powers_);
+            ntt_scale_powers_of_primitive_root(root_powers_, 
+                scaled_root_powers_);
 
             // Populate the tables storing (scaled version of) powers of 
             // (root)^{-1} mod q in bit-scrambled order.  
-            ntt_powers_of_primitive_root(inverse_root, inv_root_powers_.get());
-            ntt_scale_powers_of_primitive_root(inv_root_powers_.get(), 
-                scaled_inv_root_powers_.get());
+            ntt_powers_of_primitive_root(inverse_root, inv_root_powers_);
+            ntt_scale_powers_of_primitive_root(inv_root_powers_, 
+                scaled_inv_root_powers_);
 
             // Populate the tables storing (scaled version of ) 2 times 
             // powers of roots^-1 mod q  in bit-scrambled order. 
@@ -100,8 +98,8 @@ namespace seal
                 inv_root_powers_div_two_[i] = 
                     div2_uint_mod(inv_root_powers_[i], modulus_);
             }
-            ntt_scale_powers_of_primitive_root(inv_root_powers_div_two_.get(), 
-                scaled_inv_root_powers_div_two_.get());
+            ntt_scale_powers_of_primitive_root(inv_root_powers_div_two_, 
+                scaled_inv_root_powers_div_two_);
 
             // Last compute n^(-1) modulo q. 
             uint64_t degree_uint = static_cast<uint64_t>(coeff_count_);
@@ -115,6 +113,97 @@ namespace seal
             return true;
         }
 
+        void SmallNTTTables::save(ostream &stream) const
+        {
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                uint64_t generated64 = static_cast<uint64_t>(generated_);
+                stream.write(reinterpret_cast<const char*>(&generated64), sizeof(uint64_t));
+                if (generated_)
+                {
+                    uint64_t coeff_count_power64 = static_cast<uint64_t>(coeff_count_power_);
+                    stream.write(reinterpret_cast<const char*>(&coeff_count_power64), 
+                        sizeof(uint64_t));
+                    modulus_.save(stream);
+                    stream.write(reinterpret_cast<const char*>(&root_), sizeof(uint64_t));
+                    stream.write(reinterpret_cast<const char*>(&inv_degree_modulo_), 
+                        sizeof(uint64_t));
+                    stream.write(reinterpret_cast<const char*>(data_->get()), 
+                        static_cast<streamsize>(6 * coeff_count_ * bytes_per_uint64));
+                }
+            }
+            catch (const exception &)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void SmallNTTTables::load(istream &stream)
+        {
+            reset();
+
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                uint64_t generated64 = 0;
+                stream.read(reinterpret_cast<char*>(&generated64), sizeof(uint64_t));
+                if (generated64)
+                {
+                    uint64_t coeff_count_power64 = 0;
+                    stream.read(reinterpret_cast<char*>(&coeff_count_power64), 
+                        sizeof(uint64_t));
+                    if (coeff_count_power64 < static_cast<uint64_t>(
+                        get_power_of_two(SEAL_POLY_MOD_DEGREE_MIN)) ||
+                        coeff_count_power64 > static_cast<uint64_t>(
+                        get_power_of_two(SEAL_POLY_MOD_DEGREE_MAX)))
+                    {
+                        throw invalid_argument("coeff_count_power out of range");
+                    }
+                    coeff_count_power_ = static_cast<int>(coeff_count_power64);
+                    coeff_count_ = size_t(1) << coeff_count_power_;
+                    modulus_.load(stream);
+                    stream.read(reinterpret_cast<char*>(&root_), sizeof(uint64_t));
+                    stream.read(reinterpret_cast<char*>(&inv_degree_modulo_), 
+                        sizeof(uint64_t));
+                    data_ = std::make_shared<Pointer<uint64_t>>(
+                        allocate_uint(6 * coeff_count_, pool_));
+                    set_table_pointers();
+                    stream.read(reinterpret_cast<char*>(data_->get()), 
+                        static_cast<streamsize>(6 * coeff_count_ * bytes_per_uint64));
+                    generated_ = true;
+                }
+            }
+            catch (const exception &)
+            {
+                reset();
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void SmallNTTTables::set_table_pointers() noexcept
+        {
+            // The order of the tables matches the format written by save
+            root_powers_ = data_->get();
+            scaled_root_powers_ = root_powers_ + coeff_count_;
+            inv_root_powers_ = scaled_root_powers_ + coeff_count_;
+            scaled_inv_root_powers_ = inv_root_powers_ + coeff_count_;
+            inv_root_powers_div_two_ = scaled_inv_root_powers_ + coeff_count_;
+            scaled_inv_root_powers_div_two_ = inv_root_powers_div_two_ + coeff_count_;
+        }
+
         void SmallNTTTables::ntt_powers_of_primitive_root(uint64_t root, 
             uint64_t *destination) const
         {
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <stdexcept>
+#include <iostream>
+#include <memory>
 #include "seal/util/pointer.h"
 #include "seal/memorymanager.h"
 #include "seal/smallmodulus.h"
@@ -12,6 +14,13 @@ namespace seal
 {
     namespace util
     {
+        /**
+        Stores the pre-computed tables for the negacyclic NTT modulo a prime. The 
+        tables are immutable once generated, and copies of a SmallNTTTables share 
+        the same table data, so copying is cheap. This allows the levels of a 
+        modulus switching chain to share the tables for the primes they have in 
+        common.
+        */
         class SmallNTTTables
         {
         public:
@@ -29,6 +38,16 @@ namespace seal
             SmallNTTTables(int coeff_count_power, const SmallModulus &modulus,
                 MemoryPoolHandle pool = MemoryManager::GetPool());
 
+            /**
+            Creates a copy sharing the table data of the given SmallNTTTables.
+            */
+            SmallNTTTables(const SmallNTTTables &copy) = default;
+
+            /**
+            Makes this a copy sharing the table data of the given SmallNTTTables.
+            */
+            SmallNTTTables &operator =(const SmallNTTTables &assign) = default;
+
             inline bool is_generated() const
             {
                 return generated_;
@@ -38,6 +57,26 @@ namespace seal
 
             void reset();
 
+            /**
+            Saves the tables to an output stream. The output is in binary format 
+            and consists only of 64-bit words, so a saved set of tables can be 
+            restored with load without redoing any modular arithmetic.
+
+            @param[in] stream The stream to save the tables to
+            @throws std::exception if the tables could not be written to stream
+            */
+            void save(std::ostream &stream) const;
+
+            /**
+            Loads tables previously written by save, overwriting the current 
+            tables.
+
+            @param[in] stream The stream to load the tables from
+            @throws std::invalid_argument if the loaded tables are invalid
+            @throws std::exception if the tables could not be read from stream
+            */
+            void load(std::istream &stream);
+
             inline std::uint64_t get_root() const
             {
 #ifdef SEAL_DEBUG
@@ -167,14 +206,17 @@ namespace seal
                 return coeff_count_;
             }
 
-        private:
-            SmallNTTTables(const SmallNTTTables &copy) = delete;
-
-            SmallNTTTables(SmallNTTTables &&source) = delete;
-
-            SmallNTTTables &operator =(const SmallNTTTables &assign) = delete;
+            /**
+            Returns whether these tables share their data with other.
+            */
+            inline bool shares_data_with(const SmallNTTTables &other) const noexcept
+            {
+                return data_ && data_ == other.data_;
+            }
 
-            SmallNTTTables &operator =(SmallNTTTables &&assign) = delete;
+        private:
+            // Points the table pointers into data_
+            void set_table_pointers() noexcept;
 
             // Computed bit-scrambled vector of first 1 << coeff_count_power powers 
             // of a primitive root.
@@ -192,17 +234,21 @@ namespace seal
 
             std::uint64_t root_ = 0;
 
+            // Holds all six tables of size coeff_count_ in one allocation; shared 
+            // between copies
+            std::shared_ptr<Pointer<decltype(root_)>> data_;
+
             // Size coeff_count_
-            Pointer<decltype(root_)> root_powers_;
+            decltype(root_) *root_powers_ = nullptr;
 
             // Size coeff_count_
-            Pointer<decltype(root_)> scaled_root_powers_;
+            decltype(root_) *scaled_root_powers_ = nullptr;
 
             // Size coeff_count_
-            Pointer<decltype(root_)> inv_root_powers_div_two_;
+            decltype(root_) *inv_root_powers_div_two_ = nullptr;
 
             // Size coeff_count_
-            Pointer<decltype(root_)> scaled_inv_root_powers_div_two_;
+            decltype(root_) *scaled_inv_root_powers_div_two_ = nullptr;
 
             int coeff_count_power_ = 0;
 
@@ -211,10 +257,10 @@ namespace seal
             SmallModulus modulus_;
 
             // Size coeff_count_
-            Pointer<decltype(root_)> inv_root_powers_;
+            decltype(root_) *inv_root_powers_ = nullptr;
 
             // Size coeff_count_
-            Pointer<decltype(root_)> scaled_inv_root_powers_;
+            decltype(root_) *scaled_inv_root_powers_ = nullptr;
 
             std::uint64_t inv_degree_modulo_ = 0;
 
@@ -200,6 +200,70 @@ namespace seal
             return barrett_reduce_128(z, modulus);
         }
 
+        /**
+        A fixed operand of modular multiplication together with the precomputed
+        quotient floor(operand * 2^64 / modulus). Multiplying by it with Shoup's
+        method takes two 64-bit multiplications and no 128-bit reduction, which
+        pays off as soon as the same operand is used more than a few times.
+        */
+        struct MultiplyUIntModOperand
+        {
+            std::uint64_t operand = 0;
+
+            std::uint64_t quotient = 0;
+
+            MultiplyUIntModOperand() = default;
+
+            MultiplyUIntModOperand(std::uint64_t new_operand,
+                const SmallModulus &modulus)
+            {
+                set(new_operand, modulus);
+            }
+
+            inline void set(std::uint64_t new_operand, const SmallModulus &modulus)
+            {
+#ifdef SEAL_DEBUG
+                if (modulus.is_zero())
+                {
+                    throw std::invalid_argument("modulus");
+                }
+                if (new_operand >= modulus.value())
+                {
+                    throw std::invalid_argument("operand");
+                }
+#endif
+                operand = new_operand;
+                std::uint64_t wide_quotient[2]{ 0, 0 };
+                std::uint64_t wide_coeff[2]{ 0, operand };
+                divide_uint128_uint64_inplace(wide_coeff, modulus.value(), wide_quotient);
+                quotient = wide_quotient[0];
+            }
+        };
+
+        /**
+        Returns a value congruent to operand1 * operand2 modulo modulus in the
+        range [0, 2 * modulus). Here operand1 can be any 64-bit value.
+        */
+        inline std::uint64_t multiply_uint_mod_lazy(std::uint64_t operand1,
+            const MultiplyUIntModOperand &operand2, const SmallModulus &modulus)
+        {
+            unsigned long long estimated_quotient;
+            multiply_uint64_hw64(operand1, operand2.quotient, &estimated_quotient);
+            return operand1 * operand2.operand - estimated_quotient * modulus.value();
+        }
+
+        /**
+        Returns operand1 * operand2 mod modulus. Here operand1 can be any 64-bit
+        value.
+        */
+        inline std::uint64_t multiply_uint_mod(std::uint64_t operand1,
+            const MultiplyUIntModOperand &operand2, const SmallModulus &modulus)
+        {
+            std::uint64_t result = multiply_uint_mod_lazy(operand1, operand2, modulus);
+            return result - (modulus.value() & static_cast<std::uint64_t>(
+                -static_cast<std::int64_t>(result >= modulus.value())));
+        }
+
         inline void modulo_uint_inplace(std::uint64_t *value, 
             std::size_t value_uint64_count, const SmallModulus &modulus)
         {
@@ -68,6 +68,209 @@ namespace SEALTest
         }
     }
 
+    TEST(BatchEncoderTest, DecodeSlots)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_60bit(0) });
+        parms.set_plain_modulus(257);
+
+        auto context = SEALContext::Create(parms);
+        BatchEncoder batch_encoder(context);
+        vector<uint64_t> plain_vec;
+        for (size_t i = 0; i < batch_encoder.slot_count(); i++)
+        {
+            plain_vec.push_back((i * 37 + 11) % 257);
+        }
+        Plaintext plain;
+        batch_encoder.encode(plain_vec, plain);
+
+        // Few slots are evaluated directly, many through a full decode
+        vector<size_t> slots{ 0, 63, 32, 5 };
+        vector<uint64_t> values;
+        batch_encoder.decode_slots(plain, slots, values);
+        ASSERT_EQ(slots.size(), values.size());
+        for (size_t k = 0; k < slots.size(); k++)
+        {
+            ASSERT_EQ(plain_vec[slots[k]], values[k]);
+        }
+        for (size_t i = 0; i < batch_encoder.slot_count(); i++)
+        {
+            slots.push_back(i);
+        }
+        batch_encoder.decode_slots(plain, slots, values);
+        ASSERT_EQ(slots.size(), values.size());
+        for (size_t k = 0; k < slots.size(); k++)
+        {
+            ASSERT_EQ(plain_vec[slots[k]], values[k]);
+        }
+
+        vector<int64_t> signed_values;
+        batch_encoder.decode_slots(Plaintext("100"), { 1, 33 }, signed_values);
+        ASSERT_EQ(2ULL, signed_values.size());
+        ASSERT_EQ(-1, signed_values[0]);
+        ASSERT_EQ(-1, signed_values[1]);
+
+        batch_encoder.decode_slots(Plaintext(), { 7 }, values);
+        ASSERT_EQ(1ULL, values.size());
+        ASSERT_EQ(0ULL, values[0]);
+        ASSERT_THROW(batch_encoder.decode_slots(plain, { 64 }, values), invalid_argument);
+    }
+
+    TEST(BatchEncoderTest, EncodeDecodeMany)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_60bit(0) });
+        parms.set_plain_modulus(257);
+
+        auto context = SEALContext::Create(parms);
+        BatchEncoder batch_encoder(context);
+        size_t slot_count = batch_encoder.slot_count();
+        vector<uint64_t> matrices;
+        vector<int64_t> signed_matrices;
+        for (size_t i = 0; i < 3 * slot_count; i++)
+        {
+            matrices.push_back((i * 37 + 11) % 257);
+            signed_matrices.push_back(static_cast<int64_t>(matrices.back()) - 128);
+        }
+
+        // Matches encoding and decoding the matrices one by one
+        for (size_t thread_count : { 1, 0 })
+        {
+            batch_encoder.set_thread_count(thread_count);
+            vector<Plaintext> plains;
+            batch_encoder.encode_many(matrices, plains);
+            ASSERT_EQ(3ULL, plains.size());
+            for (size_t k = 0; k < plains.size(); k++)
+            {
+                Plaintext plain;
+                batch_encoder.encode(vector<uint64_t>(matrices.begin() + k * slot_count,
+                    matrices.begin() + (k + 1) * slot_count), plain);
+                ASSERT_TRUE(plain == plains[k]);
+            }
+            vector<uint64_t> values;
+            batch_encoder.decode_many(plains, values);
+            ASSERT_TRUE(matrices == values);
+
+            batch_encoder.encode_many(signed_matrices, plains);
+            for (size_t k = 0; k < plains.size(); k++)
+            {
+                Plaintext plain;
+                batch_encoder.encode(vector<int64_t>(
+                    signed_matrices.begin() + k * slot_count,
+                    signed_matrices.begin() + (k + 1) * slot_count), plain);
+                ASSERT_TRUE(plain == plains[k]);
+            }
+            vector<int64_t> signed_values;
+            batch_encoder.decode_many(plains, signed_values);
+            ASSERT_TRUE(signed_matrices == signed_values);
+        }
+
+        vector<Plaintext> plains;
+        batch_encoder.encode_many(vector<uint64_t>(), plains);
+        ASSERT_EQ(0ULL, plains.size());
+        ASSERT_THROW(batch_encoder.encode_many(vector<uint64_t>(slot_count + 1), plains),
+            invalid_argument);
+    }
+
+    TEST(BatchEncoderTest, EncodeDecodePointers)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_60bit(0) });
+        parms.set_plain_modulus(257);
+
+        auto context = SEALContext::Create(parms);
+        BatchEncoder batch_encoder(context);
+        size_t slot_count = batch_encoder.slot_count();
+        vector<uint64_t> matrix;
+        vector<int64_t> signed_matrix;
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            matrix.push_back((i * 37 + 11) % 257);
+            signed_matrix.push_back(static_cast<int64_t>(matrix.back()) - 128);
+        }
+
+        // Full and partial matrices round-trip through caller-owned memory
+        Plaintext plain;
+        batch_encoder.encode(matrix.data(), slot_count, plain);
+        vector<uint64_t> values(slot_count);
+        batch_encoder.decode(plain, values.data());
+        ASSERT_TRUE(matrix == values);
+
+        batch_encoder.encode(matrix.data(), 20, plain);
+        batch_encoder.decode(plain, values.data());
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            ASSERT_EQ(i < 20 ? matrix[i] : 0, values[i]);
+        }
+
+        batch_encoder.encode(signed_matrix.data(), slot_count, plain);
+        vector<int64_t> signed_values(slot_count);
+        batch_encoder.decode(plain, signed_values.data());
+        ASSERT_TRUE(signed_matrix == signed_values);
+
+        batch_encoder.encode(signed_matrix.data(), 20, plain);
+        batch_encoder.decode(plain, signed_values.data());
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            ASSERT_EQ(i < 20 ? signed_matrix[i] : 0, signed_values[i]);
+        }
+
+        const uint64_t *null_values = nullptr;
+        batch_encoder.encode(null_values, 0, plain);
+        ASSERT_TRUE(plain.is_zero());
+        ASSERT_THROW(batch_encoder.encode(null_values, 1, plain), invalid_argument);
+        ASSERT_THROW(batch_encoder.decode(plain, static_cast<uint64_t*>(nullptr)),
+            invalid_argument);
+    }
+
+    TEST(BatchEncoderTest, EncodeDecodeBits)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(128);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_60bit(0) });
+        parms.set_plain_modulus(257);
+
+        auto context = SEALContext::Create(parms);
+        BatchEncoder batch_encoder(context);
+        ASSERT_EQ(2ULL, batch_encoder.bits_uint64_count());
+
+        // Same plaintext as encoding the unpacked bits
+        vector<uint64_t> bits{ 0x8000000000000011ULL, 0x0123456789ABCDEFULL };
+        vector<uint64_t> values(batch_encoder.slot_count());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = (bits[i / 64] >> (i % 64)) & 1;
+        }
+        Plaintext plain, expected;
+        batch_encoder.encode_bits(bits, plain);
+        batch_encoder.encode(values, expected);
+        ASSERT_TRUE(expected == plain);
+        vector<uint64_t> result;
+        batch_encoder.decode_bits(plain, result);
+        ASSERT_TRUE(bits == result);
+
+        // Missing words are zero; constant matrices are constant polynomials
+        batch_encoder.encode_bits({ 1 }, plain);
+        batch_encoder.decode_bits(plain, result);
+        ASSERT_EQ(1ULL, result[0]);
+        ASSERT_EQ(0ULL, result[1]);
+        batch_encoder.encode_bits({}, plain);
+        ASSERT_TRUE(plain.is_zero());
+        ASSERT_EQ(batch_encoder.slot_count(), plain.coeff_count());
+        batch_encoder.encode_bits({ ~0ULL, ~0ULL }, plain);
+        ASSERT_EQ(1ULL, plain.significant_coeff_count());
+        ASSERT_EQ(1ULL, plain[0]);
+        batch_encoder.decode_bits(plain, result);
+        ASSERT_EQ(~0ULL, result[0]);
+        ASSERT_EQ(~0ULL, result[1]);
+
+        ASSERT_THROW(batch_encoder.encode_bits({ 0, 0, 0 }, plain), invalid_argument);
+        ASSERT_THROW(batch_encoder.decode_bits(Plaintext("2"), result), invalid_argument);
+    }
+
     TEST(BatchEncoderTest, BatchUnbatchIntVector)
     {
         EncryptionParameters parms(scheme_type::BFV);
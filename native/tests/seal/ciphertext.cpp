@@ -118,6 +118,7 @@ namespace SEALTest
         KeyGenerator keygen(context);
         Encryptor encryptor(context, keygen.public_key());
         encryptor.encrypt(Plaintext("Ax^10 + 9x^9 + 8x^8 + 7x^7 + 6x^6 + 5x^5 + 4x^4 + 3x^3 + 2x^2 + 1"), ctxt);
+        ctxt.noise_budget() = 10.0;
         ctxt.save(stream);
         ctxt2.load(context, stream);
         ASSERT_TRUE(ctxt.parms_id() == ctxt2.parms_id());
@@ -126,5 +127,19 @@ namespace SEALTest
         ASSERT_TRUE(is_equal_uint_uint(ctxt.data(), ctxt2.data(),
             parms.poly_modulus_degree() * parms.coeff_modulus().size() * 2));
         ASSERT_TRUE(ctxt.data() != ctxt2.data());
+        ASSERT_EQ(10.0, ctxt2.noise_budget());
+
+        // Without an estimate the optional field is omitted and a following
+        // ciphertext in the same stream still loads
+        Ciphertext ctxt3;
+        ctxt.noise_budget() = 0.0;
+        ctxt.save(stream);
+        ctxt2.save(stream);
+        ctxt3.load(context, stream);
+        ASSERT_EQ(0.0, ctxt3.noise_budget());
+        ASSERT_TRUE(is_equal_uint_uint(ctxt.data(), ctxt3.data(),
+            parms.poly_modulus_degree() * parms.coeff_modulus().size() * 2));
+        ctxt3.load(context, stream);
+        ASSERT_EQ(10.0, ctxt3.noise_budget());
     }
 }
@@ -3,6 +3,17 @@
 
 #include "gtest/gtest.h"
 #include "seal/context.h"
+#include "seal/defaultparams.h"
+#include "seal/keygenerator.h"
+#include "seal/encryptor.h"
+#include "seal/decryptor.h"
+#include "seal/evaluator.h"
+#include "seal/batchencoder.h"
+#include "seal/util/polyarithsmallmod.h"
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <thread>
 
 using namespace seal;
 using namespace std;
@@ -225,4 +236,353 @@ namespace SEALTest
             ASSERT_FALSE(!!context->context_data()->next_context_data());
         }
     }
+
+    namespace
+    {
+        void compare_contexts(const SEALContext &context1, 
+            const SEALContext &context2)
+        {
+            ASSERT_TRUE(context1.first_parms_id() == context2.first_parms_id());
+            ASSERT_TRUE(context1.last_parms_id() == context2.last_parms_id());
+            auto data1 = context1.context_data();
+            auto data2 = context2.context_data();
+            while (data1)
+            {
+                ASSERT_TRUE(!!data2);
+                ASSERT_TRUE(data1->parms() == data2->parms());
+                ASSERT_EQ(data1->chain_index(), data2->chain_index());
+                ASSERT_EQ(data1->qualifiers().using_batching, 
+                    data2->qualifiers().using_batching);
+                ASSERT_EQ(data1->qualifiers().using_fast_plain_lift, 
+                    data2->qualifiers().using_fast_plain_lift);
+                ASSERT_EQ(data1->total_coeff_modulus_bit_count(),
+                    data2->total_coeff_modulus_bit_count());
+
+                size_t coeff_count = data1->parms().poly_modulus_degree();
+                size_t coeff_mod_count = data1->parms().coeff_modulus().size();
+                for (size_t i = 0; i < coeff_mod_count; i++)
+                {
+                    ASSERT_EQ(data1->total_coeff_modulus()[i], 
+                        data2->total_coeff_modulus()[i]);
+                    auto &tables1 = data1->small_ntt_tables()[i];
+                    auto &tables2 = data2->small_ntt_tables()[i];
+                    ASSERT_EQ(tables1.get_root(), tables2.get_root());
+                    ASSERT_EQ(*tables1.get_inv_degree_modulo(), 
+                        *tables2.get_inv_degree_modulo());
+                    for (size_t j = 0; j < coeff_count; j++)
+                    {
+                        ASSERT_EQ(tables1.get_from_root_powers(j), 
+                            tables2.get_from_root_powers(j));
+                        ASSERT_EQ(tables1.get_from_scaled_inv_root_powers_div_two(j), 
+                            tables2.get_from_scaled_inv_root_powers_div_two(j));
+                    }
+                }
+
+                auto &bc1 = *data1->base_converter();
+                auto &bc2 = *data2->base_converter();
+                ASSERT_EQ(bc1.bsk_base_mod_count(), bc2.bsk_base_mod_count());
+                ASSERT_EQ(bc1.get_inv_gamma(), bc2.get_inv_gamma());
+                for (size_t i = 0; i < coeff_mod_count * coeff_mod_count; i++)
+                {
+                    ASSERT_EQ(bc1.get_coeff_products_array()[i], 
+                        bc2.get_coeff_products_array()[i]);
+                }
+                for (size_t i = 0; i < bc1.bsk_base_mod_count(); i++)
+                {
+                    ASSERT_EQ(bc1.get_bsk_mod_array()[i], bc2.get_bsk_mod_array()[i]);
+                    ASSERT_EQ(bc1.get_bsk_small_ntt_tables()[i].get_root(),
+                        bc2.get_bsk_small_ntt_tables()[i].get_root());
+                }
+
+                data1 = data1->next_context_data();
+                data2 = data2->next_context_data();
+            }
+            ASSERT_FALSE(!!data2);
+        }
+    }
+
+    TEST(ContextTest, SaveLoadContext)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0),
+            DefaultParams::small_mods_30bit(1), DefaultParams::small_mods_30bit(2) });
+        parms.set_plain_modulus(65537);
+        auto context = SEALContext::Create(parms);
+
+        stringstream stream;
+        context->save(stream);
+        auto context2 = SEALContext::Load(parms, stream);
+        compare_contexts(*context, *context2);
+
+        // Keys and ciphertexts work across the two contexts
+        KeyGenerator keygen(context);
+        auto relin_keys = keygen.relin_keys(30);
+        Encryptor encryptor(context, keygen.public_key());
+        Decryptor decryptor(context2, keygen.secret_key());
+        Evaluator evaluator(context2);
+        BatchEncoder encoder(context2);
+        vector<uint64_t> values(64, 0);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = i;
+        }
+        Plaintext plain;
+        encoder.encode(values, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+        evaluator.square_inplace(encrypted);
+        evaluator.relinearize_inplace(encrypted, relin_keys);
+        evaluator.mod_switch_to_next_inplace(encrypted);
+        decryptor.decrypt(encrypted, plain);
+        vector<uint64_t> result;
+        encoder.decode(plain, result);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            ASSERT_EQ(values[i] * values[i], result[i]);
+        }
+
+        // Parameters must match
+        EncryptionParameters other_parms(parms);
+        other_parms.set_plain_modulus(257);
+        stream.seekg(0);
+        ASSERT_THROW(SEALContext::Load(other_parms, stream), invalid_argument);
+
+        // Unexpanded chain
+        context = SEALContext::Create(parms, false);
+        stream.str("");
+        context->save(stream);
+        context2 = SEALContext::Load(parms, stream);
+        compare_contexts(*context, *context2);
+
+        // CKKS
+        parms = EncryptionParameters(scheme_type::CKKS);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0),
+            DefaultParams::small_mods_30bit(1) });
+        context = SEALContext::Create(parms);
+        stream.str("");
+        context->save(stream);
+        context2 = SEALContext::Load(parms, stream);
+        compare_contexts(*context, *context2);
+
+        // Truncated data
+        string data = stream.str();
+        stringstream truncated(data.substr(0, data.size() / 2));
+        ASSERT_ANY_THROW(SEALContext::Load(parms, truncated));
+
+        // Invalid parameters cannot be saved
+        parms.set_coeff_modulus({ 30 });
+        context = SEALContext::Create(parms);
+        ASSERT_FALSE(context->parameters_set());
+        ASSERT_THROW(context->save(stream), logic_error);
+    }
+
+    TEST(ContextTest, ContextCacheFile)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0),
+            DefaultParams::small_mods_30bit(1) });
+        parms.set_plain_modulus(65537);
+
+        string cache_path = "context_cache_test.bin";
+        remove(cache_path.c_str());
+
+        // The first call creates the cache file
+        auto context = SEALContext::Create(parms, true, cache_path);
+        ASSERT_TRUE(context->parameters_set());
+        ASSERT_TRUE(ifstream(cache_path, ios::binary).is_open());
+
+        // The second call loads it
+        auto context2 = SEALContext::Create(parms, true, cache_path);
+        compare_contexts(*context, *context2);
+
+        // A different chain or different parameters replace the cache
+        context2 = SEALContext::Create(parms, false, cache_path);
+        ASSERT_TRUE(context2->first_parms_id() == context2->last_parms_id());
+        parms.set_plain_modulus(257);
+        context2 = SEALContext::Create(parms, true, cache_path);
+        ASSERT_TRUE(context2->first_parms_id() == parms.parms_id());
+        ifstream cache_stream(cache_path, ios::binary);
+        ASSERT_NO_THROW(SEALContext::Load(parms, cache_stream));
+        cache_stream.close();
+
+        // A corrupted cache is ignored
+        {
+            ofstream corrupt(cache_path, ios::binary | ios::trunc);
+            corrupt << "not a context";
+        }
+        context2 = SEALContext::Create(parms, true, cache_path);
+        ASSERT_TRUE(context2->parameters_set());
+
+        remove(cache_path.c_str());
+    }
+
+    TEST(ContextTest, LazyContext)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0),
+            DefaultParams::small_mods_30bit(1), DefaultParams::small_mods_30bit(2),
+            DefaultParams::small_mods_30bit(3) });
+        parms.set_plain_modulus(65537);
+
+        // Concurrent first access publishes a single ContextData per level
+        auto context = SEALContext::CreateLazy(parms);
+        ASSERT_TRUE(context->parameters_set());
+        ASSERT_EQ(3ULL, context->context_data()->chain_index());
+        vector<const SEALContext::ContextData*> results(8, nullptr);
+        vector<thread> threads;
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            threads.emplace_back([&, i]() {
+                results[i] = context->context_data(context->last_parms_id()).get();
+            });
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+        ASSERT_TRUE(results[0] != nullptr);
+        ASSERT_EQ(0ULL, results[0]->chain_index());
+        for (auto result : results)
+        {
+            ASSERT_EQ(results[0], result);
+        }
+        ASSERT_FALSE(!!context->context_data(parms_id_zero));
+
+        // The chain is identical to an eagerly created one
+        auto eager_context = SEALContext::Create(parms);
+        compare_contexts(*eager_context, *context);
+
+        // Operations on lower levels work
+        context = SEALContext::CreateLazy(parms);
+        KeyGenerator keygen(context);
+        Encryptor encryptor(context, keygen.public_key());
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        Plaintext plain("1x^10 + 2x^1 + 3");
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+        evaluator.mod_switch_to_inplace(encrypted, context->last_parms_id());
+        Plaintext result;
+        decryptor.decrypt(encrypted, result);
+        ASSERT_TRUE(plain == result);
+
+        // A lazy context can be saved
+        stringstream stream;
+        context->save(stream);
+        compare_contexts(*eager_context, *SEALContext::Load(parms, stream));
+    }
+
+    TEST(ContextTest, SharedNTTTables)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0),
+            DefaultParams::small_mods_30bit(1), DefaultParams::small_mods_30bit(2) });
+        parms.set_plain_modulus(257);
+
+        for (bool lazy : { false, true })
+        {
+            auto context = lazy ? SEALContext::CreateLazy(parms) :
+                SEALContext::Create(parms);
+            auto first = context->context_data();
+            auto next = first->next_context_data();
+            while (next)
+            {
+                // Lower levels point to the tables of the first level
+                for (size_t i = 0; i < next->parms().coeff_modulus().size(); i++)
+                {
+                    ASSERT_TRUE(next->small_ntt_tables()[i].shares_data_with(
+                        first->small_ntt_tables()[i]));
+                }
+                ASSERT_TRUE(next->plain_ntt_tables()->shares_data_with(
+                    *first->plain_ntt_tables()));
+                ASSERT_TRUE(next->base_converter()->get_bsk_small_ntt_tables()[0]
+                    .shares_data_with(first->base_converter()->get_bsk_small_ntt_tables()[0]));
+                next = next->next_context_data();
+            }
+
+            // Computations down the chain are unaffected
+            KeyGenerator keygen(context);
+            Encryptor encryptor(context, keygen.public_key());
+            Decryptor decryptor(context, keygen.secret_key());
+            Evaluator evaluator(context);
+            Plaintext plain("1x^10 + 2x^1 + 3");
+            Ciphertext encrypted;
+            encryptor.encrypt(plain, encrypted);
+            evaluator.mod_switch_to_next_inplace(encrypted);
+            evaluator.square_inplace(encrypted);
+            Plaintext result;
+            decryptor.decrypt(encrypted, result);
+            ASSERT_EQ("1x^20 + 4x^11 + 6x^10 + 4x^2 + Cx^1 + 9", result.to_string());
+        }
+    }
+
+    TEST(ContextTest, GaloisNTTPermutation)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0) });
+        parms.set_plain_modulus(257);
+        auto context = SEALContext::Create(parms);
+
+        ASSERT_THROW(context->galois_ntt_permutation(0), invalid_argument);
+        ASSERT_THROW(context->galois_ntt_permutation(4), invalid_argument);
+        ASSERT_THROW(context->galois_ntt_permutation(129), invalid_argument);
+
+        vector<uint64_t> input(64);
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            input[i] = i * 7 + 1;
+        }
+        for (uint64_t galois_elt : { 1ULL, 3ULL, 127ULL })
+        {
+            // Tables are cached
+            auto &table = context->galois_ntt_permutation(galois_elt);
+            ASSERT_EQ(&table, &context->galois_ntt_permutation(galois_elt));
+            ASSERT_EQ(64ULL, table.size());
+
+            vector<uint64_t> expected(64), result(64);
+            util::apply_galois_ntt(input.data(), 6, galois_elt, expected.data());
+            util::apply_galois_ntt(input.data(), input.size(), table.data(), result.data());
+            ASSERT_TRUE(expected == result);
+        }
+    }
+
+    TEST(ContextTest, GaloisPermutation)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0) });
+        parms.set_plain_modulus(257);
+        auto context = SEALContext::Create(parms);
+        SmallModulus modulus = DefaultParams::small_mods_30bit(0);
+
+        ASSERT_THROW(context->galois_permutation(0), invalid_argument);
+        ASSERT_THROW(context->galois_permutation(4), invalid_argument);
+        ASSERT_THROW(context->galois_permutation(129), invalid_argument);
+
+        vector<uint64_t> input(64);
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            input[i] = i * 7;
+        }
+        for (uint64_t galois_elt : { 1ULL, 3ULL, 127ULL })
+        {
+            // Tables are cached separately from the NTT tables
+            auto &table = context->galois_permutation(galois_elt);
+            ASSERT_EQ(&table, &context->galois_permutation(galois_elt));
+            ASSERT_NE(&table, &context->galois_ntt_permutation(galois_elt));
+            ASSERT_EQ(64ULL, table.size());
+
+            vector<uint64_t> expected(64), result(64);
+            util::apply_galois(input.data(), 6, galois_elt, modulus, expected.data());
+            util::apply_galois(input.data(), input.size(), table.data(), modulus,
+                result.data());
+            ASSERT_TRUE(expected == result);
+        }
+    }
 }
@@ -5,6 +5,7 @@
 #include "seal/context.h"
 #include "seal/encryptor.h"
 #include "seal/decryptor.h"
+#include "seal/evaluator.h"
 #include "seal/keygenerator.h"
 #include "seal/batchencoder.h"
 #include "seal/ckks.h"
@@ -187,6 +188,48 @@ namespace SEALTest
         }
     }
 
+    TEST(EncryptorTest, FVEncryptDecryptMany)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(1 << 6);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        RelinKeys rlk = keygen.relin_keys(30);
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        // Ciphertexts of different sizes and levels are decrypted together
+        vector<Ciphertext> encrypteds(20);
+        for (size_t i = 0; i < encrypteds.size(); i++)
+        {
+            encryptor.encrypt(Plaintext(to_string(i + 1) + "x^" + to_string(i)),
+                encrypteds[i]);
+        }
+        evaluator.square_inplace(encrypteds[3]);
+        evaluator.mod_switch_to_next_inplace(encrypteds[4]);
+
+        for (size_t thread_count : { 1, 4 })
+        {
+            decryptor.set_thread_count(thread_count);
+            ASSERT_EQ(thread_count, decryptor.thread_count());
+            vector<Plaintext> plains;
+            decryptor.decrypt_many(encrypteds, plains);
+            ASSERT_EQ(encrypteds.size(), plains.size());
+            for (size_t i = 0; i < encrypteds.size(); i++)
+            {
+                Plaintext plain;
+                decryptor.decrypt(encrypteds[i], plain);
+                ASSERT_TRUE(plain == plains[i]);
+            }
+            ASSERT_EQ("10x^6", plains[3].to_string());
+            ASSERT_EQ("5x^4", plains[4].to_string());
+        }
+    }
+
     TEST(EncryptorTest, CKKSEncryptDecrypt)
     {
         EncryptionParameters parms(scheme_type::CKKS);
@@ -1294,6 +1294,52 @@ namespace SEALTest
         decryptor.decrypt(encrypted, plain2);
         ASSERT_TRUE(plain2.to_string() == "1x^40 + 8x^30 + 18x^20 + 20x^10 + 10");
     }
+
+    TEST(EvaluatorTest, FVKeySwitchManyDigits)
+    {
+        // More decomposition digits than the 128-bit accumulators can absorb 
+        // without intermediate reductions
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_60bit(0), 
+            DefaultParams::small_mods_60bit(1), DefaultParams::small_mods_60bit(2) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        RelinKeys rlk = keygen.relin_keys(1);
+        GaloisKeys glk = keygen.galois_keys(1);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder encoder(context);
+
+        Ciphertext encrypted;
+        Plaintext plain;
+        plain = "1x^10 + 2";
+        encryptor.encrypt(plain, encrypted);
+        evaluator.square_inplace(encrypted);
+        evaluator.relinearize_inplace(encrypted, rlk);
+        decryptor.decrypt(encrypted, plain);
+        ASSERT_EQ("1x^20 + 4x^10 + 4", plain.to_string());
+
+        vector<uint64_t> values(encoder.slot_count()), result;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = i;
+        }
+        encoder.encode(values, plain);
+        encryptor.encrypt(plain, encrypted);
+        evaluator.rotate_columns_inplace(encrypted, glk);
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, result);
+        size_t row_size = values.size() / 2;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            ASSERT_EQ(values[(i + row_size) % values.size()], result[i]);
+        }
+    }
+
     TEST(EvaluatorTest, CKKSEncryptNaiveMultiplyDecrypt)
     {
         EncryptionParameters parms(scheme_type::CKKS);
@@ -2572,6 +2618,54 @@ namespace SEALTest
             }
         }
     }
+
+    TEST(EvaluatorTest, CKKSEncryptLowerLevelSquareDecrypt)
+    {
+        // Size 3 ciphertexts below the top level read powers of the secret key
+        // that were computed at the top level
+        EncryptionParameters parms(scheme_type::CKKS);
+        size_t slot_size = 32;
+        parms.set_poly_modulus_degree(slot_size * 2);
+        parms.set_coeff_modulus({
+            DefaultParams::small_mods_60bit(0), DefaultParams::small_mods_60bit(1),
+            DefaultParams::small_mods_60bit(2), DefaultParams::small_mods_60bit(3) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+
+        CKKSEncoder encoder(context);
+        Encryptor encryptor(context, keygen.public_key());
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+
+        srand(static_cast<unsigned>(time(NULL)));
+        vector<complex<double>> input(slot_size);
+        vector<complex<double>> output(slot_size);
+        for (size_t i = 0; i < slot_size; i++)
+        {
+            input[i] = static_cast<double>(rand() % 16);
+        }
+
+        Ciphertext encrypted;
+        Plaintext plain;
+        auto context_data = context->context_data();
+        for (int level = 0; level < 2; level++)
+        {
+            context_data = context_data->next_context_data();
+            encoder.encode(input, context_data->parms().parms_id(),
+                static_cast<double>(1ULL << 30), plain);
+            encryptor.encrypt(plain, encrypted);
+            evaluator.square_inplace(encrypted);
+            ASSERT_EQ(3ULL, encrypted.size());
+
+            decryptor.decrypt(encrypted, plain);
+            encoder.decode(plain, output);
+            for (size_t i = 0; i < slot_size; i++)
+            {
+                ASSERT_TRUE(abs(input[i].real() * input[i].real() - output[i].real()) < 0.5);
+            }
+        }
+    }
+
     TEST(EvaluatorTest, CKKSEncryptMultiplyRelinRescaleModSwitchAddDecrypt)
     {
         EncryptionParameters parms(scheme_type::CKKS);
@@ -3333,6 +3427,170 @@ namespace SEALTest
         ASSERT_TRUE(sum.parms_id() == parms.parms_id());
     }
 
+    TEST(EvaluatorTest, FVEncryptInnerProductDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(128);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0), 
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+
+        BatchEncoder encoder(context);
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        RelinKeys rlk = keygen.relin_keys(30);
+
+        // Enough terms to force intermediate reductions of the accumulators
+        size_t term_count = 100;
+        size_t slot_count = encoder.slot_count();
+        vector<Ciphertext> encrypteds1(term_count), encrypteds2(term_count);
+        vector<Plaintext> plains(term_count);
+        vector<uint64_t> expected(slot_count, 0), expected_plain(slot_count, 0);
+        for (size_t k = 0; k < term_count; k++)
+        {
+            vector<uint64_t> values1(slot_count), values2(slot_count);
+            for (size_t i = 0; i < slot_count; i++)
+            {
+                values1[i] = (k + i) % 7;
+                values2[i] = (k * i + 3) % 5;
+                expected[i] = (expected[i] + values1[i] * values2[i]) % 257;
+                expected_plain[i] = (expected_plain[i] + values1[i] * values2[i] * 2) % 257;
+            }
+            Plaintext plain;
+            encoder.encode(values1, plain);
+            encryptor.encrypt(plain, encrypteds1[k]);
+            encoder.encode(values2, plain);
+            encryptor.encrypt(plain, encrypteds2[k]);
+            for (auto &value : values2)
+            {
+                value *= 2;
+            }
+            encoder.encode(values2, plains[k]);
+        }
+
+        Ciphertext encrypted;
+        Plaintext plain;
+        vector<uint64_t> result;
+        evaluator.inner_product(encrypteds1, encrypteds2, rlk, encrypted);
+        ASSERT_EQ(2ULL, encrypted.size());
+        ASSERT_TRUE(encrypted.parms_id() == parms.parms_id());
+        ASSERT_TRUE(0 < decryptor.invariant_noise_budget(encrypted));
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, result);
+        ASSERT_TRUE(expected == result);
+
+        // Same result as multiplying and adding term by term
+        Ciphertext sum, product;
+        for (size_t k = 0; k < term_count; k++)
+        {
+            evaluator.multiply(encrypteds1[k], encrypteds2[k], product);
+            evaluator.relinearize_inplace(product, rlk);
+            if (k)
+            {
+                evaluator.add_inplace(sum, product);
+            }
+            else
+            {
+                sum = product;
+            }
+        }
+        ASSERT_TRUE(decryptor.invariant_noise_budget(sum) <= 
+            decryptor.invariant_noise_budget(encrypted));
+        decryptor.decrypt(sum, plain);
+        encoder.decode(plain, result);
+        ASSERT_TRUE(expected == result);
+
+        evaluator.inner_product_plain(encrypteds1, plains, encrypted);
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, result);
+        ASSERT_TRUE(expected_plain == result);
+
+        // NTT form inputs
+        for (size_t k = 0; k < term_count; k++)
+        {
+            evaluator.transform_to_ntt_inplace(encrypteds1[k]);
+            evaluator.transform_to_ntt_inplace(plains[k], parms.parms_id());
+        }
+        evaluator.inner_product_plain(encrypteds1, plains, encrypteds1[0]);
+        ASSERT_TRUE(encrypteds1[0].is_ntt_form());
+        evaluator.transform_from_ntt_inplace(encrypteds1[0]);
+        decryptor.decrypt(encrypteds1[0], plain);
+        encoder.decode(plain, result);
+        ASSERT_TRUE(expected_plain == result);
+
+        ASSERT_THROW(evaluator.inner_product_plain(encrypteds1, {}, encrypted), 
+            invalid_argument);
+        ASSERT_THROW(evaluator.inner_product(encrypteds1, encrypteds2, rlk, encrypted),
+            invalid_argument);
+    }
+
+    TEST(EvaluatorTest, CKKSEncryptInnerProductDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::CKKS);
+        size_t slot_count = 32;
+        parms.set_poly_modulus_degree(slot_count * 2);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_60bit(0), 
+            DefaultParams::small_mods_60bit(1) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+
+        CKKSEncoder encoder(context);
+        Encryptor encryptor(context, keygen.public_key());
+        Decryptor decryptor(context, keygen.secret_key());
+        Evaluator evaluator(context);
+        RelinKeys rlk = keygen.relin_keys(20);
+
+        size_t term_count = 10;
+        double delta = static_cast<double>(1ULL << 40);
+        vector<Ciphertext> encrypteds1(term_count), encrypteds2(term_count);
+        vector<Plaintext> plains(term_count);
+        vector<double> expected(slot_count, 0.0);
+        for (size_t k = 0; k < term_count; k++)
+        {
+            vector<double> values1(slot_count), values2(slot_count);
+            for (size_t i = 0; i < slot_count; i++)
+            {
+                values1[i] = static_cast<double>((k + i) % 11);
+                values2[i] = static_cast<double>((k * i) % 13);
+                expected[i] += values1[i] * values2[i];
+            }
+            Plaintext plain;
+            encoder.encode(values1, delta, plain);
+            encryptor.encrypt(plain, encrypteds1[k]);
+            encoder.encode(values2, delta, plains[k]);
+            encryptor.encrypt(plains[k], encrypteds2[k]);
+        }
+
+        Ciphertext encrypted;
+        Plaintext plain;
+        vector<double> result;
+        evaluator.inner_product(encrypteds1, encrypteds2, rlk, encrypted);
+        ASSERT_EQ(2ULL, encrypted.size());
+        ASSERT_TRUE(util::are_close<double>(delta * delta, encrypted.scale()));
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, result);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            ASSERT_NEAR(expected[i], result[i], 0.5);
+        }
+
+        evaluator.inner_product_plain(encrypteds1, plains, encrypted);
+        decryptor.decrypt(encrypted, plain);
+        encoder.decode(plain, result);
+        for (size_t i = 0; i < slot_count; i++)
+        {
+            ASSERT_NEAR(expected[i], result[i], 0.5);
+        }
+
+        // All products must have the same scale
+        encoder.encode(1.0, delta * 2, plains[1]);
+        ASSERT_THROW(evaluator.inner_product_plain(encrypteds1, plains, encrypted),
+            invalid_argument);
+    }
+
     TEST(EvaluatorTest, TransformPlainToNTT)
     {
         EncryptionParameters parms(scheme_type::BFV);
@@ -3654,6 +3912,332 @@ namespace SEALTest
             6, 7, 8, 5
         }));
     }
+
+    TEST(EvaluatorTest, FVEncryptRotateMatrixNTTDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        SmallModulus plain_modulus(257);
+        parms.set_poly_modulus_degree(8);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0), DefaultParams::small_mods_40bit(1) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        GaloisKeys glk = keygen.galois_keys(24);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        Plaintext plain;
+        vector<uint64_t> plain_vec{
+            1, 2, 3, 4,
+            5, 6, 7, 8
+        };
+        batch_encoder.encode(plain_vec, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        // Rotations keep a ciphertext in NTT form
+        evaluator.transform_to_ntt_inplace(encrypted);
+        evaluator.rotate_rows_inplace(encrypted, 1, glk);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        evaluator.rotate_columns_inplace(encrypted, glk);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        evaluator.rotate_rows_inplace(encrypted, -3, glk);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+
+        evaluator.transform_from_ntt_inplace(encrypted);
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, plain_vec);
+        ASSERT_TRUE((plain_vec == vector<uint64_t>{
+            7, 8, 5, 6,
+            3, 4, 1, 2
+        }));
+    }
+
+    TEST(EvaluatorTest, FVEncryptNTTFormChainDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        SmallModulus plain_modulus(257);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        RelinKeys rlk = keygen.relin_keys(30);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        vector<uint64_t> vec1(64), vec2(64);
+        for (size_t i = 0; i < 64; i++)
+        {
+            vec1[i] = i;
+            vec2[i] = 200 - i;
+        }
+        Plaintext plain1, plain2;
+        batch_encoder.encode(vec1, plain1);
+        batch_encoder.encode(vec2, plain2);
+        Ciphertext encrypted1, encrypted2;
+        encryptor.encrypt(plain1, encrypted1);
+        encryptor.encrypt(plain2, encrypted2);
+
+        // Linear operations and plaintext multiplications stay in NTT form
+        Ciphertext expected;
+        evaluator.add(encrypted1, encrypted2, expected);
+        evaluator.add_plain_inplace(expected, plain1);
+        evaluator.sub_plain_inplace(expected, plain2);
+        evaluator.multiply_plain_inplace(expected, plain2);
+        evaluator.transform_to_ntt_inplace(encrypted1);
+        evaluator.transform_to_ntt_inplace(encrypted2);
+        Ciphertext encrypted;
+        evaluator.add(encrypted1, encrypted2, encrypted);
+        evaluator.add_plain_inplace(encrypted, plain1);
+        evaluator.sub_plain_inplace(encrypted, plain2);
+        Plaintext plain2_ntt;
+        evaluator.transform_to_ntt(plain2, encrypted.parms_id(), plain2_ntt);
+        ASSERT_THROW(evaluator.add_plain_inplace(encrypted, plain2_ntt), invalid_argument);
+        evaluator.multiply_plain_inplace(encrypted, plain2_ntt);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        ASSERT_EQ(decryptor.invariant_noise_budget(expected),
+            decryptor.invariant_noise_budget(encrypted));
+
+        Plaintext plain;
+        vector<uint64_t> result;
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, result);
+        for (size_t i = 0; i < 64; i++)
+        {
+            ASSERT_EQ(((i + 200 - i + i - (200 - i) + 257) * (200 - i)) % 257, result[i]);
+        }
+
+        evaluator.mod_switch_to_next_inplace(encrypted);
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, result);
+        for (size_t i = 0; i < 64; i++)
+        {
+            ASSERT_EQ(((i + 200 - i + i - (200 - i) + 257) * (200 - i)) % 257, result[i]);
+        }
+
+        // Multiplication transforms out of NTT form
+        evaluator.multiply(encrypted1, encrypted2, encrypted);
+        ASSERT_FALSE(encrypted.is_ntt_form());
+        ASSERT_TRUE(encrypted1.is_ntt_form());
+        evaluator.transform_to_ntt_inplace(encrypted);
+        evaluator.relinearize_inplace(encrypted, rlk);
+        ASSERT_EQ(2ULL, encrypted.size());
+        ASSERT_TRUE(encrypted.is_ntt_form());
+        decryptor.decrypt(encrypted, plain);
+        batch_encoder.decode(plain, result);
+        for (size_t i = 0; i < 64; i++)
+        {
+            ASSERT_EQ((i * (200 - i)) % 257, result[i]);
+        }
+    }
+
+    TEST(EvaluatorTest, FVEncryptSparsePlainDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+
+        vector<uint64_t> vec(64);
+        for (size_t i = 0; i < 64; i++)
+        {
+            vec[i] = i;
+        }
+        Plaintext plain;
+        batch_encoder.encode(vec, plain);
+        Ciphertext encrypted;
+        encryptor.encrypt(plain, encrypted);
+
+        // Sparse plaintexts, including coefficients in the upper half, match
+        // the product through the NTT
+        Plaintext sparse("100x^63 + FFx^5 + 3");
+        Ciphertext expected;
+        Plaintext sparse_ntt;
+        evaluator.transform_to_ntt(encrypted, expected);
+        evaluator.transform_to_ntt(sparse, expected.parms_id(), sparse_ntt);
+        evaluator.multiply_plain_inplace(expected, sparse_ntt);
+        evaluator.transform_from_ntt_inplace(expected);
+        Ciphertext product;
+        evaluator.multiply_plain(encrypted, sparse, product);
+        Plaintext expected_plain, product_plain;
+        decryptor.decrypt(expected, expected_plain);
+        decryptor.decrypt(product, product_plain);
+        ASSERT_TRUE(expected_plain == product_plain);
+
+        // All-ones masks are constant, also in NTT form
+        Plaintext ones;
+        batch_encoder.encode_bits({ ~0ULL }, ones);
+        evaluator.multiply_plain(encrypted, ones, product);
+        vector<uint64_t> result;
+        decryptor.decrypt(product, product_plain);
+        batch_encoder.decode(product_plain, result);
+        ASSERT_TRUE(vec == result);
+        evaluator.transform_to_ntt(encrypted, product);
+        evaluator.add_plain_inplace(product, ones);
+        evaluator.sub_plain_inplace(product, sparse);
+        evaluator.add_plain(encrypted, ones, expected);
+        evaluator.sub_plain_inplace(expected, sparse);
+        decryptor.decrypt(product, product_plain);
+        decryptor.decrypt(expected, expected_plain);
+        ASSERT_TRUE(expected_plain == product_plain);
+
+        // Adding zero leaves the ciphertext unchanged
+        Plaintext zero;
+        batch_encoder.encode_bits({}, zero);
+        expected = encrypted;
+        evaluator.add_plain_inplace(expected, zero);
+        ASSERT_TRUE(equal(encrypted.data(), encrypted.data() + encrypted.uint64_count(),
+            expected.data()));
+
+        // Plain modulus larger than the coefficient moduli
+        parms.set_plain_modulus((1ULL << 33) + 1);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0),
+            DefaultParams::small_mods_30bit(1), DefaultParams::small_mods_30bit(2) });
+        context = SEALContext::Create(parms);
+        ASSERT_FALSE(context->context_data()->qualifiers().using_fast_plain_lift);
+        KeyGenerator keygen2(context);
+        Encryptor encryptor2(context, keygen2.public_key());
+        Evaluator evaluator2(context);
+        Decryptor decryptor2(context, keygen2.secret_key());
+
+        encryptor2.encrypt(Plaintext("1x^2 + 3"), encrypted);
+        sparse = Plaintext("200000000x^1 + 5");
+        evaluator2.multiply_plain(encrypted, sparse, product);
+        decryptor2.decrypt(product, product_plain);
+        ASSERT_EQ("200000000x^3 + 5x^2 + 1FFFFFFFEx^1 + F", product_plain.to_string());
+    }
+
+    TEST(EvaluatorTest, FVEncryptModSwitchToLowestDecrypt)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(128);
+        parms.set_plain_modulus(1 << 6);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2),
+            DefaultParams::small_mods_40bit(3) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        Ciphertext encrypted;
+        Ciphertext destination;
+        Plaintext plain("1x^10 + 2x^5 + 3");
+        encryptor.encrypt(plain, encrypted);
+
+        // A fresh ciphertext drops to the last level
+        evaluator.mod_switch_to_lowest(encrypted,
+            decryptor.invariant_noise_budget(encrypted), destination);
+        ASSERT_TRUE(destination.parms_id() == context->last_parms_id());
+        ASSERT_TRUE(decryptor.invariant_noise_budget(destination) > 0);
+        decryptor.decrypt(destination, plain);
+        ASSERT_EQ("1x^10 + 2x^5 + 3", plain.to_string());
+
+        // Without noise budget to spare nothing changes
+        evaluator.mod_switch_to_lowest(encrypted, 0, destination);
+        ASSERT_TRUE(destination.parms_id() == encrypted.parms_id());
+        ASSERT_THROW(evaluator.mod_switch_to_lowest(encrypted, -1, destination),
+            invalid_argument);
+
+        // The first prime alone leaves no room for the rounding noise
+        parms.set_plain_modulus(1 << 20);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0),
+            DefaultParams::small_mods_40bit(0), DefaultParams::small_mods_40bit(1) });
+        context = SEALContext::Create(parms);
+        KeyGenerator keygen2(context);
+        Encryptor encryptor2(context, keygen2.public_key());
+        Evaluator evaluator2(context);
+        Decryptor decryptor2(context, keygen2.secret_key());
+
+        plain = "1x^10 + 2x^5 + 3";
+        encryptor2.encrypt(plain, encrypted);
+        evaluator2.mod_switch_to_lowest(encrypted,
+            decryptor2.invariant_noise_budget(encrypted), destination);
+        ASSERT_TRUE(destination.parms_id() ==
+            context->context_data()->next_context_data()->parms().parms_id());
+        ASSERT_TRUE(decryptor2.invariant_noise_budget(destination) > 0);
+        decryptor2.decrypt(destination, plain);
+        ASSERT_EQ("1x^10 + 2x^5 + 3", plain.to_string());
+    }
+
+    TEST(EvaluatorTest, FVNoiseBudgetEstimate)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(1 << 6);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2),
+            DefaultParams::small_mods_40bit(3) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        RelinKeys rlk = keygen.relin_keys(30);
+        GaloisKeys glk = keygen.galois_keys(24);
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        // The estimate is a lower bound of the measured budget after every operation
+        auto check_estimate = [&](const Ciphertext &encrypted) {
+            ASSERT_TRUE(encrypted.noise_budget() > 0);
+            ASSERT_TRUE(encrypted.noise_budget() <=
+                decryptor.invariant_noise_budget(encrypted));
+        };
+
+        Ciphertext encrypted1, encrypted2;
+        Plaintext plain;
+        encryptor.encrypt(Plaintext("1x^2 + 3"), encrypted1);
+        check_estimate(encrypted1);
+        encryptor.encrypt(Plaintext("2x^1 + 1"), encrypted2);
+        check_estimate(encrypted2);
+
+        evaluator.add_inplace(encrypted1, encrypted2);
+        check_estimate(encrypted1);
+        evaluator.sub_plain_inplace(encrypted1, Plaintext("1"));
+        check_estimate(encrypted1);
+        evaluator.multiply_plain_inplace(encrypted1, Plaintext("3Fx^3 + 2"));
+        check_estimate(encrypted1);
+        evaluator.multiply_inplace(encrypted1, encrypted2);
+        check_estimate(encrypted1);
+        evaluator.relinearize_inplace(encrypted1, rlk);
+        check_estimate(encrypted1);
+        evaluator.square_inplace(encrypted1);
+        check_estimate(encrypted1);
+        evaluator.relinearize_inplace(encrypted1, rlk);
+        check_estimate(encrypted1);
+        evaluator.apply_galois_inplace(encrypted1, 3, glk);
+        check_estimate(encrypted1);
+        evaluator.mod_switch_to_next_inplace(encrypted1);
+        check_estimate(encrypted1);
+
+        // Without a measured budget, compacting relies on the estimate
+        Ciphertext encrypted3;
+        encryptor.encrypt(Plaintext("1x^10 + 2x^5 + 3"), encrypted3);
+        evaluator.mod_switch_to_lowest_inplace(encrypted3);
+        ASSERT_TRUE(encrypted3.parms_id() == context->last_parms_id());
+        check_estimate(encrypted3);
+        decryptor.decrypt(encrypted3, plain);
+        ASSERT_EQ("1x^10 + 2x^5 + 3", plain.to_string());
+    }
+
     TEST(EvaluatorTest, FVEncryptModSwitchToNextDecrypt)
     {
         // the common parameters: the plaintext and the polynomial moduli
@@ -3744,6 +4328,50 @@ namespace SEALTest
         ASSERT_TRUE(plain.to_string() == "5x^64 + Ax^5");
     }
 
+    TEST(EvaluatorTest, FVEncryptSquareModSwitchDecrypt)
+    {
+        // Size 3 ciphertexts below the top level read powers of the secret key
+        // that were computed at the top level
+        EncryptionParameters parms(scheme_type::BFV);
+        SmallModulus plain_modulus(1 << 6);
+        parms.set_poly_modulus_degree(128);
+        parms.set_plain_modulus(plain_modulus);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0), DefaultParams::small_mods_30bit(1),
+            DefaultParams::small_mods_30bit(2), DefaultParams::small_mods_30bit(3) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Evaluator evaluator(context);
+        Decryptor decryptor(context, keygen.secret_key());
+
+        Ciphertext encrypted;
+        Plaintext plain;
+        vector<Ciphertext> encrypteds;
+        vector<Plaintext> plains;
+
+        Ciphertext squared;
+        encryptor.encrypt(Plaintext("1x^2 + 3x^1 + 2"), encrypted);
+        for (int level = 0; level < 2; level++)
+        {
+            evaluator.mod_switch_to_next_inplace(encrypted);
+            ASSERT_TRUE(encrypted.parms_id() != parms.parms_id());
+            evaluator.square(encrypted, squared);
+            ASSERT_EQ(3ULL, squared.size());
+
+            ASSERT_TRUE(decryptor.invariant_noise_budget(squared) > 0);
+            decryptor.decrypt(squared, plain);
+            ASSERT_EQ("1x^4 + 6x^3 + Dx^2 + Cx^1 + 4", plain.to_string());
+
+            encrypteds.assign(3, squared);
+            decryptor.decrypt_many(encrypteds, plains);
+            for (auto &p : plains)
+            {
+                ASSERT_EQ("1x^4 + 6x^3 + Dx^2 + Cx^1 + 4", p.to_string());
+            }
+        }
+    }
+
     TEST(EvaluatorTest, FVEncryptModSwitchToDecrypt)
     {
         // the common parameters: the plaintext and the polynomial moduli
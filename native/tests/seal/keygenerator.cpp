@@ -571,4 +571,57 @@ namespace SEALTest
             }
         }
     }
+
+    TEST(KeyGeneratorTest, ParallelKeyGeneration)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_noise_standard_deviation(3.20);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(1 << 6);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_30bit(0),
+            DefaultParams::small_mods_30bit(1) });
+        parms.set_random_generator(
+            make_shared<StandardRandomAdapterFactory<mt19937_64>>());
+        auto context = SEALContext::Create(parms);
+
+        KeyGenerator keygen(context);
+        KeyGenerator keygen_mt(context, keygen.secret_key(), keygen.public_key());
+        ASSERT_EQ(1ULL, keygen.thread_count());
+        keygen_mt.set_thread_count(4);
+        ASSERT_EQ(4ULL, keygen_mt.thread_count());
+
+        auto compare = [](const vector<vector<Ciphertext>> &keys,
+            const vector<vector<Ciphertext>> &keys_mt) {
+            ASSERT_EQ(keys.size(), keys_mt.size());
+            for (size_t k = 0; k < keys.size(); k++)
+            {
+                ASSERT_EQ(keys[k].size(), keys_mt[k].size());
+                for (size_t l = 0; l < keys[k].size(); l++)
+                {
+                    ASSERT_EQ(keys[k][l].uint64_count(), keys_mt[k][l].uint64_count());
+                    for (size_t i = 0; i < keys[k][l].uint64_count(); i++)
+                    {
+                        ASSERT_EQ(keys[k][l][i], keys_mt[k][l][i]);
+                    }
+                }
+            }
+        };
+
+        RelinKeys rlk = keygen.relin_keys(8, 3);
+        RelinKeys rlk_mt = keygen_mt.relin_keys(8, 3);
+        compare(rlk.data(), rlk_mt.data());
+
+        GaloisKeys glk = keygen.galois_keys(8);
+        GaloisKeys glk_mt = keygen_mt.galois_keys(8);
+        compare(glk.data(), glk_mt.data());
+
+        glk = keygen.galois_keys(8, vector<uint64_t>{ 3, 127, 3, 9 });
+        glk_mt = keygen_mt.galois_keys(8, vector<uint64_t>{ 3, 127, 3, 9 });
+        ASSERT_EQ(3ULL, glk_mt.size());
+        compare(glk.data(), glk_mt.data());
+
+        keygen_mt.set_thread_count(0);
+        rlk_mt = keygen_mt.relin_keys(8, 3);
+        compare(rlk.data(), rlk_mt.data());
+    }
 }
@@ -53,4 +53,80 @@ namespace SEALTest
             ASSERT_TRUE(15LL * bytes_per_uint64 == pool.alloc_byte_count());
         }
     }
+    TEST(MemoryPoolHandleTest, MemoryPoolHandleStats)
+    {
+        MemoryPoolHandle pool = MemoryPoolHandle::New();
+        ASSERT_TRUE(pool.pool_stats().empty());
+        ASSERT_TRUE(0LL == pool.in_use_byte_count());
+        ASSERT_TRUE(0LL == pool.peak_in_use_byte_count());
+        {
+            auto ptr(allocate_uint(5, pool));
+            auto ptr2(allocate_uint(5, pool));
+            auto ptr3(allocate_uint(2, pool));
+            ASSERT_TRUE(2LL == pool.pool_stats().size());
+            ASSERT_TRUE(12LL * bytes_per_uint64 == pool.in_use_byte_count());
+            ASSERT_TRUE(12LL * bytes_per_uint64 == pool.peak_in_use_byte_count());
+
+            ptr2.release();
+            ASSERT_TRUE(7LL * bytes_per_uint64 == pool.in_use_byte_count());
+            ASSERT_TRUE(12LL * bytes_per_uint64 == pool.peak_in_use_byte_count());
+        }
+        ASSERT_TRUE(0LL == pool.in_use_byte_count());
+        ASSERT_TRUE(12LL * bytes_per_uint64 == pool.peak_in_use_byte_count());
+
+        MMProfGuard guard(make_unique<MMProfFixed>(pool));
+        ASSERT_TRUE(2LL == MemoryManager::GetPoolStats().size());
+        ASSERT_TRUE(MemoryManager::GetPoolStats(mm_prof_opt::FORCE_NEW).empty());
+    }
+    TEST(MemoryPoolHandleTest, MemoryPoolHandleTrim)
+    {
+        MemoryPoolHandle pool = MemoryPoolHandle::New();
+        ASSERT_TRUE(0LL == pool.capacity_byte_count());
+        {
+            auto ptr(allocate_uint(5, pool));
+            auto ptr2(allocate_uint(8, pool));
+            ptr.release();
+            ASSERT_TRUE(13LL * bytes_per_uint64 == pool.alloc_byte_count());
+            ASSERT_TRUE(5LL * bytes_per_uint64 == pool.trim());
+            ASSERT_TRUE(8LL * bytes_per_uint64 == pool.alloc_byte_count());
+        }
+        ASSERT_TRUE(8LL * bytes_per_uint64 == pool.trim());
+        ASSERT_TRUE(0LL == pool.alloc_byte_count());
+
+        pool = MemoryPoolHandle::New(false, 10 * bytes_per_uint64);
+        ASSERT_TRUE(10LL * bytes_per_uint64 == pool.capacity_byte_count());
+        {
+            auto ptr(allocate_uint(5, pool));
+        }
+        {
+            auto ptr(allocate_uint(8, pool));
+            ASSERT_TRUE(8LL * bytes_per_uint64 == pool.alloc_byte_count());
+        }
+    }
+    TEST(MemoryPoolHandleTest, MemoryPoolHandleHugePages)
+    {
+        MemoryPoolHandle pool = MemoryPoolHandle::New();
+        ASSERT_FALSE(pool.huge_pages());
+        pool = MemoryPoolHandle::New(false, 0, true);
+        ASSERT_TRUE(pool.huge_pages());
+        {
+            // One small allocation and one spanning several huge pages
+            auto ptr(allocate_uint(5, pool));
+            size_t large_uint64_count = 3 * (size_t(1) << 21) / bytes_per_uint64 + 7;
+            auto ptr2(allocate_zero_uint(large_uint64_count, pool));
+            ptr[4] = 1;
+            ptr2[large_uint64_count - 1] = 2;
+            ASSERT_EQ(0ULL, ptr2[0]);
+            ASSERT_EQ(1ULL, ptr[4]);
+            ASSERT_EQ(2ULL, ptr2[large_uint64_count - 1]);
+        }
+        ASSERT_TRUE(2LL == pool.pool_count());
+        pool.trim();
+        ASSERT_TRUE(0LL == pool.alloc_byte_count());
+
+        MMProfGuard guard(make_unique<MMProfHugePages>());
+        pool = MemoryManager::GetPool();
+        ASSERT_TRUE(pool.huge_pages());
+        ASSERT_FALSE(MemoryManager::GetPool(mm_prof_opt::FORCE_GLOBAL).huge_pages());
+    }
 }
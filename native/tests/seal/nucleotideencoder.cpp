@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "gtest/gtest.h"
+#include "seal/nucleotideencoder.h"
+#include "seal/batchencoder.h"
+#include "seal/context.h"
+#include "seal/defaultparams.h"
+#include <string>
+#include <vector>
+
+using namespace seal;
+using namespace std;
+
+namespace SEALTest
+{
+    TEST(NucleotideEncoderTest, EncodeSequence)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_60bit(0) });
+        parms.set_plain_modulus(257);
+
+        auto context = SEALContext::Create(parms);
+        NucleotideEncoder nucleotide_encoder(context);
+        BatchEncoder batch_encoder(context);
+        ASSERT_EQ(32ULL, nucleotide_encoder.sequence_capacity());
+
+        // Low bits in the top row, high bits in the bottom row
+        Plaintext plain;
+        nucleotide_encoder.encode("ACGTacgu", plain);
+        vector<uint64_t> values;
+        batch_encoder.decode(plain, values);
+        vector<uint64_t> low_bits{ 0, 1, 0, 1, 0, 1, 0, 1 };
+        vector<uint64_t> high_bits{ 0, 0, 1, 1, 0, 0, 1, 1 };
+        for (size_t i = 0; i < 32; i++)
+        {
+            ASSERT_EQ(i < 8 ? low_bits[i] : 0, values[i]);
+            ASSERT_EQ(i < 8 ? high_bits[i] : 0, values[32 + i]);
+        }
+
+        vector<Plaintext> plains;
+        nucleotide_encoder.encode_many({ "ACGTacgu", "" }, plains);
+        ASSERT_EQ(2ULL, plains.size());
+        ASSERT_TRUE(plain == plains[0]);
+        ASSERT_TRUE(plains[1].is_zero());
+
+        ASSERT_THROW(nucleotide_encoder.encode("ACGN", plain), invalid_argument);
+        ASSERT_THROW(nucleotide_encoder.encode(string(33, 'A'), plain), invalid_argument);
+
+        // The count is read from the first slot
+        batch_encoder.encode(vector<uint64_t>(64, 7), plain);
+        ASSERT_EQ(7ULL, nucleotide_encoder.decode_mismatch_count(plain));
+
+        // The largest count fits with the smallest plain modulus that allows
+        // batching, and a plain modulus that does not allow it is rejected
+        batch_encoder.encode(vector<uint64_t>(64, 32), plain);
+        ASSERT_EQ(32ULL, nucleotide_encoder.decode_mismatch_count(plain));
+        parms.set_plain_modulus(256);
+        ASSERT_THROW(NucleotideEncoder(SEALContext::Create(parms)), invalid_argument);
+    }
+
+    TEST(NucleotideEncoderTest, EncodeAmbiguousSequence)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_60bit(0) });
+        parms.set_plain_modulus(257);
+
+        auto context = SEALContext::Create(parms);
+        NucleotideEncoder nucleotide_encoder(context);
+        BatchEncoder batch_encoder(context);
+
+        // Ambiguity codes and gaps read as A and are masked out in both rows
+        Plaintext plain, mask, strict_plain;
+        nucleotide_encoder.encode("ACNTa-gR", plain, mask);
+        nucleotide_encoder.encode("ACATaagA", strict_plain);
+        ASSERT_TRUE(strict_plain == plain);
+        vector<uint64_t> values;
+        batch_encoder.decode(mask, values);
+        vector<uint64_t> mask_bits{ 1, 1, 0, 1, 1, 0, 1, 0 };
+        for (size_t i = 0; i < 32; i++)
+        {
+            ASSERT_EQ(i < 8 ? mask_bits[i] : 0, values[i]);
+            ASSERT_EQ(i < 8 ? mask_bits[i] : 0, values[32 + i]);
+        }
+
+        vector<Plaintext> plains, masks;
+        nucleotide_encoder.encode_many({ "ACNTa-gR", "" }, plains, masks);
+        ASSERT_EQ(2ULL, plains.size());
+        ASSERT_EQ(2ULL, masks.size());
+        ASSERT_TRUE(plain == plains[0]);
+        ASSERT_TRUE(mask == masks[0]);
+        ASSERT_TRUE(plains[1].is_zero());
+        ASSERT_TRUE(masks[1].is_zero());
+        ASSERT_THROW(nucleotide_encoder.encode(string(33, 'N'), plain, mask),
+            invalid_argument);
+
+        // Linked pairs are the zero slots
+        values.assign(64, 5);
+        values[0] = 0;
+        values[3] = 0;
+        values[63] = 0;
+        batch_encoder.encode(values, plain);
+        vector<uint64_t> links;
+        nucleotide_encoder.decode_links(plain, 4, links);
+        ASSERT_EQ(1ULL, links.size());
+        ASSERT_EQ(0x9ULL, links[0]);
+        nucleotide_encoder.decode_links(plain, 64, links);
+        ASSERT_EQ(1ULL, links.size());
+        ASSERT_EQ(0x8000000000000009ULL, links[0]);
+        ASSERT_THROW(nucleotide_encoder.decode_links(plain, 65, links), invalid_argument);
+    }
+}
@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "gtest/gtest.h"
+#include "seal/sequenceevaluator.h"
+#include "seal/batchencoder.h"
+#include "seal/nucleotideencoder.h"
+#include "seal/context.h"
+#include "seal/decryptor.h"
+#include "seal/defaultparams.h"
+#include "seal/encryptor.h"
+#include "seal/keygenerator.h"
+#include <string>
+#include <vector>
+
+using namespace seal;
+using namespace std;
+
+namespace SEALTest
+{
+    TEST(SequenceEvaluatorTest, MismatchCount)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        RelinKeys rlk = keygen.relin_keys(30);
+        GaloisKeys glk = keygen.galois_keys(30);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Decryptor decryptor(context, keygen.secret_key());
+        NucleotideEncoder nucleotide_encoder(context);
+        SequenceEvaluator sequence_evaluator(context);
+
+        // Every pair of different nucleotides counts once, and positions past
+        // the end of a shorter sequence read as A
+        string sequence1 = "ACGTACGTACGTACGTAAAACCCCGGGGTTTT";
+        string sequences[]{ sequence1, "ACGTACGTACGTACGTACGTACGTACGTACGT",
+            "TGCATGCATGCATGCA", "", "CATGCATGCATGCATGCCCCAAAATTTTGGGG" };
+        uint64_t counts[]{ 0, 12, 28, 24, 32 };
+        Plaintext plain1;
+        nucleotide_encoder.encode(sequence1, plain1);
+        Ciphertext encrypted1;
+        encryptor.encrypt(plain1, encrypted1);
+        for (size_t k = 0; k < 5; k++)
+        {
+            Plaintext plain2;
+            nucleotide_encoder.encode(sequences[k], plain2);
+            Ciphertext encrypted2, encrypted;
+            encryptor.encrypt(plain2, encrypted2);
+            sequence_evaluator.mismatch_count(encrypted1, encrypted2, rlk, glk, encrypted);
+            ASSERT_TRUE(decryptor.invariant_noise_budget(encrypted) > 0);
+
+            Plaintext plain;
+            decryptor.decrypt(encrypted, plain);
+            ASSERT_EQ(counts[k], nucleotide_encoder.decode_mismatch_count(plain));
+        }
+    }
+
+    TEST(SequenceEvaluatorTest, MaskedMismatchCount)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2),
+            DefaultParams::small_mods_40bit(3) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        RelinKeys rlk = keygen.relin_keys(30);
+        GaloisKeys glk = keygen.galois_keys(30);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Decryptor decryptor(context, keygen.secret_key());
+        NucleotideEncoder nucleotide_encoder(context);
+        SequenceEvaluator sequence_evaluator(context);
+
+        // Gaps and ambiguity codes in either sequence are skipped, and so are
+        // positions past the end of the shorter sequence
+        string sequence1 = "ACGTACGTNNNN----ACGT";
+        string sequences[]{ sequence1, "ACGTACGTACGTACGTACGT", "TGCA-RYKTGCATGCATGCT",
+            "TGCATGCA" };
+        uint64_t counts[]{ 0, 0, 7, 8 };
+        Plaintext plain1, plain_mask1;
+        nucleotide_encoder.encode(sequence1, plain1, plain_mask1);
+        Ciphertext encrypted1, mask1;
+        encryptor.encrypt(plain1, encrypted1);
+        encryptor.encrypt(plain_mask1, mask1);
+        for (size_t k = 0; k < 4; k++)
+        {
+            Plaintext plain2, plain_mask2;
+            nucleotide_encoder.encode(sequences[k], plain2, plain_mask2);
+            Ciphertext encrypted2, mask2, encrypted;
+            encryptor.encrypt(plain2, encrypted2);
+            encryptor.encrypt(plain_mask2, mask2);
+            sequence_evaluator.masked_mismatch_count(encrypted1, mask1, encrypted2,
+                mask2, rlk, glk, encrypted);
+            ASSERT_TRUE(decryptor.invariant_noise_budget(encrypted) > 0);
+
+            Plaintext plain;
+            decryptor.decrypt(encrypted, plain);
+            ASSERT_EQ(counts[k], nucleotide_encoder.decode_mismatch_count(plain));
+        }
+    }
+
+    TEST(SequenceEvaluatorTest, LinkIndicator)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2),
+            DefaultParams::small_mods_40bit(3) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        RelinKeys rlk = keygen.relin_keys(30);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Decryptor decryptor(context, keygen.secret_key());
+        NucleotideEncoder nucleotide_encoder(context);
+        SequenceEvaluator sequence_evaluator(context);
+
+        // Counts are held in every slot, as mismatch_count leaves them
+        uint64_t counts[]{ 0, 12, 5, 6, 32, 3, 7, 1, 2, 4, 9, 31, 6, 0, 17, 8 };
+        vector<Ciphertext> encrypted_counts(16);
+        for (size_t k = 0; k < 16; k++)
+        {
+            encryptor.encrypt(Plaintext(to_string(counts[k])), encrypted_counts[k]);
+        }
+
+        uint64_t thresholds[]{ 0, 1, 5, 6 };
+        for (auto threshold : thresholds)
+        {
+            Ciphertext encrypted;
+            sequence_evaluator.link_indicator(encrypted_counts, threshold, rlk,
+                keygen.public_key(), encrypted);
+            ASSERT_TRUE(decryptor.invariant_noise_budget(encrypted) > 0);
+
+            Plaintext plain;
+            decryptor.decrypt(encrypted, plain);
+            vector<uint64_t> links;
+            nucleotide_encoder.decode_links(plain, 16, links);
+            ASSERT_EQ(1ULL, links.size());
+            uint64_t expected = 0;
+            for (size_t k = 0; k < 16; k++)
+            {
+                expected |= static_cast<uint64_t>(counts[k] <= threshold) << k;
+            }
+            ASSERT_EQ(expected, links[0]);
+        }
+
+        vector<Ciphertext> too_many(65, encrypted_counts[0]);
+        Ciphertext encrypted;
+        ASSERT_THROW(sequence_evaluator.link_indicator({}, 0, rlk,
+            keygen.public_key(), encrypted), invalid_argument);
+        ASSERT_THROW(sequence_evaluator.link_indicator(too_many, 0, rlk,
+            keygen.public_key(), encrypted), invalid_argument);
+        ASSERT_THROW(sequence_evaluator.link_indicator(encrypted_counts, 257, rlk,
+            keygen.public_key(), encrypted), invalid_argument);
+    }
+
+    TEST(SequenceEvaluatorTest, LinkIndicatorFlooding)
+    {
+        EncryptionParameters parms(scheme_type::BFV);
+        parms.set_poly_modulus_degree(64);
+        parms.set_plain_modulus(257);
+        parms.set_coeff_modulus({ DefaultParams::small_mods_40bit(0),
+            DefaultParams::small_mods_40bit(1), DefaultParams::small_mods_40bit(2),
+            DefaultParams::small_mods_40bit(3) });
+        auto context = SEALContext::Create(parms);
+        KeyGenerator keygen(context);
+        RelinKeys rlk = keygen.relin_keys(30);
+
+        Encryptor encryptor(context, keygen.public_key());
+        Decryptor decryptor(context, keygen.secret_key());
+        BatchEncoder batch_encoder(context);
+        SequenceEvaluator sequence_evaluator(context);
+
+        uint64_t counts[]{ 3, 0, 4, 9, 1, 2, 5 };
+        vector<Ciphertext> encrypted_counts(7);
+        for (size_t k = 0; k < 7; k++)
+        {
+            encryptor.encrypt(Plaintext(to_string(counts[k])), encrypted_counts[k]);
+        }
+
+        // The flooded noise dominates, and the estimate stays below it
+        Ciphertext encrypted;
+        sequence_evaluator.link_indicator(encrypted_counts, 3, rlk,
+            keygen.public_key(), encrypted);
+        ASSERT_TRUE(encrypted.noise_budget() > 0);
+        ASSERT_TRUE(encrypted.noise_budget() <= decryptor.invariant_noise_budget(encrypted));
+        ASSERT_TRUE(decryptor.invariant_noise_budget(encrypted) <
+            decryptor.invariant_noise_budget(encrypted_counts[0]) - 100);
+
+        // Linked pairs decrypt to zero and unlinked pairs to nonzero values
+        Plaintext plain;
+        decryptor.decrypt(encrypted, plain);
+        vector<uint64_t> slots;
+        batch_encoder.decode(plain, slots);
+        for (size_t k = 0; k < 7; k++)
+        {
+            ASSERT_EQ(counts[k] <= 3, slots[k] == 0);
+        }
+
+        // Deeper thresholds do not leave room for the flooding
+        ASSERT_THROW(sequence_evaluator.link_indicator(encrypted_counts, 8, rlk,
+            keygen.public_key(), encrypted), invalid_argument);
+
+        // Counts without a noise budget estimate cannot be flooded
+        encrypted_counts[0].noise_budget() = 0;
+        ASSERT_THROW(sequence_evaluator.link_indicator(encrypted_counts, 0, rlk,
+            keygen.public_key(), encrypted), invalid_argument);
+    }
+}
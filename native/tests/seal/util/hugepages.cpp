@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "gtest/gtest.h"
+#include "seal/util/hugepages.h"
+#include <algorithm>
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace SEALTest
+{
+   namespace util
+   {
+        TEST(HugePages, AllocateFree)
+        {
+            size_t byte_count = huge_page_byte_count + 12345;
+            SEAL_BYTE *data = allocate_huge_pages(byte_count);
+            ASSERT_TRUE(data != nullptr);
+            if (huge_pages_supported())
+            {
+                ASSERT_EQ(0ULL, reinterpret_cast<uintptr_t>(data) % huge_page_byte_count);
+            }
+            fill_n(data, byte_count, static_cast<SEAL_BYTE>(0x5A));
+            ASSERT_TRUE(all_of(data, data + byte_count, [](SEAL_BYTE b) {
+                return b == static_cast<SEAL_BYTE>(0x5A);
+            }));
+            free_huge_pages(data, byte_count);
+            free_huge_pages(nullptr, byte_count);
+        }
+   }
+}
@@ -6,6 +6,8 @@
 #include "seal/util/pointer.h"
 #include "seal/util/common.h"
 #include <memory>
+#include <thread>
+#include <vector>
 
 using namespace seal;
 using namespace seal::util;
@@ -185,6 +187,146 @@ namespace SEALTest
             }
         }
 
+        TEST(MemoryPoolTests, StatsMT)
+        {
+            MemoryPoolMT pool;
+            ASSERT_TRUE(pool.stats().empty());
+
+            Pointer<SEAL_BYTE> p1 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+            Pointer<SEAL_BYTE> p2 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+            Pointer<SEAL_BYTE> p3 = pool.get_for_byte_count(bytes_per_uint64 * 1);
+            auto stats = pool.stats();
+            ASSERT_EQ(2ULL, stats.size());
+            ASSERT_EQ(bytes_per_uint64 * 2, stats[0].item_byte_count);
+            ASSERT_EQ(3ULL, stats[0].item_count);
+            ASSERT_EQ(2ULL, stats[0].in_use_item_count);
+            ASSERT_EQ(2ULL, stats[0].peak_in_use_item_count);
+            ASSERT_EQ(0ULL, stats[0].alloc_failure_count);
+            ASSERT_EQ(bytes_per_uint64 * 1, stats[1].item_byte_count);
+            ASSERT_EQ(1ULL, stats[1].item_count);
+            ASSERT_EQ(1ULL, stats[1].in_use_item_count);
+            ASSERT_EQ(1ULL, stats[1].peak_in_use_item_count);
+
+            p1.release();
+            p2.release();
+            stats = pool.stats();
+            ASSERT_EQ(0ULL, stats[0].in_use_item_count);
+            ASSERT_EQ(2ULL, stats[0].peak_in_use_item_count);
+            ASSERT_EQ(1ULL, stats[1].in_use_item_count);
+
+            p1 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+            stats = pool.stats();
+            ASSERT_EQ(3ULL, stats[0].item_count);
+            ASSERT_EQ(1ULL, stats[0].in_use_item_count);
+            ASSERT_EQ(2ULL, stats[0].peak_in_use_item_count);
+            p1.release();
+            p3.release();
+            stats = pool.stats();
+            ASSERT_EQ(0ULL, stats[0].in_use_item_count);
+            ASSERT_EQ(0ULL, stats[1].in_use_item_count);
+        }
+
+        TEST(MemoryPoolTests, TrimMT)
+        {
+            {
+                MemoryPoolMT pool;
+                Pointer<SEAL_BYTE> p1 = pool.get_for_byte_count(bytes_per_uint64 * 4);
+                Pointer<SEAL_BYTE> p2 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                Pointer<SEAL_BYTE> p3 = pool.get_for_byte_count(bytes_per_uint64 * 1);
+                p1.release();
+                p3.release();
+                ASSERT_TRUE(3LL == pool.pool_count());
+                ASSERT_TRUE(7LL * bytes_per_uint64 == pool.alloc_byte_count());
+
+                // Only idle sizes are released, least recently used first
+                ASSERT_TRUE(4LL * bytes_per_uint64 == 
+                    pool.trim(4 * bytes_per_uint64));
+                ASSERT_TRUE(2LL == pool.pool_count());
+                ASSERT_TRUE(1LL * bytes_per_uint64 == pool.trim(0));
+                ASSERT_TRUE(1LL == pool.pool_count());
+                ASSERT_TRUE(0LL == pool.trim(0));
+                ASSERT_TRUE(2LL * bytes_per_uint64 == pool.alloc_byte_count());
+                p2.release();
+                ASSERT_TRUE(2LL * bytes_per_uint64 == pool.trim(0));
+                ASSERT_TRUE(0LL == pool.pool_count());
+                ASSERT_TRUE(0LL == pool.alloc_byte_count());
+
+                p1 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                ASSERT_TRUE(p1.is_set());
+                ASSERT_TRUE(1LL == pool.pool_count());
+                p1.release();
+            }
+            {
+                MemoryPoolMT pool(false, 5 * bytes_per_uint64);
+                ASSERT_TRUE(5LL * bytes_per_uint64 == pool.capacity_byte_count());
+                Pointer<SEAL_BYTE> p1 = pool.get_for_byte_count(bytes_per_uint64 * 1);
+                p1.release();
+                Pointer<SEAL_BYTE> p2 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                p2.release();
+                ASSERT_TRUE(2LL == pool.pool_count());
+
+                // Exceeding the capacity releases the least recently used idle size
+                p1 = pool.get_for_byte_count(bytes_per_uint64 * 3);
+                ASSERT_TRUE(2LL == pool.pool_count());
+                ASSERT_TRUE(5LL * bytes_per_uint64 == pool.alloc_byte_count());
+                ASSERT_TRUE(bytes_per_uint64 * 3 == pool.stats()[0].item_byte_count);
+                ASSERT_TRUE(bytes_per_uint64 * 2 == pool.stats()[1].item_byte_count);
+
+                // Memory in use is never released
+                p2 = pool.get_for_byte_count(bytes_per_uint64 * 4);
+                ASSERT_TRUE(2LL == pool.pool_count());
+                ASSERT_TRUE(7LL * bytes_per_uint64 == pool.alloc_byte_count());
+                p1.release();
+                p2.release();
+            }
+        }
+
+        TEST(MemoryPoolTests, ConcurrentMT)
+        {
+            MemoryPoolMT pool;
+            constexpr size_t thread_count = 8;
+            constexpr size_t round_count = 2000;
+            constexpr size_t held_count = 4;
+            atomic<bool> corrupted(false);
+            vector<thread> threads;
+            for (size_t t = 0; t < thread_count; t++)
+            {
+                threads.emplace_back([&pool, &corrupted, t]() {
+                    for (size_t round = 0; round < round_count; round++)
+                    {
+                        Pointer<uint64_t> held[held_count];
+                        for (size_t i = 0; i < held_count; i++)
+                        {
+                            held[i] = pool.get_for_byte_count(bytes_per_uint64 * 4);
+                            fill_n(held[i].get(), 4, t * held_count + i);
+                        }
+                        for (size_t i = 0; i < held_count; i++)
+                        {
+                            for (size_t j = 0; j < 4; j++)
+                            {
+                                if (held[i][j] != t * held_count + i)
+                                {
+                                    corrupted = true;
+                                }
+                            }
+                            held[i].release();
+                        }
+                    }
+                });
+            }
+            for (auto &th : threads)
+            {
+                th.join();
+            }
+            ASSERT_FALSE(corrupted);
+
+            auto stats = pool.stats();
+            ASSERT_EQ(1ULL, stats.size());
+            ASSERT_EQ(0ULL, stats[0].in_use_item_count);
+            ASSERT_TRUE(stats[0].peak_in_use_item_count <= thread_count * held_count);
+            ASSERT_TRUE(stats[0].item_count >= stats[0].peak_in_use_item_count);
+        }
+
         TEST(MemoryPoolTests, PointerTestsMT)
         {
             MemoryPool &pool = *global_variables::global_memory_pool;
@@ -513,6 +655,100 @@ namespace SEALTest
             }
         }
 
+        TEST(MemoryPoolTests, StatsST)
+        {
+            MemoryPoolST pool;
+            ASSERT_TRUE(pool.stats().empty());
+
+            Pointer<SEAL_BYTE> p1 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+            Pointer<SEAL_BYTE> p2 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+            Pointer<SEAL_BYTE> p3 = pool.get_for_byte_count(bytes_per_uint64 * 1);
+            auto stats = pool.stats();
+            ASSERT_EQ(2ULL, stats.size());
+            ASSERT_EQ(bytes_per_uint64 * 2, stats[0].item_byte_count);
+            ASSERT_EQ(3ULL, stats[0].item_count);
+            ASSERT_EQ(2ULL, stats[0].in_use_item_count);
+            ASSERT_EQ(2ULL, stats[0].peak_in_use_item_count);
+            ASSERT_EQ(0ULL, stats[0].alloc_failure_count);
+            ASSERT_EQ(bytes_per_uint64 * 1, stats[1].item_byte_count);
+            ASSERT_EQ(1ULL, stats[1].item_count);
+            ASSERT_EQ(1ULL, stats[1].in_use_item_count);
+            ASSERT_EQ(1ULL, stats[1].peak_in_use_item_count);
+
+            p1.release();
+            p2.release();
+            stats = pool.stats();
+            ASSERT_EQ(0ULL, stats[0].in_use_item_count);
+            ASSERT_EQ(2ULL, stats[0].peak_in_use_item_count);
+            ASSERT_EQ(1ULL, stats[1].in_use_item_count);
+
+            p1 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+            stats = pool.stats();
+            ASSERT_EQ(3ULL, stats[0].item_count);
+            ASSERT_EQ(1ULL, stats[0].in_use_item_count);
+            ASSERT_EQ(2ULL, stats[0].peak_in_use_item_count);
+            p1.release();
+            p3.release();
+            stats = pool.stats();
+            ASSERT_EQ(0ULL, stats[0].in_use_item_count);
+            ASSERT_EQ(0ULL, stats[1].in_use_item_count);
+        }
+
+        TEST(MemoryPoolTests, TrimST)
+        {
+            {
+                MemoryPoolST pool;
+                Pointer<SEAL_BYTE> p1 = pool.get_for_byte_count(bytes_per_uint64 * 4);
+                Pointer<SEAL_BYTE> p2 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                Pointer<SEAL_BYTE> p3 = pool.get_for_byte_count(bytes_per_uint64 * 1);
+                p1.release();
+                p3.release();
+                ASSERT_TRUE(3LL == pool.pool_count());
+                ASSERT_TRUE(7LL * bytes_per_uint64 == pool.alloc_byte_count());
+
+                // Only idle sizes are released, least recently used first
+                ASSERT_TRUE(4LL * bytes_per_uint64 == 
+                    pool.trim(4 * bytes_per_uint64));
+                ASSERT_TRUE(2LL == pool.pool_count());
+                ASSERT_TRUE(1LL * bytes_per_uint64 == pool.trim(0));
+                ASSERT_TRUE(1LL == pool.pool_count());
+                ASSERT_TRUE(0LL == pool.trim(0));
+                ASSERT_TRUE(2LL * bytes_per_uint64 == pool.alloc_byte_count());
+                p2.release();
+                ASSERT_TRUE(2LL * bytes_per_uint64 == pool.trim(0));
+                ASSERT_TRUE(0LL == pool.pool_count());
+                ASSERT_TRUE(0LL == pool.alloc_byte_count());
+
+                p1 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                ASSERT_TRUE(p1.is_set());
+                ASSERT_TRUE(1LL == pool.pool_count());
+                p1.release();
+            }
+            {
+                MemoryPoolST pool(false, 5 * bytes_per_uint64);
+                ASSERT_TRUE(5LL * bytes_per_uint64 == pool.capacity_byte_count());
+                Pointer<SEAL_BYTE> p1 = pool.get_for_byte_count(bytes_per_uint64 * 1);
+                p1.release();
+                Pointer<SEAL_BYTE> p2 = pool.get_for_byte_count(bytes_per_uint64 * 2);
+                p2.release();
+                ASSERT_TRUE(2LL == pool.pool_count());
+
+                // Exceeding the capacity releases the least recently used idle size
+                p1 = pool.get_for_byte_count(bytes_per_uint64 * 3);
+                ASSERT_TRUE(2LL == pool.pool_count());
+                ASSERT_TRUE(5LL * bytes_per_uint64 == pool.alloc_byte_count());
+                ASSERT_TRUE(bytes_per_uint64 * 3 == pool.stats()[0].item_byte_count);
+                ASSERT_TRUE(bytes_per_uint64 * 2 == pool.stats()[1].item_byte_count);
+
+                // Memory in use is never released
+                p2 = pool.get_for_byte_count(bytes_per_uint64 * 4);
+                ASSERT_TRUE(2LL == pool.pool_count());
+                ASSERT_TRUE(7LL * bytes_per_uint64 == pool.alloc_byte_count());
+                p1.release();
+                p2.release();
+            }
+        }
+
         TEST(MemoryPoolTests, PointerTestsST)
         {
             MemoryPool &pool = *global_variables::global_memory_pool;
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "gtest/gtest.h"
+#include "seal/util/noiseestimate.h"
+#include "seal/defaultparams.h"
+
+using namespace seal::util;
+using namespace seal;
+using namespace std;
+
+namespace SEALTest
+{
+    namespace util
+    {
+        TEST(NoiseEstimateTest, AddNoiseBudgets)
+        {
+            ASSERT_DOUBLE_EQ(19.0, add_noise_budgets(20.0, 20.0));
+            ASSERT_DOUBLE_EQ(add_noise_budgets(10.0, 30.0), add_noise_budgets(30.0, 10.0));
+            ASSERT_TRUE(add_noise_budgets(10.0, 30.0) < 10.0);
+            ASSERT_TRUE(add_noise_budgets(10.0, 30.0) > 9.99);
+            ASSERT_DOUBLE_EQ(0.0, add_noise_budgets(0.0, 30.0));
+            ASSERT_DOUBLE_EQ(0.0, add_noise_budgets(0.5, 0.5));
+        }
+
+        TEST(NoiseEstimateTest, EstimateOperations)
+        {
+            EncryptionParameters parms(scheme_type::BFV);
+            parms.set_poly_modulus_degree(4096);
+            parms.set_coeff_modulus(DefaultParams::coeff_modulus_128(4096));
+            parms.set_plain_modulus(1 << 6);
+
+            // Noise only grows, and the estimates never leave [0, log2(q/t)]
+            double budget = fresh_noise_budget(parms);
+            ASSERT_TRUE(budget > 0);
+            ASSERT_TRUE(budget < 109 - 6);
+
+            ASSERT_TRUE(add_plain_noise_budget(parms, budget) <= budget);
+            ASSERT_DOUBLE_EQ(budget - 3,
+                multiply_plain_noise_budget(parms, budget, 2, 4));
+            ASSERT_TRUE(multiply_plain_noise_budget(parms, budget, 0, 0) > budget);
+            ASSERT_DOUBLE_EQ(0.0, multiply_plain_noise_budget(parms, 3.0, 4096, 32));
+
+            double product_budget = multiply_noise_budget(parms, budget, 2, budget, 2);
+            ASSERT_TRUE(product_budget < budget);
+            ASSERT_TRUE(multiply_noise_budget(parms, budget, 3, budget, 2) < product_budget);
+            ASSERT_DOUBLE_EQ(0.0, multiply_noise_budget(parms, 0.0, 2, budget, 2));
+
+            ASSERT_TRUE(key_switch_noise_budget(parms, product_budget, 60, 2) <= product_budget);
+            ASSERT_TRUE(key_switch_noise_budget(parms, product_budget, 16, 8) >
+                key_switch_noise_budget(parms, product_budget, 60, 2));
+
+            EncryptionParameters next_parms = parms;
+            auto coeff_modulus = parms.coeff_modulus();
+            coeff_modulus.pop_back();
+            next_parms.set_coeff_modulus(coeff_modulus);
+            ASSERT_TRUE(mod_switch_noise_budget(next_parms, 10.0) <= 10.0);
+            ASSERT_TRUE(mod_switch_noise_budget(next_parms, 10.0) > 9.0);
+            ASSERT_TRUE(mod_switch_noise_budget(next_parms, budget) < budget - 1);
+        }
+    }
+}
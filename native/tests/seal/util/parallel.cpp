@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "gtest/gtest.h"
+#include "seal/util/parallel.h"
+#include <vector>
+#include <stdexcept>
+
+using namespace seal::util;
+using namespace std;
+
+namespace SEALTest
+{
+   namespace util
+   {
+        TEST(Parallel, ParallelFor)
+        {
+            ASSERT_LE(1ULL, default_thread_count());
+
+            for (size_t thread_count : { 0, 1, 3, 16 })
+            {
+                vector<int> hits(1000, 0);
+                parallel_for(hits.size(), thread_count, [&](size_t i) {
+                    hits[i]++;
+                });
+                for (auto hit : hits)
+                {
+                    ASSERT_EQ(1, hit);
+                }
+            }
+
+            size_t calls = 0;
+            parallel_for(0, 4, [&](size_t) { calls++; });
+            ASSERT_EQ(0ULL, calls);
+        }
+
+        TEST(Parallel, ParallelForException)
+        {
+            for (size_t thread_count : { 1, 4 })
+            {
+                ASSERT_THROW(parallel_for(100, thread_count, [](size_t i) {
+                    if (i == 42)
+                    {
+                        throw invalid_argument("42");
+                    }
+                }), invalid_argument);
+            }
+        }
+    }
+}
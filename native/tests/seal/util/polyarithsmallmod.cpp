@@ -387,5 +387,34 @@ namespace SEALTest
             ASSERT_EQ(6ULL, result[2]);
             ASSERT_EQ(3ULL, result[3]);
         }
+
+        TEST(PolyArithSmallMod, NegacyclicMultiplyPolyMonoAddCoeffSmallMod)
+        {
+            MemoryPool &pool = *global_variables::global_memory_pool;
+            auto poly(allocate_zero_poly(4, 1, pool));
+            auto result(allocate_zero_poly(4, 1, pool));
+
+            SmallModulus mod(10);
+            size_t coeff_count = 4;
+            poly[0] = 1;
+            poly[1] = 2;
+            poly[2] = 3;
+            poly[3] = 4;
+
+            negacyclic_multiply_poly_mono_add_coeffmod(poly.get(), coeff_count,
+                MultiplyUIntModOperand(3, mod), 0, mod, result.get());
+            ASSERT_EQ(3ULL, result[0]);
+            ASSERT_EQ(6ULL, result[1]);
+            ASSERT_EQ(9ULL, result[2]);
+            ASSERT_EQ(2ULL, result[3]);
+
+            // Terms past x^3 wrap around with x^4 = -1
+            negacyclic_multiply_poly_mono_add_coeffmod(poly.get(), coeff_count,
+                MultiplyUIntModOperand(2, mod), 3, mod, result.get());
+            ASSERT_EQ(9ULL, result[0]);
+            ASSERT_EQ(0ULL, result[1]);
+            ASSERT_EQ(1ULL, result[2]);
+            ASSERT_EQ(4ULL, result[3]);
+        }
    }
 }
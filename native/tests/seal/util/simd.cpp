@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "gtest/gtest.h"
+#include "seal/util/simd.h"
+#include "seal/util/polyarithsmallmod.h"
+#include "seal/smallmodulus.h"
+#include <random>
+#include <vector>
+#include <stdexcept>
+
+using namespace seal;
+using namespace seal::util;
+using namespace std;
+
+namespace SEALTest
+{
+    namespace util
+    {
+        TEST(SIMD, SetSIMDLevel)
+        {
+            simd_level max_level = max_simd_level();
+            ASSERT_TRUE(max_level == get_simd_level());
+
+            set_simd_level(simd_level::none);
+            ASSERT_TRUE(simd_level::none == get_simd_level());
+            uint64_t value = 0;
+            ASSERT_FALSE(add_poly_poly_coeffmod_simd(&value, &value, 1, 2, &value));
+            if (max_level != simd_level::avx512)
+            {
+                ASSERT_THROW(set_simd_level(simd_level::avx512), invalid_argument);
+            }
+            set_simd_level(max_level);
+            ASSERT_TRUE(max_level == get_simd_level());
+        }
+
+        TEST(SIMD, PolyArithmeticMatchesScalar)
+        {
+            // Lengths that are not multiples of the vector width exercise the tails
+            mt19937_64 engine(42);
+            simd_level max_level = max_simd_level();
+            for (uint64_t modulus_value : { 2ULL, 0xFFFFFULL, 0x3FFFFFFFFFFFFFFFULL })
+            {
+                SmallModulus modulus(modulus_value);
+                for (size_t coeff_count : { 0, 1, 3, 4, 7, 8, 13, 64 })
+                {
+                    uniform_int_distribution<uint64_t> dist(0, modulus_value - 1);
+                    vector<uint64_t> op1(coeff_count), op2(coeff_count);
+                    for (size_t i = 0; i < coeff_count; i++)
+                    {
+                        op1[i] = dist(engine);
+                        op2[i] = dist(engine);
+                    }
+                    if (coeff_count > 2)
+                    {
+                        op1[0] = 0;
+                        op2[1] = modulus_value - 1;
+                        op1[2] = op2[2];
+                    }
+
+                    set_simd_level(simd_level::none);
+                    vector<uint64_t> add(coeff_count), sub(coeff_count), neg(coeff_count);
+                    add_poly_poly_coeffmod(op1.data(), op2.data(), coeff_count, modulus, add.data());
+                    sub_poly_poly_coeffmod(op1.data(), op2.data(), coeff_count, modulus, sub.data());
+                    negate_poly_coeffmod(op1.data(), coeff_count, modulus, neg.data());
+
+                    for (auto level : { simd_level::avx2, simd_level::avx512 })
+                    {
+                        if (static_cast<uint8_t>(level) > static_cast<uint8_t>(max_level))
+                        {
+                            continue;
+                        }
+                        set_simd_level(level);
+                        vector<uint64_t> result(coeff_count);
+                        add_poly_poly_coeffmod(op1.data(), op2.data(), coeff_count, modulus, result.data());
+                        ASSERT_TRUE(add == result);
+                        sub_poly_poly_coeffmod(op1.data(), op2.data(), coeff_count, modulus, result.data());
+                        ASSERT_TRUE(sub == result);
+                        negate_poly_coeffmod(op1.data(), coeff_count, modulus, result.data());
+                        ASSERT_TRUE(neg == result);
+
+                        // In place
+                        result = op1;
+                        add_poly_poly_coeffmod(result.data(), op2.data(), coeff_count, modulus, result.data());
+                        ASSERT_TRUE(add == result);
+                    }
+                    set_simd_level(max_level);
+                }
+            }
+        }
+
+        TEST(SIMD, GatherMatchesScalar)
+        {
+            mt19937_64 engine(42);
+            simd_level max_level = max_simd_level();
+            vector<uint64_t> input(64);
+            for (size_t i = 0; i < input.size(); i++)
+            {
+                input[i] = engine();
+            }
+            for (size_t count : { 0, 1, 3, 4, 7, 8, 13, 64 })
+            {
+                uniform_int_distribution<uint64_t> dist(0, input.size() - 1);
+                vector<uint64_t> indices(count), expected(count);
+                for (size_t i = 0; i < count; i++)
+                {
+                    indices[i] = dist(engine);
+                    expected[i] = input[indices[i]];
+                }
+
+                set_simd_level(simd_level::none);
+                ASSERT_FALSE(gather_uint64_simd(input.data(), indices.data(), count,
+                    expected.data()));
+                for (auto level : { simd_level::avx2, simd_level::avx512 })
+                {
+                    if (static_cast<uint8_t>(level) > static_cast<uint8_t>(max_level))
+                    {
+                        continue;
+                    }
+                    set_simd_level(level);
+                    vector<uint64_t> result(count);
+                    ASSERT_TRUE(gather_uint64_simd(input.data(), indices.data(), count,
+                        result.data()));
+                    ASSERT_TRUE(expected == result);
+                }
+                set_simd_level(max_level);
+            }
+        }
+    }
+}
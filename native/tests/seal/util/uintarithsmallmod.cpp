@@ -211,6 +211,35 @@ namespace SEALTest
             ASSERT_EQ(1ULL, multiply_uint_uint_mod(4611686018427289600ULL, 4611686018427289600ULL, mod));
         }
 
+        TEST(UIntArithSmallMod, MultiplyUIntModOperand)
+        {
+            SmallModulus mod(2);
+            MultiplyUIntModOperand y(0, mod);
+            ASSERT_EQ(0ULL, y.quotient);
+            ASSERT_EQ(0ULL, multiply_uint_mod(1, y, mod));
+            y.set(1, mod);
+            ASSERT_EQ(0x8000000000000000ULL, y.quotient);
+            ASSERT_EQ(1ULL, multiply_uint_mod(1, y, mod));
+            ASSERT_EQ(1ULL, multiply_uint_mod(0xFFFFFFFFFFFFFFFFULL, y, mod));
+
+            mod = 10;
+            y.set(7, mod);
+            ASSERT_EQ(9ULL, multiply_uint_mod(7, y, mod));
+            ASSERT_EQ(2ULL, multiply_uint_mod(6, y, mod));
+            ASSERT_EQ(5ULL, multiply_uint_mod(0xFFFFFFFFFFFFFFFFULL, y, mod));
+            ASSERT_TRUE(multiply_uint_mod_lazy(7, y, mod) % 10 == 9ULL);
+            ASSERT_TRUE(multiply_uint_mod_lazy(7, y, mod) < 20ULL);
+
+            mod = 4611686018427289601ULL;
+            y.set(2305843009213644801ULL, mod);
+            ASSERT_EQ(1152921504606822400ULL, multiply_uint_mod(2305843009213644800ULL, y, mod));
+            ASSERT_EQ(3458764513820467201ULL, multiply_uint_mod(2305843009213644801ULL, y, mod));
+            y.set(4611686018427289600ULL, mod);
+            ASSERT_EQ(1ULL, multiply_uint_mod(4611686018427289600ULL, y, mod));
+            ASSERT_EQ(multiply_uint_uint_mod(0xFFFFFFFFFFFFFFFFULL, 4611686018427289600ULL, mod),
+                multiply_uint_mod(0xFFFFFFFFFFFFFFFFULL, y, mod));
+        }
+
         TEST(UIntArithSmallMod, ModuloUIntSmallMod)
         {
             MemoryPool &pool = *global_variables::global_memory_pool;